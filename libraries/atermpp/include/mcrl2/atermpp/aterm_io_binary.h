@@ -29,14 +29,17 @@ namespace atermpp
 ///          Packet headers also contain a special value to indicate that the read term should be visible as output as opposed to
 ///          being only a subterm.
 ///          The start of the stream is a zero followed by a header and a version and a term with function symbol index zero
-///          indicates the end of the stream.
+///          indicates the end of the stream. Optionally, everything after the version is stored in compressed blocks,
+///          which is indicated by a different version.
 ///
 class binary_aterm_ostream final : public aterm_ostream
 {
 public:
   /// \brief Provide the output stream to which the terms are written.
-  binary_aterm_ostream(std::ostream& os);
-  binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream);
+  /// \param compress If true, the packets are stored in compressed blocks. Such a stream cannot be read by tools
+  ///        that predate this format.
+  binary_aterm_ostream(std::ostream& os, bool compress = false);
+  binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream, bool compress = false);
 
   ~binary_aterm_ostream() override;
 
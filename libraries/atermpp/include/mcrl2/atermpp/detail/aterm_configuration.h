@@ -12,6 +12,8 @@
 
 #include "mcrl2/utilities/configuration.h"
 
+#include <cstddef>
+
 namespace atermpp::detail
 {
 
@@ -24,6 +26,13 @@ constexpr static bool EnableBlockAllocator = true;
 /// \brief Enable to print garbage collection statistics.
 constexpr static bool EnableGarbageCollectionMetrics = false;
 
+/// \brief Sweep the term storages in parallel, which shortens the time that all threads are blocked by
+///        garbage collection. Only has effect when MCRL2_ENABLE_MULTITHREADING is defined.
+constexpr static bool EnableParallelSweep = true;
+
+/// \brief The minimal number of terms in the pool before the storages are swept in parallel.
+constexpr static std::size_t ParallelSweepThreshold = 1 << 16;
+
 /// Performs garbage collection intensively for testing purposes.
 constexpr static bool EnableAggressiveGarbageCollection = false;
 
@@ -12,6 +12,7 @@
 
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
+#include "mcrl2/atermpp/detail/sweep_thread_pool.h"
 
 #include "mcrl2/utilities/shared_mutex.h"
 
@@ -114,6 +115,13 @@ public:
   /// \brief Prints various performance statistics for the term pool.
   inline void print_performance_statistics() const;
 
+  /// \returns The number of garbage collections that have been performed.
+  std::size_t number_of_collections() const noexcept { return m_number_of_collections; }
+
+  /// \returns The number of terms that have been created, i.e., the terms in the pool and the terms that
+  ///          have been removed by garbage collection.
+  std::size_t number_of_created_terms() const { return size() + m_number_of_erased_terms; }
+
   /// \returns A global term that indicates the empty list.
   aterm& empty_list() noexcept { return reinterpret_cast<aterm&>(m_empty_list); }  // TODO remove this reinterpret cast by letting m_empty_list become an aterm.
 
@@ -195,6 +203,12 @@ private:
   /// \returns The total number of term variables residing in the protection sets.
   inline std::size_t protection_set_size() const;
 
+  /// \brief Destroys the unmarked terms of all storages, possibly using the sweep thread pool.
+  /// \details The storages are swept in parallel with at most the number of threads of the tool, as
+  ///          given by its --threads option, such that a sequential tool does not start helper threads.
+  /// \returns The number of threads that were used.
+  inline std::size_t sweep();
+
   /// \brief The set of local aterm pools.
   std::vector<thread_aterm_pool_interface* > m_thread_pools;
 
@@ -227,6 +241,15 @@ private:
 
   std::atomic<bool> m_enable_resize = true; /// Automatic hash table resizing is enabled.
 
+  /// The helper threads that sweep storages in parallel, which are only created when needed.
+  sweep_thread_pool m_sweep_thread_pool;
+
+  /// Statistics on the time that all threads are blocked by garbage collection.
+  std::size_t m_number_of_collections = 0;
+  std::size_t m_number_of_erased_terms = 0;
+  long m_total_pause_duration = 0;
+  long m_longest_pause_duration = 0;
+
   /// All the shared mutexes.
   mcrl2::utilities::shared_mutex m_shared_mutex;
 
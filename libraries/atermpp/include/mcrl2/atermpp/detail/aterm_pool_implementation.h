@@ -10,9 +10,11 @@
 #ifndef MCRL2_ATERMPP_DETAIL_ATERM_POOL_IMPLEMENTATION_H
 #define MCRL2_ATERMPP_DETAIL_ATERM_POOL_IMPLEMENTATION_H
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include "aterm_pool.h"
+#include "mcrl2/utilities/detail/tool_number_of_threads.h"
 #include "aterm_pool_storage_implementation.h"   // For store_in_argument_array. 
 
 namespace atermpp::detail
@@ -199,6 +201,8 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
       return;
     }
 
+    // The other threads are blocked as soon as the exclusive lock is requested.
+    auto pause_start = std::chrono::system_clock::now();
     mcrl2::utilities::lock_guard guard = shared_mutex.try_lock();
     if (!guard.owns_lock())
     { 
@@ -232,16 +236,7 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
     auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
     timestamp = std::chrono::system_clock::now();
     // Collect all terms that are not marked.
-    m_appl_dynamic_storage.sweep();
-    std::get<7>(m_appl_storage).sweep();
-    std::get<6>(m_appl_storage).sweep();
-    std::get<5>(m_appl_storage).sweep();
-    std::get<4>(m_appl_storage).sweep();
-    std::get<3>(m_appl_storage).sweep();
-    std::get<2>(m_appl_storage).sweep();
-    std::get<1>(m_appl_storage).sweep();
-    std::get<0>(m_appl_storage).sweep();
-    m_int_storage.sweep();
+    std::size_t sweep_threads = sweep();
 
     // Check that after sweeping the terms are consistent.
     assert(m_int_storage.verify_sweep());
@@ -254,21 +249,30 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
     assert(std::get<6>(m_appl_storage).verify_sweep());
     assert(std::get<7>(m_appl_storage).verify_sweep());
     assert(m_appl_dynamic_storage.verify_sweep());
+    auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+
+    // Garbage collect function symbols.
+    m_function_symbol_pool.sweep();
+    ++m_number_of_collections;
+    m_number_of_erased_terms += old_size - size();
 
     // Print some statistics.
     if (EnableGarbageCollectionMetrics)
     {
       // Update the times
-      auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+      auto pause_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - pause_start).count();
+      m_total_pause_duration += pause_duration;
+      m_longest_pause_duration = std::max(m_longest_pause_duration, pause_duration);
 
       // Print the relevant information.
       mCRL2log(mcrl2::log::info) << "g_term_pool(): Garbage collected " << old_size - size() << " terms, " << size() << " terms remaining in "
-        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms using "
+        << sweep_threads << (sweep_threads == 1 ? " thread" : " threads") << ").\n";
+      mCRL2log(mcrl2::log::info) << "g_term_pool(): All threads were paused for " << pause_duration << " ms; longest pause "
+        << m_longest_pause_duration << " ms and total pause " << m_total_pause_duration << " ms over " << m_number_of_collections
+        << " collections.\n";
     }
 
-    // Garbage collect function symbols.
-    m_function_symbol_pool.sweep();
-
     print_performance_statistics();
 
     // Use some heuristics to determine when the next collect should be called automatically.
@@ -281,6 +285,79 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
   }
 }
 
+std::size_t aterm_pool::sweep()
+{
+  // There are ten storages, so more threads cannot be used.
+  std::size_t number_of_threads = EnableParallelSweep && mcrl2::utilities::detail::GlobalThreadSafe
+    ? std::min<std::size_t>(mcrl2::utilities::detail::tool_number_of_threads(), 10) : 1;
+  if (number_of_threads <= 1 || size() < ParallelSweepThreshold)
+  {
+    m_appl_dynamic_storage.sweep();
+    std::get<7>(m_appl_storage).sweep();
+    std::get<6>(m_appl_storage).sweep();
+    std::get<5>(m_appl_storage).sweep();
+    std::get<4>(m_appl_storage).sweep();
+    std::get<3>(m_appl_storage).sweep();
+    std::get<2>(m_appl_storage).sweep();
+    std::get<1>(m_appl_storage).sweep();
+    std::get<0>(m_appl_storage).sweep();
+    m_int_storage.sweep();
+    return 1;
+  }
+
+  // The storages are swept in the same order as in the sequential case, such that the arguments of terms
+  // with a deletion hook still exist when the hook is called. Storages with deletion hooks are swept by this
+  // thread, as the hooks may create and protect terms, which the helper threads cannot do while this thread
+  // holds the exclusive lock. The storages before the first and after the last storage with a deletion hook
+  // are swept in parallel.
+  std::vector<std::pair<bool, std::function<void()>>> sweeps;
+  auto add_sweep = [&](auto& storage)
+  {
+    sweeps.emplace_back(storage.has_deletion_hooks(), [&storage]() { storage.sweep(); });
+  };
+
+  add_sweep(m_appl_dynamic_storage);
+  add_sweep(std::get<7>(m_appl_storage));
+  add_sweep(std::get<6>(m_appl_storage));
+  add_sweep(std::get<5>(m_appl_storage));
+  add_sweep(std::get<4>(m_appl_storage));
+  add_sweep(std::get<3>(m_appl_storage));
+  add_sweep(std::get<2>(m_appl_storage));
+  add_sweep(std::get<1>(m_appl_storage));
+  add_sweep(std::get<0>(m_appl_storage));
+  add_sweep(m_int_storage);
+
+  auto first_hook = std::find_if(sweeps.begin(), sweeps.end(), [](const auto& sweep) { return sweep.first; });
+  auto last_hook = std::find_if(sweeps.rbegin(), sweeps.rend(), [](const auto& sweep) { return sweep.first; }).base();
+
+  auto sweep_in_parallel = [&](auto begin, auto end)
+  {
+    std::vector<std::function<void()>> tasks;
+    for (auto it = begin; it != end; ++it)
+    {
+      tasks.emplace_back(std::move(it->second));
+    }
+    m_sweep_thread_pool.start(tasks, number_of_threads - 1);
+    m_sweep_thread_pool.finish();
+  };
+
+  if (first_hook == sweeps.end())
+  {
+    sweep_in_parallel(sweeps.begin(), sweeps.end());
+  }
+  else
+  {
+    sweep_in_parallel(sweeps.begin(), first_hook);
+    for (auto it = first_hook; it != last_hook; ++it)
+    {
+      it->second();
+    }
+    sweep_in_parallel(last_hook, sweeps.end());
+  }
+
+  return number_of_threads;
+}
+
 function_symbol aterm_pool::create_function_symbol(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
 {
   return m_function_symbol_pool.create(name, arity, check_for_registered_functions);
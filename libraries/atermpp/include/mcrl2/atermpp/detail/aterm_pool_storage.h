@@ -66,6 +66,9 @@ public:
   /// \brief Add a callback that is triggered whenever a term with the given function symbol is destroyed.
   void add_deletion_hook(function_symbol sym, term_callback callback);
 
+  /// \returns True iff a deletion hook has been added to this storage.
+  bool has_deletion_hooks() const { return !m_deletion_hooks.empty(); }
+
   /// \returns The total number of terms that can be stored without resizing.
   std::size_t capacity() const noexcept { return m_term_set.capacity(); }
 
@@ -0,0 +1,131 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_DETAIL_SWEEP_THREAD_POOL_H
+#define MCRL2_ATERMPP_DETAIL_SWEEP_THREAD_POOL_H
+
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace atermpp::detail
+{
+
+/// \brief A set of helper threads that is used to sweep the term storages in parallel during
+///        garbage collection.
+/// \details The threads are created once and reused for every collection. This matters as the
+///          block allocators keep state per thread, and a fresh thread per collection would
+///          let that state grow with the number of collections. The helper threads never
+///          create or protect terms, so tasks that may do so, i.e., deletion hooks, must be
+///          executed by the collecting thread itself.
+class sweep_thread_pool : private mcrl2::utilities::noncopyable
+{
+public:
+  sweep_thread_pool() = default;
+
+  ~sweep_thread_pool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_work_available.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  /// \brief Starts executing the given tasks on at most number_of_threads helper threads.
+  /// \details The tasks must remain valid until finish() has returned.
+  void start(std::vector<std::function<void()>>& tasks, std::size_t number_of_threads)
+  {
+    while (m_threads.size() < number_of_threads)
+    {
+      m_threads.emplace_back([this]() { run(); });
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_tasks = &tasks;
+      m_next_task = 0;
+      m_finished_tasks = 0;
+    }
+    m_work_available.notify_all();
+  }
+
+  /// \brief Helps executing the remaining tasks and returns when all tasks have finished.
+  void finish()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_tasks != nullptr && m_next_task < m_tasks->size())
+    {
+      execute_next_task(lock);
+    }
+
+    m_work_done.wait(lock, [this]() { return m_tasks == nullptr || m_finished_tasks == m_tasks->size(); });
+    m_tasks = nullptr;
+  }
+
+  /// \returns The number of helper threads.
+  std::size_t size() const
+  {
+    return m_threads.size();
+  }
+
+private:
+  /// \brief Executes the next task with the lock released, and signals when it was the last one.
+  void execute_next_task(std::unique_lock<std::mutex>& lock)
+  {
+    std::function<void()>& task = (*m_tasks)[m_next_task++];
+    lock.unlock();
+    task();
+    lock.lock();
+
+    if (++m_finished_tasks == m_tasks->size())
+    {
+      m_work_done.notify_all();
+    }
+  }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      m_work_available.wait(lock, [this]() { return m_stop || (m_tasks != nullptr && m_next_task < m_tasks->size()); });
+      if (m_stop)
+      {
+        return;
+      }
+
+      execute_next_task(lock);
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+
+  std::vector<std::function<void()>>* m_tasks = nullptr; ///< The tasks of the current collection.
+  std::size_t m_next_task = 0;
+  std::size_t m_finished_tasks = 0;
+  bool m_stop = false;
+};
+
+} // namespace atermpp::detail
+
+#endif // MCRL2_ATERMPP_DETAIL_SWEEP_THREAD_POOL_H
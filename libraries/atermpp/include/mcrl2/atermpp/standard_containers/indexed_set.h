@@ -11,6 +11,7 @@
 
 #include "mcrl2/atermpp/detail/thread_aterm_pool.h"
 #include "mcrl2/atermpp/standard_containers/deque.h"
+#include "mcrl2/utilities/concurrent_indexed_set.h"
 #include "mcrl2/utilities/detail/container_utility.h"
 #include "mcrl2/utilities/indexed_set.h"
 #include "mcrl2/utilities/shared_mutex.h"
@@ -66,6 +67,70 @@ public:
   }
 };
 
+/// \brief A set that assigns each element an unique index, in which multiple threads can insert elements without locking.
+/// \details The terms are protected en masse, and the shared lock of the term pool is only held during an insertion
+///          such that garbage collection cannot take place while a term is being stored.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key> >
+class concurrent_indexed_set: public mcrl2::utilities::concurrent_indexed_set<Key, Hash, Equals, detail::markable_aterm<Key> >
+{
+  using super = mcrl2::utilities::concurrent_indexed_set<Key, Hash, Equals, detail::markable_aterm<Key> >;
+
+  detail::generic_aterm_container<super> container_wrapper;
+
+public:
+  using size_type = typename super::size_type;
+
+  /// \brief Constructor of an empty indexed set.
+  concurrent_indexed_set()
+    : super(),
+      container_wrapper(*this)
+  {}
+
+  /// \brief Constructor of an empty indexed set.
+  concurrent_indexed_set(std::size_t number_of_threads)
+    : super(number_of_threads),
+      container_wrapper(*this)
+  {}
+
+  /// \brief Constructor of an empty index set. Starts with a hashtable of the indicated size.
+  /// \param initial_hashtable_size The initial size of the hashtable.
+  /// \param hash The hash function.
+  /// \param equals The comparison function for its elements.
+  concurrent_indexed_set(std::size_t number_of_threads,
+                         std::size_t initial_hashtable_size,
+                         const typename super::hasher& hash = typename super::hasher(),
+                         const typename super::key_equal& equals = typename super::key_equal())
+    : super(number_of_threads, initial_hashtable_size, hash, equals),
+      container_wrapper(*this)
+  {}
+
+  concurrent_indexed_set(const concurrent_indexed_set& other)
+    : super(other),
+      container_wrapper(*this)
+  {}
+
+  concurrent_indexed_set& operator=(const concurrent_indexed_set& other)
+  {
+    mcrl2::utilities::shared_guard guard = detail::g_thread_term_pool().lock_shared();
+    super::operator=(other);
+    return *this;
+  }
+
+  void clear(std::size_t thread_index=0)
+  {
+    mcrl2::utilities::shared_guard guard = detail::g_thread_term_pool().lock_shared();
+    super::clear(thread_index);
+  }
+
+  std::pair<size_type, bool> insert(const Key& key, std::size_t thread_index=0)
+  {
+    mcrl2::utilities::shared_guard guard = detail::g_thread_term_pool().lock_shared();
+    return super::insert(key, thread_index);
+  }
+};
+
 } // end namespace atermppp
 
 namespace mcrl2::utilities::detail
@@ -86,6 +151,16 @@ bool contains(const atermpp::indexed_set<Key, ThreadSafe, Hash, Equals, Allocato
   return c.find(v, thread_index) != c.end(thread_index);
 }
 
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key> >
+bool contains(const atermpp::concurrent_indexed_set<Key, Hash, Equals>& c,
+              const typename atermpp::concurrent_indexed_set<Key, Hash, Equals>::key_type& v,
+              const std::size_t thread_index=0)
+{
+  return c.find(v, thread_index) != c.end(thread_index);
+}
+
 } // namespace mcrl2::utilities::detail
 
 #endif // MCRL2_ATERMPP_INDEXED_SET_H
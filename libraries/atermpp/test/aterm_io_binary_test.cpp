@@ -104,3 +104,37 @@ BOOST_AUTO_TEST_CASE(transitions_test)
     BOOST_CHECK_EQUAL(t, term);
   }
 }
+
+BOOST_AUTO_TEST_CASE(compressed_test)
+{
+  std::vector<aterm> sequence;
+
+  function_symbol transition("transition", 3);
+  for (std::size_t index = 0; index < 100000; ++index)
+  {
+    sequence.emplace_back(transition, aterm_int(index), aterm_int(index % 7), aterm_int(index + 1));
+  }
+
+  std::stringstream stream;
+  {
+    binary_aterm_ostream output(stream, true);
+
+    for (const atermpp::aterm& term : sequence)
+    {
+      output << term;
+    }
+  }
+
+  binary_aterm_istream input(stream);
+
+  for (const atermpp::aterm& term : sequence)
+  {
+    aterm t;
+    input.get(t);
+    BOOST_CHECK_EQUAL(t, term);
+  }
+
+  aterm t;
+  input.get(t);
+  BOOST_CHECK(!t.defined());
+}
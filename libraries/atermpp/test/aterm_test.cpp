@@ -78,3 +78,21 @@ BOOST_AUTO_TEST_CASE(test_several_aterm_io)
   test_aterm_io("[a,b,[]]");
   test_aterm_io("f([a,f(x),[]],2,[g,g(34566)])"); 
 }
+
+BOOST_AUTO_TEST_CASE(test_number_of_created_terms)
+{
+  const function_symbol f("__test_number_of_created_terms__", 1);
+  const std::size_t created_terms = detail::g_term_pool().number_of_created_terms();
+  {
+    aterm t(f, aterm_int(987654321));
+    aterm u(f, aterm_int(987654321));
+    BOOST_CHECK(t == u);
+  }
+  BOOST_CHECK_EQUAL(detail::g_term_pool().number_of_created_terms(), created_terms + 2);
+
+  // Terms that are removed by garbage collection are still counted, and are created again afterwards.
+  detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(detail::g_term_pool().number_of_created_terms(), created_terms + 2);
+  aterm t(f, aterm_int(987654321));
+  BOOST_CHECK_EQUAL(detail::g_term_pool().number_of_created_terms(), created_terms + 4);
+}
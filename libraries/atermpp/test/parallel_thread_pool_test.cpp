@@ -11,12 +11,15 @@
 #include <boost/test/included/unit_test.hpp>
 
 #include "mcrl2/atermpp/aterm.h"
+#include "mcrl2/atermpp/aterm_int.h"
 #include "mcrl2/atermpp/aterm_io.h"
 #include "mcrl2/atermpp/detail/global_aterm_pool.h"
 #include "mcrl2/utilities/configuration.h"
+#include "mcrl2/utilities/detail/tool_number_of_threads.h"
 
 #include <atomic>
 #include <thread>
+#include <vector>
 
 using namespace atermpp;
 
@@ -100,3 +103,54 @@ BOOST_AUTO_TEST_CASE(test_worker_thread_aterm_survives_gc)
     delete orphan;
   }
 }
+
+// Verify that sweeping the storages with helper threads removes exactly the
+// unreachable terms. The function application storage of arity two has a
+// deletion hook and is therefore swept by the collecting thread, while the
+// storages of integers and applications of arity one are swept by the helpers
+// after the hooks have been called.
+BOOST_AUTO_TEST_CASE(test_parallel_sweep)
+{
+  if constexpr (!mcrl2::utilities::detail::GlobalThreadSafe)
+  {
+    return;
+  }
+
+  const atermpp::function_symbol f("__test_parallel_sweep_f__", 1);
+  const atermpp::function_symbol g("__test_parallel_sweep_g__", 2);
+
+  static std::atomic<std::size_t> number_of_collected_terms{ 0 };
+  atermpp::add_deletion_hook(g,
+    [](const atermpp::aterm& t) { if (t[1].defined()) { ++number_of_collected_terms; } });
+
+  mcrl2::utilities::detail::set_tool_number_of_threads(4);
+
+  const std::size_t n = atermpp::detail::ParallelSweepThreshold;
+  std::vector<atermpp::aterm> reachable;
+  {
+    std::vector<atermpp::aterm> unreachable;
+    for (std::size_t i = 0; i < 2 * n; ++i)
+    {
+      atermpp::aterm t(g, atermpp::aterm(f, atermpp::aterm_int(i)), atermpp::aterm_int(i + 1));
+      if (i % 2 == 0)
+      {
+        reachable.push_back(t);
+      }
+      else
+      {
+        unreachable.push_back(t);
+      }
+    }
+  }
+
+  atermpp::detail::g_thread_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_collected_terms, n);
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const atermpp::aterm& t = reachable[i];
+    BOOST_CHECK(t == atermpp::aterm(g, atermpp::aterm(f, atermpp::aterm_int(2 * i)), atermpp::aterm_int(2 * i + 1)));
+  }
+
+  mcrl2::utilities::detail::set_tool_number_of_threads(1);
+}
@@ -0,0 +1,344 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file rewriter_benchmark.cpp
+/// \brief Measures the performance of the rewriters on pairs of .dataspec and .expressions files, such as the
+///        ones in benchmarks/REC, and reports the results as JSON.
+
+#include "mcrl2/data/detail/rewrite_statistics.h"
+#include "mcrl2/data/parse.h"
+#include "mcrl2/data/rewriter.h"
+#include "mcrl2/utilities/text_utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+
+using namespace mcrl2;
+
+struct benchmark_options
+{
+  std::vector<data::rewrite_strategy> strategies;
+  std::size_t warmup = 1;
+  std::size_t repetitions = 5;
+  std::string output;
+  std::vector<std::filesystem::path> dataspecs;
+};
+
+struct benchmark_result
+{
+  std::string benchmark;
+  data::rewrite_strategy strategy;
+  std::size_t number_of_expressions = 0;
+  double setup_time = 0;
+  std::vector<double> times;
+
+  // The statistics are averages over the measured repetitions.
+  std::optional<std::size_t> rewrite_steps;
+  std::size_t term_creations = 0;
+  std::size_t garbage_collections = 0;
+
+  std::string error;
+};
+
+static double milliseconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void print_usage(std::ostream& out)
+{
+  out << "Usage: rewriter_benchmark [OPTION]... FILE...\n"
+         "Rewrites the expressions in NAME.expressions, one per line, with the data specification in NAME.dataspec\n"
+         "for every FILE NAME.dataspec, or for every .dataspec file in FILE if it is a directory, and prints the\n"
+         "results as JSON.\n"
+         "\n"
+         "  --rewriter=NAMES   comma separated list of rewrite strategies (default: all of jitty, jittyc and jittyp\n"
+         "                     that are available)\n"
+         "  --warmup=NUM       rewrite all expressions NUM times before measuring (default: 1)\n"
+         "  --repetitions=NUM  measure rewriting all expressions NUM times (default: 5)\n"
+         "  --output=FILE      write the results to FILE instead of standard output\n";
+}
+
+static benchmark_options parse_options(int argc, char* argv[])
+{
+  benchmark_options options;
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string argument = argv[i];
+    auto value = [&](const std::string& option) -> std::optional<std::string>
+    {
+      if (argument.starts_with(option + "="))
+      {
+        return argument.substr(option.size() + 1);
+      }
+      return std::nullopt;
+    };
+
+    if (argument == "--help" || argument == "-h")
+    {
+      print_usage(std::cout);
+      std::exit(EXIT_SUCCESS);
+    }
+    else if (auto names = value("--rewriter"))
+    {
+      for (const std::string& name: utilities::split(*names, ","))
+      {
+        options.strategies.push_back(data::parse_rewrite_strategy(name));
+      }
+    }
+    else if (auto warmup = value("--warmup"))
+    {
+      options.warmup = std::stoul(*warmup);
+    }
+    else if (auto repetitions = value("--repetitions"))
+    {
+      options.repetitions = std::max<std::size_t>(1, std::stoul(*repetitions));
+    }
+    else if (auto output = value("--output"))
+    {
+      options.output = *output;
+    }
+    else if (argument.starts_with("-"))
+    {
+      throw mcrl2::runtime_error("unknown option " + argument + ".");
+    }
+    else if (std::filesystem::is_directory(argument))
+    {
+      std::vector<std::filesystem::path> files;
+      for (const std::filesystem::directory_entry& entry: std::filesystem::directory_iterator(argument))
+      {
+        if (entry.path().extension() == ".dataspec")
+        {
+          files.push_back(entry.path());
+        }
+      }
+      std::sort(files.begin(), files.end());
+      options.dataspecs.insert(options.dataspecs.end(), files.begin(), files.end());
+    }
+    else
+    {
+      options.dataspecs.emplace_back(argument);
+    }
+  }
+
+  if (options.strategies.empty())
+  {
+    options.strategies.push_back(data::jitty);
+#ifdef MCRL2_ENABLE_JITTYC
+    options.strategies.push_back(data::jitty_compiling);
+#endif
+    options.strategies.push_back(data::jitty_prover);
+  }
+  return options;
+}
+
+static benchmark_result run_benchmark(const std::filesystem::path& dataspec_file,
+                                      data::rewrite_strategy strategy,
+                                      const benchmark_options& options)
+{
+  benchmark_result result;
+  result.benchmark = dataspec_file.stem().string();
+  result.strategy = strategy;
+
+  try
+  {
+    data::data_specification dataspec = data::parse_data_specification(utilities::read_text(dataspec_file.string()));
+
+    std::vector<data::data_expression> expressions;
+    std::ifstream expressions_file(std::filesystem::path(dataspec_file).replace_extension(".expressions"));
+    if (!expressions_file)
+    {
+      throw mcrl2::runtime_error("cannot open the expressions belonging to " + dataspec_file.string() + ".");
+    }
+    std::string line;
+    while (std::getline(expressions_file, line))
+    {
+      if (!utilities::trim_copy(line).empty())
+      {
+        expressions.push_back(data::parse_data_expression(line, dataspec));
+      }
+    }
+    result.number_of_expressions = expressions.size();
+
+    // The setup time includes the compilation of the rewriter for jittyc.
+    auto start = std::chrono::steady_clock::now();
+    data::rewriter rewriter(dataspec, strategy);
+    result.setup_time = milliseconds_since(start);
+
+    data::data_expression normal_form;
+    for (std::size_t i = 0; i < options.warmup; ++i)
+    {
+      for (const data::data_expression& expression: expressions)
+      {
+        rewriter(normal_form, expression);
+      }
+    }
+
+    for (std::size_t i = 0; i < options.repetitions; ++i)
+    {
+      // Every repetition starts with a garbage collection, such that the number of created terms is comparable.
+      atermpp::detail::g_thread_term_pool().collect();
+      const std::size_t created_terms = atermpp::detail::g_term_pool().number_of_created_terms();
+      const std::size_t collections = atermpp::detail::g_term_pool().number_of_collections();
+
+      start = std::chrono::steady_clock::now();
+      for (const data::data_expression& expression: expressions)
+      {
+        rewriter(normal_form, expression);
+      }
+      result.times.push_back(milliseconds_since(start));
+
+      result.term_creations += atermpp::detail::g_term_pool().number_of_created_terms() - created_terms;
+      result.garbage_collections += atermpp::detail::g_term_pool().number_of_collections() - collections;
+    }
+
+    // Only the jitty rewriter, which is also used by jittyp, counts the rewrite steps. They are counted in a
+    // separate pass, such that counting does not affect the measured times.
+    if (strategy == data::jitty || strategy == data::jitty_prover)
+    {
+      data::detail::count_rewrite_steps(true);
+      const std::size_t steps = data::detail::rewrite_step_count();
+      for (const data::data_expression& expression: expressions)
+      {
+        rewriter(normal_form, expression);
+      }
+      result.rewrite_steps = data::detail::rewrite_step_count() - steps;
+      data::detail::count_rewrite_steps(false);
+    }
+    result.term_creations /= options.repetitions;
+    result.garbage_collections /= options.repetitions;
+  }
+  catch (const std::exception& e)
+  {
+    result.error = e.what();
+  }
+  return result;
+}
+
+static std::string json_string(const std::string& s)
+{
+  std::ostringstream out;
+  out << '"';
+  for (char c: s)
+  {
+    switch (c)
+    {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        }
+        else
+        {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+static void print_json(std::ostream& out, const benchmark_result& result, const benchmark_options& options)
+{
+  out << "  {\"benchmark\": " << json_string(result.benchmark)
+      << ", \"rewriter\": " << json_string(data::pp(result.strategy));
+  if (!result.error.empty())
+  {
+    out << ", \"error\": " << json_string(result.error) << "}";
+    return;
+  }
+
+  std::vector<double> times = result.times;
+  std::sort(times.begin(), times.end());
+  double total = 0;
+  for (double t: times)
+  {
+    total += t;
+  }
+
+  out << std::fixed << std::setprecision(3)
+      << ", \"expressions\": " << result.number_of_expressions
+      << ", \"warmup\": " << options.warmup
+      << ", \"repetitions\": " << options.repetitions
+      << ", \"setup_ms\": " << result.setup_time
+      << ", \"times_ms\": [";
+  for (std::size_t i = 0; i < result.times.size(); ++i)
+  {
+    out << (i == 0 ? "" : ", ") << result.times[i];
+  }
+  out << "], \"min_ms\": " << times.front()
+      << ", \"median_ms\": " << times[times.size() / 2]
+      << ", \"mean_ms\": " << total / times.size()
+      << ", \"rewrite_steps\": ";
+  if (result.rewrite_steps)
+  {
+    out << *result.rewrite_steps;
+  }
+  else
+  {
+    out << "null";
+  }
+  out << ", \"term_creations\": " << result.term_creations
+      << ", \"garbage_collections\": " << result.garbage_collections << "}";
+}
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    benchmark_options options = parse_options(argc, argv);
+    if (options.dataspecs.empty())
+    {
+      print_usage(std::cerr);
+      return EXIT_FAILURE;
+    }
+
+    std::ofstream output_file;
+    if (!options.output.empty())
+    {
+      output_file.open(options.output);
+      if (!output_file)
+      {
+        throw mcrl2::runtime_error("cannot open " + options.output + " for writing.");
+      }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : output_file;
+
+    bool failed = false;
+    bool first = true;
+    out << "[\n";
+    for (const std::filesystem::path& dataspec: options.dataspecs)
+    {
+      for (data::rewrite_strategy strategy: options.strategies)
+      {
+        benchmark_result result = run_benchmark(dataspec, strategy, options);
+        failed = failed || !result.error.empty();
+        out << (first ? "" : ",\n");
+        print_json(out, result, options);
+        out << std::flush;
+        first = false;
+      }
+    }
+    out << "\n]\n";
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "rewriter_benchmark: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -896,6 +896,9 @@ class cvc_smt_solver : public SMT_LIB_Solver, public binary_smt_solver< cvc_smt_
 ///
 /// The method z3_smt_solver::is_satisfiable receives a formula in conjunctive normal form as parameter a_formula and
 /// indicates whether or not this formula is satisfiable.
+///
+/// Every formula is solved by a new Z3 process. The persistent session smt::smt_solver cannot be used here, because
+/// the prover is part of the data library, on which the smt library depends.
 class z3_smt_solver : public SMT_LIB_Solver, public binary_smt_solver< z3_smt_solver >
 {
     friend class binary_smt_solver< z3_smt_solver >;
@@ -11,6 +11,7 @@
 #define MCRL2_DATA_DETAIL_REWRITE_JITTY_H
 
 #include "mcrl2/data/detail/rewrite.h"
+#include "mcrl2/data/detail/rewrite/jitty_normal_form_cache.h"
 #include "mcrl2/data/detail/rewrite/rewrite_stack.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
 
@@ -84,6 +85,7 @@ class RewriterJitty: public Rewriter
     class rewrite_stack m_rewrite_stack;     // Stack for intermediate rewrite results.
 
     std::vector<data_expression> rhs_for_constants_cache; // Cache that contains normal forms for constants. 
+    jitty_normal_form_cache m_normal_form_cache;          // Cache that contains normal forms for closed terms, if enabled.
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
 
@@ -100,6 +102,8 @@ class RewriterJitty: public Rewriter
 
     void rewrite_aux(data_expression& result, const data_expression& term, substitution_type& sigma);
 
+    void rewrite_aux_application(data_expression& result, const application& term, substitution_type& sigma);
+
     void rewrite_aux_function_symbol(data_expression& result,
       const function_symbol& op,
       const application& term,
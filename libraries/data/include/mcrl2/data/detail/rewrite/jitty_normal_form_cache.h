@@ -0,0 +1,203 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/jitty_normal_form_cache.h
+/// \brief A bounded cache from closed terms to their normal forms, used by the jitty rewriter.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_JITTY_NORMAL_FORM_CACHE_H
+#define MCRL2_DATA_DETAIL_REWRITE_JITTY_NORMAL_FORM_CACHE_H
+
+#include <iomanip>
+#include <vector>
+#include "mcrl2/atermpp/detail/aterm_container.h"
+#include "mcrl2/atermpp/detail/thread_aterm_pool.h"
+#include "mcrl2/data/abstraction.h"
+#include "mcrl2/data/application.h"
+#include "mcrl2/data/function_symbol.h"
+#include "mcrl2/data/machine_number.h"
+#include "mcrl2/utilities/logger.h"
+
+namespace mcrl2::data::detail
+{
+
+// Stores the number of entries of the normal form cache of newly created jitty rewriters. 0 means no cache.
+template <class T> // note, T is only a dummy
+struct jitty_normal_form_cache_size
+{
+  static std::size_t size;
+};
+
+// Initialization
+template <class T>
+std::size_t jitty_normal_form_cache_size<T>::size = 0;
+
+inline
+void set_jitty_normal_form_cache_size(std::size_t size)
+{
+  jitty_normal_form_cache_size<std::size_t>::size = size;
+}
+
+inline
+std::size_t get_jitty_normal_form_cache_size()
+{
+  return jitty_normal_form_cache_size<std::size_t>::size;
+}
+
+/// \brief A direct mapped cache from closed terms to their normal forms.
+/// \details The terms in the cache are not protected. When garbage is collected, the entries that have been
+///          used since the previous garbage collection are marked and the others are removed. So the cache
+///          does not keep terms alive that are not used anymore. The cache is not thread safe, and every
+///          rewriter, which is used by a single thread, has its own cache. Lookups and insertions take place
+///          under a shared lock of the term pool, such that no garbage collection can take place meanwhile.
+class jitty_normal_form_cache
+{
+  protected:
+    struct entry
+    {
+      const atermpp::detail::_aterm* term = nullptr;
+      const atermpp::detail::_aterm* normal_form = nullptr;
+      bool used = false;
+    };
+
+    // The maximal number of function symbols and applications that is inspected to determine whether
+    // a term is closed. Larger terms are not stored, which bounds the cost of a cache miss.
+    static constexpr std::size_t max_closedness_check = 256;
+
+    std::vector<entry> m_entries;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+    atermpp::detail::aterm_container m_container;
+
+    entry& find_entry(const data_expression& t)
+    {
+      return m_entries[std::hash<atermpp::aterm_core>()(t) % m_entries.size()];
+    }
+
+    // Marks the entries that have been used since the previous garbage collection, and removes the others.
+    void mark(atermpp::term_mark_stack& todo)
+    {
+      for (entry& e: m_entries)
+      {
+        if (e.used)
+        {
+          atermpp::detail::mark_term(*e.term, todo);
+          atermpp::detail::mark_term(*e.normal_form, todo);
+          e.used = false;
+        }
+        else
+        {
+          e = entry();
+        }
+      }
+    }
+
+    static bool is_closed(const data_expression& t, std::size_t& budget)
+    {
+      if (budget == 0)
+      {
+        return false;
+      }
+      budget--;
+      if (is_function_symbol(t) || is_machine_number(t))
+      {
+        return true;
+      }
+      if (!is_application(t))
+      {
+        // Variables, and the variables bound in abstractions and where clauses, are not considered.
+        return false;
+      }
+      const application& ta = atermpp::down_cast<application>(t);
+      if (!is_closed(ta.head(), budget))
+      {
+        return false;
+      }
+      for (const data_expression& u: ta)
+      {
+        if (!is_closed(u, budget))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param size The number of entries of the cache. If 0 the cache is disabled.
+    explicit jitty_normal_form_cache(std::size_t size)
+      : m_entries(size),
+        m_container([this](atermpp::term_mark_stack& todo) { mark(todo); },
+                    [this]() -> std::size_t { return m_entries.size(); })
+    {}
+
+    /// \brief Copy constructor. The copy has the same size, but is empty.
+    jitty_normal_form_cache(const jitty_normal_form_cache& other)
+      : jitty_normal_form_cache(other.m_entries.size())
+    {}
+
+    jitty_normal_form_cache& operator=(const jitty_normal_form_cache& other) = delete;
+
+    ~jitty_normal_form_cache()
+    {
+      if (m_hits + m_misses > 0)
+      {
+        mCRL2log(log::verbose) << "Normal form cache of " << m_entries.size() << " entries: " << m_hits
+                               << " hits and " << m_misses << " misses (hit rate " << std::fixed
+                               << std::setprecision(1) << (100.0 * m_hits) / (m_hits + m_misses) << "%).\n";
+      }
+    }
+
+    bool enabled() const
+    {
+      return !m_entries.empty();
+    }
+
+    /// \brief Looks up the normal form of t.
+    /// \return True iff the normal form of t was found, in which case it is assigned to result.
+    bool find(data_expression& result, const data_expression& t, atermpp::detail::thread_aterm_pool& pool)
+    {
+      mcrl2::utilities::shared_guard guard = pool.lock_shared();
+      entry& e = find_entry(t);
+      if (e.term == atermpp::detail::address(t))
+      {
+        e.used = true;
+        m_hits++;
+        result.assign(atermpp::down_cast<data_expression>(atermpp::aterm_core(e.normal_form)), pool);
+        return true;
+      }
+      m_misses++;
+      return false;
+    }
+
+    /// \brief Stores normal_form as the normal form of t, if t is a closed term of moderate size.
+    void insert(const data_expression& t, const data_expression& normal_form, atermpp::detail::thread_aterm_pool& pool)
+    {
+      std::size_t budget = max_closedness_check;
+      if (!is_closed(t, budget))
+      {
+        return;
+      }
+      mcrl2::utilities::shared_guard guard = pool.lock_shared();
+      find_entry(t) = entry{atermpp::detail::address(t), atermpp::detail::address(normal_form), true};
+    }
+
+    std::size_t hits() const
+    {
+      return m_hits;
+    }
+
+    std::size_t misses() const
+    {
+      return m_misses;
+    }
+};
+
+} // namespace mcrl2::data::detail
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_JITTY_NORMAL_FORM_CACHE_H
@@ -11,6 +11,7 @@
 #ifndef MCRL2_DATA_DETAIL_REWR_JITTYC_H
 #define MCRL2_DATA_DETAIL_REWR_JITTYC_H
 
+#include <deque>
 #include <utility>
 #include <string>
 
@@ -34,11 +35,33 @@ using sort_list_vector = std::vector<sort_expression_list>;
 ///        are inserted in it. By keeping the cache on the stack, the normal forms
 ///        in it will not be freed by the ATerm library, and can therefore be used
 ///        in the generated jittyc code.
+/// \details Besides normal forms, the cache stores the other terms that the generated
+///          code refers to, such as bound variables and the function symbols of which
+///          the index is needed. The generated code contains the text of all terms in
+///          the cache, which it reads when it is loaded. So it does not depend on the
+///          addresses or indices of terms in the process that generated it.
 ///
 class normal_form_cache
 {
   private:
-    std::set<data_expression> m_lookup;
+    // A deque is used such that the references to the terms remain valid when terms are added.
+    std::deque<atermpp::aterm> m_terms;
+    std::map<atermpp::aterm, std::size_t> m_lookup;
+
+    // The positions in m_terms of the function symbols of which the index is needed.
+    std::vector<std::size_t> m_function_symbols;
+    std::map<function_symbol, std::size_t> m_function_symbol_lookup;
+
+    std::size_t index(const atermpp::aterm& t)
+    {
+      const auto [it, inserted] = m_lookup.emplace(t, m_terms.size());
+      if (inserted)
+      {
+        m_terms.push_back(t);
+      }
+      return it->second;
+    }
+
   public:
     normal_form_cache() = default;
 
@@ -51,17 +74,79 @@ class normal_form_cache
   
   /// \brief insert stores the normal form of t in the cache, and returns a string
   ///        that is a C++ representation of the stored normal form. This string can
-  ///        be used by the generated rewriter as long as the cache object is alive,
-  ///        and its clear() method has not been called.
+  ///        be used by the generated rewriter as long as the cache object is alive.
+  ///        The string refers to an entry of the array cached_terms of the generated
+  ///        code, which is filled when the rewriter is loaded.
   /// \param t The term to normalize.
   /// \return A C++ string that evaluates to the cached normal form of t.
   ///
   std::string insert(const data_expression& t)
   {
-    std::stringstream ss;
-    const data_expression* cached_term = &*(m_lookup.insert(t).first);
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)(cached_term) << ")";
-    return ss.str();
+    return "atermpp::down_cast<data_expression>(*cached_terms[" + std::to_string(index(t)) + "])";
+  }
+
+  /// \brief Stores t in the cache, and returns a C++ string that evaluates to the address
+  ///        of t as an integer, see insert. It is an entry of the array cached_addresses.
+  std::string insert_address(const data_expression& t)
+  {
+    return "cached_addresses[" + std::to_string(index(t)) + "]";
+  }
+
+  /// \brief Stores the variable list l in the cache, and returns a C++ string that evaluates to it.
+  std::string insert_variable_list(const variable_list& l)
+  {
+    return "atermpp::down_cast<variable_list>(*cached_terms[" + std::to_string(index(l)) + "])";
+  }
+
+  /// \brief Returns the number of f among the function symbols of which the index is needed. This
+  ///        number, and not the index of f, is used in the names of generated functions.
+  std::size_t function_symbol_number(const function_symbol& f)
+  {
+    const auto [it, inserted] = m_function_symbol_lookup.emplace(f, m_function_symbols.size());
+    if (inserted)
+    {
+      m_function_symbols.push_back(index(f));
+    }
+    return it->second;
+  }
+
+  /// \brief Stores f in the cache, and returns a C++ string that evaluates to the index of f. It
+  ///        is an entry of the array function_indices of the generated code.
+  std::string insert_index(const function_symbol& f)
+  {
+    return "function_indices[" + std::to_string(function_symbol_number(f)) + "]";
+  }
+
+  /// \brief Returns the term with the given index in the cache.
+  const atermpp::aterm& get(std::size_t index) const
+  {
+    assert(index < m_terms.size());
+    return m_terms[index];
+  }
+
+  /// \brief The positions in the cache of the function symbols of which the index is needed.
+  const std::vector<std::size_t>& function_symbols() const
+  {
+    return m_function_symbols;
+  }
+
+  /// \brief Replaces the terms in the cache by the given terms, in this order.
+  void assign(const atermpp::aterm_list& terms)
+  {
+    m_terms.clear();
+    m_lookup.clear();
+    m_function_symbols.clear();
+    m_function_symbol_lookup.clear();
+    for (const atermpp::aterm& t: terms)
+    {
+      index(t);
+    }
+  }
+
+  /// \brief The number of terms in the cache.
+  std::size_t size() const
+  {
+    return m_terms.size();
   }
 
   /// \brief Checks whether the cache is empty.
@@ -74,6 +159,8 @@ class normal_form_cache
   ~normal_form_cache() = default;
 };
 
+struct rewriter_interface;
+
 class RewriterCompilingJitty: public Rewriter
 {
   public:
@@ -228,6 +315,17 @@ class RewriterCompilingJitty: public Rewriter
     // The following vector is to store normal forms of constants, indexed by the sequence number in a constant. 
     std::vector<data_expression> normal_forms_for_constants;
 
+    // Provides the terms that the generated code refers to by their index in the normal form cache.
+    const atermpp::aterm& cached_term(std::size_t index) const
+    {
+      return m_nf_cache->get(index);
+    }
+
+    // Replaces the terms in the normal form cache by the terms in the text, which the generated code
+    // contains. This is done when the generated code is loaded, such that it refers to the terms of
+    // this process. Returns false if the text cannot be read.
+    bool load_cached_terms(const char* text);
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
@@ -272,7 +370,8 @@ class RewriterCompilingJitty: public Rewriter
     bool calc_nfs(const data_expression& t, variable_or_number_list nnfvars);
     void CleanupRewriteSystem();
     void BuildRewriteSystem();
-    void generate_code(const std::string& filename);
+    bool load_rewriter(rewriter_interface& interface);
+    void generate_code(std::ostream& cpp_file);
     void generate_rewr_functions(std::ostream& s, const data::function_symbol& func, const data_equation_list& eqs);
     bool lift_rewrite_rule_to_right_arity(data_equation& e, std::size_t requested_arity);
     sort_list_vector
@@ -55,7 +55,7 @@ static void local_rewrite(data_expression& result, const data_expression& t)
 //
 // Forward declarations
 //
-static void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter);
+static bool set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter);
 
 template <bool ARGUMENTS_IN_NORMAL_FORM>
 static void rewrite_aux(data_expression& result, const data_expression& t, RewriterCompilingJitty* this_rewriter);
@@ -415,7 +415,11 @@ extern "C" {
 
     i->rewrite_external = &rewrite;
     i->rewrite_cleanup = &rewrite_cleanup;
-    set_the_precompiled_rewrite_functions_in_a_lookup_table(this_rewriter);
+    if (!set_the_precompiled_rewrite_functions_in_a_lookup_table(this_rewriter))
+    {
+      i->status = "rewriter does not match the rewrite system of the calling application.";
+      return false;
+    }
     i->status = "rewriter loaded successfully.";
     return true;
   }
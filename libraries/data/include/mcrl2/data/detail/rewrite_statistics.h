@@ -14,6 +14,8 @@
 
 #include "mcrl2/utilities/logger.h"
 
+#include <atomic>
+
 namespace mcrl2::data::detail
 {
 
@@ -32,6 +34,51 @@ std::size_t rewrite_count()
   return rewrite_statistics<int>::rewrite_count;
 }
 
+// The number of rewrite rules, including rules implemented in C++, that the jitty rewriters in the current thread
+// have applied. These are only counted after count_rewrite_steps(true), as counting takes time in the innermost
+// loop of the rewriter.
+template <class T> // note, T is only a dummy
+struct rewrite_step_statistics
+{
+  static std::atomic<bool> enabled;
+  static thread_local std::size_t rewrite_step_count;
+};
+
+template <class T>
+std::atomic<bool> rewrite_step_statistics<T>::enabled = false;
+
+template <class T>
+thread_local std::size_t rewrite_step_statistics<T>::rewrite_step_count = 0;
+
+/// \brief Enables or disables counting the rewrite steps of the jitty rewriters, which is disabled by default.
+inline
+void count_rewrite_steps(bool enable)
+{
+  rewrite_step_statistics<int>::enabled = enable;
+}
+
+/// \brief True iff the jitty rewriters count the rewrite rules that they apply.
+inline
+bool rewrite_steps_are_counted()
+{
+  return rewrite_step_statistics<int>::enabled.load(std::memory_order_relaxed);
+}
+
+inline
+std::size_t rewrite_step_count()
+{
+  return rewrite_step_statistics<int>::rewrite_step_count;
+}
+
+inline
+void increment_rewrite_step_count()
+{
+  if (rewrite_steps_are_counted())
+  {
+    rewrite_step_statistics<int>::rewrite_step_count++;
+  }
+}
+
 inline
 void display_rewrite_statistics()
 {
@@ -13,6 +13,7 @@
 #define MCRL2_DATA_REWRITER_TOOL_H
 
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
+#include "mcrl2/data/detail/rewrite/jitty_normal_form_cache.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/utilities/command_line_interface.h"
 
@@ -28,6 +29,8 @@ class rewriter_tool: public Tool
     data::rewrite_strategy m_rewrite_strategy = mcrl2::data::jitty;
     /// The limit on the number of rewriting steps in quantifiers. By default 10;
     std::size_t m_qlimit=10;
+    /// The number of entries of the normal form cache of the jitty rewriter. By default 0, i.e., no cache.
+    std::size_t m_rewrite_cache=0;
 
     /// \brief Add options to an interface description. Also includes
     /// rewriter options.
@@ -61,6 +64,13 @@ class rewriter_tool: public Tool
         'Q'
       );
 
+      desc.add_option(
+        "rewrite-cache",
+        utilities::make_mandatory_argument("NUM"),
+        "cache the normal forms of closed terms in a cache with NUM entries, per thread, when using the jitty rewriter "
+        "(default NUM=0, no cache). Statistics on the hit rate are printed in verbose mode."
+      );
+
     }
 
     /// \brief Add options to an interface description. Also includes
@@ -82,6 +92,12 @@ class rewriter_tool: public Tool
         m_qlimit = (qlimit == 0 ? std::numeric_limits<std::size_t>::max() : qlimit);
       }
       data::detail::set_enumerator_iteration_limit(m_qlimit);
+
+      if (parser.options.count("rewrite-cache"))
+      {
+        m_rewrite_cache = parser.option_argument_as< std::size_t >("rewrite-cache");
+      }
+      data::detail::set_jitty_normal_form_cache_size(m_rewrite_cache);
     }
 
   public:
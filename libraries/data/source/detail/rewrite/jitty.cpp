@@ -17,9 +17,7 @@
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
 #include "mcrl2/data/replace.h"
 
-#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
 #include "mcrl2/data/detail/rewrite_statistics.h"
-#endif
 
 using namespace mcrl2::log;
 using namespace mcrl2::core;
@@ -172,7 +170,8 @@ RewriterJitty::RewriterJitty(
         Rewriter(data_spec,equation_selector),
         this_term_is_in_normal_form_symbol(
                          std::string("Rewritten@@term"),
-                         function_sort({ untyped_sort() },untyped_sort()))
+                         function_sort({ untyped_sort() },untyped_sort())),
+        m_normal_form_cache(get_jitty_normal_form_cache_size())
 {
   thread_initialise();
   for (const data_equation& eq: data_spec.equations())
@@ -502,81 +501,99 @@ void RewriterJitty::rewrite_aux(
       return;
     }
 
-    // The variable term has the shape appl(t,t1,...,tn);
-  
-    // First check whether t has the shape appl(appl...appl(f,u1,...,un)(...)(...) where f is a function symbol.
-    // In this case rewrite that function symbol. This is an optimisation. If this does not apply t is rewritten,
-    // including all its subterms. But this is costly, as not all subterms will be rewritten again
-    // in rewrite_aux_function_symbol.
-  
-    const data_expression& head=get_nested_head(term);
-  
-    if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
+    if (m_normal_form_cache.enabled())
     {
-      rewrite_aux_function_symbol(result, atermpp::down_cast<function_symbol>(head),terma,sigma);
+      if (!m_normal_form_cache.find(result, terma, *m_thread_aterm_pool))
+      {
+        rewrite_aux_application(result, terma, sigma);
+        m_normal_form_cache.insert(terma, result, *m_thread_aterm_pool);
+      }
       return;
     }
-  
-    const application& tapp=atermpp::down_cast<application>(term);
-    
-    m_rewrite_stack.increase(2);
+    rewrite_aux_application(result, terma, sigma);
+  }
+}
 
-    const std::size_t t = 0;  // Index of variable t in the stack. 
-    rewrite_aux(m_rewrite_stack.element(t,2),tapp.head(),sigma);
+/// \brief Rewrite a term of the shape appl(t,t1,...,tn) with a given substitution and put the rewritten term in result.
+void RewriterJitty::rewrite_aux_application(
+                      data_expression& result,
+                      const application& terma,
+                      substitution_type& sigma)
+{
+  // The variable term has the shape appl(t,t1,...,tn);
+
+  // First check whether t has the shape appl(appl...appl(f,u1,...,un)(...)(...) where f is a function symbol.
+  // In this case rewrite that function symbol. This is an optimisation. If this does not apply t is rewritten,
+  // including all its subterms. But this is costly, as not all subterms will be rewritten again
+  // in rewrite_aux_function_symbol.
 
-    // Here t has the shape f(u1,....,un)(u1',...,um')....: f applied several times to arguments,
-    // x(u1,....,un)(u1',...,um')....: x applied several times to arguments, or
-    // binder x1,...,xn.t' where the binder is a lambda, exists or forall.
+  const data_expression& head=get_nested_head(terma);
+
+  if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
+  {
+    rewrite_aux_function_symbol(result, atermpp::down_cast<function_symbol>(head),terma,sigma);
+    return;
+  }
+
+  const application& tapp=terma;
   
-    const std::size_t head1 = 1;  // Index of variable head1 in the stack. 
-    m_rewrite_stack.set_element(head1,2,get_nested_head(m_rewrite_stack.get_element(t,2)));
-    if (is_function_symbol(m_rewrite_stack.get_element(head1,2)))
-    {
-      // In this case t (i.e. the top of the rewrite stack) has the shape f(u1...un)(u1'...um')....  where all u1,...,un,u1',...,um' are normal formas.
-      // In the invocation of rewrite_aux_function_symbol these terms must not be rewritten to normalform again.
-      make_application(result, m_rewrite_stack.get_element(t,2), tapp.begin(), tapp.end()); 
-      const std::size_t do_not_rewrite_first_arguments=recursive_number_of_args( m_rewrite_stack.get_element(t,2)); 
-      assert(remove_normal_form_function(m_rewrite_stack.get_element(t,2))==m_rewrite_stack.get_element(t,2));
-      rewrite_aux_function_symbol(m_rewrite_stack.element(t,2),
-                                  atermpp::down_cast<function_symbol>(m_rewrite_stack.get_element(head1,2)),
-                                  atermpp::down_cast<application>(result),
-                                  sigma,
-                                  do_not_rewrite_first_arguments);
-      result=m_rewrite_stack.element(t,2);
-      m_rewrite_stack.decrease(2);
-      return;
-    }
-    else if (is_variable(m_rewrite_stack.element(head1,2)))
-    {
-      // return appl(t,t1,...,tn) where t1,...,tn still need to be rewritten.
-      jitty_argument_rewriter r(sigma,*this);
-      const bool do_not_rewrite_head=false;
-      make_application(result, m_rewrite_stack.element(t,2) , tapp.begin(), tapp.end(), r, do_not_rewrite_head); // Replacing r by a lambda term requires 16 more bytes on the stack. 
-      m_rewrite_stack.decrease(2);
-      return;
-    }
-    assert(is_abstraction(m_rewrite_stack.top()));
-    const abstraction& ta=atermpp::down_cast<abstraction>(m_rewrite_stack.element(t,2) );
-    const binder_type& binder(ta.binding_operator());
-    if (is_lambda_binder(binder))
-    {
-      rewrite_lambda_application(result,ta,tapp,sigma);
-      m_rewrite_stack.decrease(2);
-      return;
-    }
-    if (is_exists_binder(binder))
-    {
-      assert(term.size()==1);
-      existential_quantifier_enumeration(result,ta,sigma);
-      m_rewrite_stack.decrease(2);
-      return;
-    }
-    assert(is_forall_binder(binder));
-    assert(term.size()==1);
-    universal_quantifier_enumeration(result,ta,sigma);
+  m_rewrite_stack.increase(2);
+
+  const std::size_t t = 0;  // Index of variable t in the stack. 
+  rewrite_aux(m_rewrite_stack.element(t,2),tapp.head(),sigma);
+
+  // Here t has the shape f(u1,....,un)(u1',...,um')....: f applied several times to arguments,
+  // x(u1,....,un)(u1',...,um')....: x applied several times to arguments, or
+  // binder x1,...,xn.t' where the binder is a lambda, exists or forall.
+
+  const std::size_t head1 = 1;  // Index of variable head1 in the stack. 
+  m_rewrite_stack.set_element(head1,2,get_nested_head(m_rewrite_stack.get_element(t,2)));
+  if (is_function_symbol(m_rewrite_stack.get_element(head1,2)))
+  {
+    // In this case t (i.e. the top of the rewrite stack) has the shape f(u1...un)(u1'...um')....  where all u1,...,un,u1',...,um' are normal formas.
+    // In the invocation of rewrite_aux_function_symbol these terms must not be rewritten to normalform again.
+    make_application(result, m_rewrite_stack.get_element(t,2), tapp.begin(), tapp.end()); 
+    const std::size_t do_not_rewrite_first_arguments=recursive_number_of_args( m_rewrite_stack.get_element(t,2)); 
+    assert(remove_normal_form_function(m_rewrite_stack.get_element(t,2))==m_rewrite_stack.get_element(t,2));
+    rewrite_aux_function_symbol(m_rewrite_stack.element(t,2),
+                                atermpp::down_cast<function_symbol>(m_rewrite_stack.get_element(head1,2)),
+                                atermpp::down_cast<application>(result),
+                                sigma,
+                                do_not_rewrite_first_arguments);
+    result=m_rewrite_stack.element(t,2);
     m_rewrite_stack.decrease(2);
     return;
   }
+  else if (is_variable(m_rewrite_stack.element(head1,2)))
+  {
+    // return appl(t,t1,...,tn) where t1,...,tn still need to be rewritten.
+    jitty_argument_rewriter r(sigma,*this);
+    const bool do_not_rewrite_head=false;
+    make_application(result, m_rewrite_stack.element(t,2) , tapp.begin(), tapp.end(), r, do_not_rewrite_head); // Replacing r by a lambda term requires 16 more bytes on the stack. 
+    m_rewrite_stack.decrease(2);
+    return;
+  }
+  assert(is_abstraction(m_rewrite_stack.top()));
+  const abstraction& ta=atermpp::down_cast<abstraction>(m_rewrite_stack.element(t,2) );
+  const binder_type& binder(ta.binding_operator());
+  if (is_lambda_binder(binder))
+  {
+    rewrite_lambda_application(result,ta,tapp,sigma);
+    m_rewrite_stack.decrease(2);
+    return;
+  }
+  if (is_exists_binder(binder))
+  {
+    assert(terma.size()==1);
+    existential_quantifier_enumeration(result,ta,sigma);
+    m_rewrite_stack.decrease(2);
+    return;
+  }
+  assert(is_forall_binder(binder));
+  assert(terma.size()==1);
+  universal_quantifier_enumeration(result,ta,sigma);
+  m_rewrite_stack.decrease(2);
+  return;
 }
 
 // The last argument prevents the recursively first indicated number of arguments not to be rewritten. If 0 they are all rewritten. 
@@ -646,6 +663,7 @@ void RewriterJitty::rewrite_aux_function_symbol(
           application rewriteable_term(op, m_rewrite_stack.stack_iterator(0,arity+1),
                                            m_rewrite_stack.stack_iterator(arity,arity+1)); /* TODO Optimize */
           rule.rewrite_cpp_code()(result, rewriteable_term);
+          increment_rewrite_step_count();
           m_rewrite_stack.decrease(arity+1);
           return;
         }
@@ -667,6 +685,7 @@ void RewriterJitty::rewrite_aux_function_symbol(
                                            rule.rewrite_cpp_code(),  
                                            m_rewrite_stack.stack_iterator(0,arity+1),
                                            m_rewrite_stack.stack_iterator(arity,arity+1), sigma);
+          increment_rewrite_step_count();
           m_rewrite_stack.decrease(arity+1); 
           return;
         }
@@ -713,6 +732,7 @@ void RewriterJitty::rewrite_aux_function_symbol(
           }
           if (condition_of_this_rule)
           {
+            increment_rewrite_step_count();
             const data_expression& rhs=rule1.rhs();
 
             if (arity == rule_arity)
@@ -840,6 +860,7 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
     else if (rule.is_cpp_code())
     {
       rule.rewrite_cpp_code()(result, op);
+      increment_rewrite_step_count();
       rhs_for_constants_cache[op_value]=result;
       return;
     }
@@ -856,6 +877,7 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
 
       if (rule1.condition()==sort_bool::true_())
       { 
+        increment_rewrite_step_count();
         rewrite_aux(result,rule1.rhs(),sigma);
         rhs_for_constants_cache[op_value]=result;
         return;
@@ -863,6 +885,7 @@ void RewriterJitty::rewrite_aux_const_function_symbol(
       rewrite_aux(result,rule1.condition(),sigma);
       if (result==sort_bool::true_())
       {
+        increment_rewrite_step_count();
         rewrite_aux(result,rule1.rhs(),sigma);
         rhs_for_constants_cache[op_value]=result;
         return;
@@ -18,12 +18,17 @@
 #include <sys/stat.h>
 
 #include "mcrl2/atermpp/algorithm.h"
+#include "mcrl2/atermpp/aterm_io.h"
 #include "mcrl2/atermpp/detail/aterm_list_implementation.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
+#include "mcrl2/data/detail/io.h"
 #include "mcrl2/data/replace.h"
 #include "mcrl2/utilities/basename.h"
 #include "mcrl2/utilities/stopwatch.h"
+#include <cctype>
+#include <filesystem>
+#include <iomanip>
 #include <memory>
 
 #ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
@@ -990,15 +995,16 @@ class rewr_function_spec
       return m_fs == other.m_fs && m_arity == other.m_arity && m_delayed==other.m_delayed;
     }
 
-    std::string name() const
+    // The name refers to the number of the function symbol in the cache, and not to its index,
+    // as the index depends on the process.
+    std::string name(normal_form_cache& cache) const
     {
       std::stringstream name;
       if (m_delayed)
       {
         name << "delayed_";
       }
-      name << "rewr_" << atermpp::detail::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(m_fs)
-           << "_" << m_arity;
+      name << "rewr_" << cache.function_symbol_number(m_fs) << "_" << m_arity;
       return name.str();
     }
 };
@@ -1081,7 +1087,7 @@ class RewriterCompilingJitty::ImplementTree
     {
       m_rewr_functions.push(spec);
     }
-    return spec.name();
+    return spec.name(*m_rewriter.m_nf_cache);
   }
 
   inline
@@ -1093,7 +1099,7 @@ class RewriterCompilingJitty::ImplementTree
       m_rewr_functions.push(spec);
     }
     rewr_function_name(f,arity); // Also declare the non delayed function.
-    return spec.name();
+    return spec.name(*m_rewriter.m_nf_cache);
   }
 
   /*
@@ -1178,13 +1184,13 @@ class RewriterCompilingJitty::ImplementTree
       {
         if (target_for_output.empty())
         {
-          s << "static_cast<const data_expression&>(this_rewriter->bound_variable_get(" << m_rewriter.bound_variable_index(v) << "))";
+          s << m_rewriter.m_nf_cache->insert(v);
         }
         else
         {
           // TODO: Investigate whether it is possible to use an unprotected assign.
           s << m_padding << target_for_output << ".assign(" 
-            << "static_cast<const data_expression&>(this_rewriter->bound_variable_get(" << m_rewriter.bound_variable_index(v) << ")), " 
+            << m_rewriter.m_nf_cache->insert(v) << ", "
             << " *this_rewriter->m_thread_aterm_pool);\n";
         }
         result_type << "data_expression";
@@ -1231,7 +1237,7 @@ class RewriterCompilingJitty::ImplementTree
       calc_inner_term(s, bodyvar, a.body(), startarg, true, local_result_type, type_of_code_variables);
       assert(local_result_type.str()=="data_expression");
       s << m_padding << "this_rewriter->" << rewriter_function << "(" << target_for_output << 
-           ", this_rewriter->binding_variable_list_get(" << m_rewriter.binding_variable_list_index(a.variables()) << "), ";
+           ", " << m_rewriter.m_nf_cache->insert_variable_list(a.variables()) << ", ";
       s << bodyvar << ", sigma(this_rewriter), true);\n";
       result_type << "data_expression";
     }
@@ -1244,7 +1250,7 @@ class RewriterCompilingJitty::ImplementTree
       s << argument_string.str();
 
       s << m_padding << "delayed_abstraction<" << argument_type.str() << "> " << target_for_output << "(" << binder_constructor << "(), "
-           "this_rewriter->binding_variable_list_get(" << m_rewriter.binding_variable_list_index(a.variables()) << "), ";
+           << m_rewriter.m_nf_cache->insert_variable_list(a.variables()) << ", ";
       s << bodyvar << ", this_rewriter);";
       result_type << "delayed_abstraction<" << argument_type.str() << ">";
     }
@@ -1905,7 +1911,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = m_rewriter.m_nf_cache->insert_address(tree.function());
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -1986,7 +1992,7 @@ class RewriterCompilingJitty::ImplementTree
              std::map<variable,std::string>& type_of_code_variables)
   {
     bool reset_current_data_parameters=false;
-    const void* number = (void*)(atermpp::detail::address(tree.number()));
+    const std::string number = m_rewriter.m_nf_cache->insert_address(tree.number());
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2592,11 +2598,9 @@ public:
     }
     else
     {
-      std::stringstream ss;
-      ss << "this_rewriter->normal_forms_for_constants[" 
-         << atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(opid) 
-         << "]";
-      rewr_function_finish_term(m_stream, arity, ss.str(), down_cast<function_sort>(opid.sort()));
+      RewriterCompilingJitty::substitution_type sigma;
+      rewr_function_finish_term(m_stream, arity, m_rewriter.m_nf_cache->insert(m_rewriter.jitty_rewriter(opid,sigma)),
+          down_cast<function_sort>(opid.sort()));
     } 
   }
 
@@ -2643,7 +2647,7 @@ public:
     bracket_level_data brackets;
     std::stack<std::string> auxiliary_code_fragments;
 
-    std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(func);
+    const std::size_t index = m_rewriter.m_nf_cache->function_symbol_number(func);
     m_stream << m_padding << "// [" << index << "] " << func << ": " << func.sort() << "\n";
     rewr_function_signature(m_stream, index, arity, brackets);
     m_stream << m_padding << "{\n";
@@ -2691,7 +2695,7 @@ public:
 
   void generate_delayed_normal_form_generating_function(std::ostream& m_stream, const data::function_symbol& func, std::size_t arity)
   {
-    std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(func);
+    const std::size_t index = m_rewriter.m_nf_cache->function_symbol_number(func);
     m_stream << m_padding << "// [" << index << "] " << func << ": " << func.sort() << "\n";
     if (arity>0)
     {
@@ -2824,6 +2828,246 @@ static std::string generate_cpp_filename(std::size_t unique)
   return filename.str();
 }
 
+///
+/// \brief compiled_rewriter_cache_directory returns the directory in which compiled rewriters
+///        are cached. Caching is enabled by setting the environment variable MCRL2_COMPILECACHE
+///        to this directory.
+/// \return The cache directory ending with a slash, or the empty string if caching is disabled.
+///
+static std::string compiled_rewriter_cache_directory()
+{
+  const char* env_dir = std::getenv("MCRL2_COMPILECACHE");
+  if (env_dir == nullptr || *env_dir == '\0')
+  {
+    return std::string();
+  }
+
+  std::string filedir(env_dir);
+  if (*filedir.rbegin() != '/')
+  {
+    filedir.append("/");
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(filedir, error);
+  if (error)
+  {
+    mCRL2log(warning) << "Cannot use " << filedir << " to cache compiled rewriters: " << error.message() << std::endl;
+    return std::string();
+  }
+  return filedir;
+}
+
+/// \brief Reads the contents of a file, or returns the empty string if it cannot be read.
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return file ? contents.str() : std::string();
+}
+
+/// \brief Writes a file such that other processes either see the complete file or no file.
+static bool write_file_atomically(const std::string& filename, const std::string& contents)
+{
+  const std::string temporary_filename = filename + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream file(temporary_filename, std::ios::binary);
+    file << contents;
+    if (!file)
+    {
+      std::remove(temporary_filename.c_str());
+      return false;
+    }
+  }
+  return std::rename(temporary_filename.c_str(), filename.c_str()) == 0;
+}
+
+///
+/// \brief compiled_rewriter_cache_key describes everything that determines the compiled rewriter.
+/// \details This is the toolset version, the compile script, whose contents contain the compiler
+///          flags, the compiler that the script uses, and the rewrite system: the rewrite rules,
+///          the function symbols for which rewrite functions are generated and the arity bound.
+///          The terms are described by their text without the indices of function symbols, as the
+///          generated code does not depend on the addresses or the indices of terms. So a compiled rewriter can be reused by any tool
+///          that uses the same rewrite system.
+///
+static std::string compiled_rewriter_cache_key(const std::string& compile_script,
+    const std::set<data_equation>& rewrite_rules,
+    const function_symbol_vector& function_symbols,
+    const std::size_t arity_bound)
+{
+  // The text of the terms is sorted, as the order of the rules depends on their addresses.
+  std::vector<std::string> rewrite_system;
+  for (const data_equation& rule: rewrite_rules)
+  {
+    std::ostringstream text;
+    atermpp::write_term_to_text_stream(data::detail::remove_index(rule), text);
+    rewrite_system.push_back(text.str());
+  }
+  for (const function_symbol& f: function_symbols)
+  {
+    std::ostringstream text;
+    atermpp::write_term_to_text_stream(data::detail::remove_index(f), text);
+    rewrite_system.push_back(text.str());
+  }
+  std::sort(rewrite_system.begin(), rewrite_system.end());
+
+  const char* env_cxx = std::getenv("CXX");
+  std::ostringstream key;
+  key << mcrl2::utilities::get_toolset_version() << "\n"
+      << compile_script << "\n"
+      << read_file(compile_script) << "\n"
+      << (env_cxx == nullptr ? "" : env_cxx) << "\n"
+      << arity_bound << "\n";
+  for (const std::string& text: rewrite_system)
+  {
+    key << text << "\n";
+  }
+  return key.str();
+}
+
+///
+/// \brief compiled_rewriter_cache_name yields the name of a cache entry without extension. The
+///        name is derived from a hash of the key that is stable between runs, as std::hash
+///        does not guarantee this.
+///
+static std::string compiled_rewriter_cache_name(const std::string& cache_directory, const std::string& key)
+{
+  // The 64-bit FNV-1a hash.
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (const char c: key)
+  {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+
+  std::ostringstream name;
+  name << cache_directory << "jittyc_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return name.str();
+}
+
+/// \brief The maximal number of compiled rewriters that are kept in the cache directory.
+static constexpr std::size_t compiled_rewriter_cache_capacity = 32;
+
+///
+/// \brief evict_compiled_rewriters removes the least recently used entries from the cache
+///        directory until it contains at most compiled_rewriter_cache_capacity entries.
+/// \details An entry is used when its key is written or matched, which updates the time at which
+///          the key was last modified. The key is removed first, such that an entry of which only
+///          the library remains is not used.
+///
+static void evict_compiled_rewriters(const std::string& cache_directory)
+{
+  std::error_code error;
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+  for (const std::filesystem::directory_entry& file: std::filesystem::directory_iterator(cache_directory, error))
+  {
+    const std::filesystem::path& path = file.path();
+    if (path.extension() == ".key" && path.stem().string().starts_with("jittyc_"))
+    {
+      std::error_code time_error;
+      const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, time_error);
+      if (!time_error)
+      {
+        entries.emplace_back(time, path);
+      }
+    }
+  }
+
+  if (entries.size() <= compiled_rewriter_cache_capacity)
+  {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(), std::greater<>());
+  for (std::size_t i = compiled_rewriter_cache_capacity; i < entries.size(); ++i)
+  {
+    std::filesystem::path path = entries[i].second;
+    std::filesystem::remove(path, error);
+    std::filesystem::remove(path.replace_extension(".so"), error);
+    mCRL2log(debug) << "removed compiled rewriter " << path.string() << " from the cache." << std::endl;
+  }
+}
+
+/// \brief Compiles the code to the library, using cpp_file as source file.
+static void compile_rewriter(uncompiled_library& library, const std::string& code, const std::string& cpp_file, stopwatch& time)
+{
+  {
+    std::ofstream cpp_stream(cpp_file);
+    cpp_stream << code;
+  }
+
+  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
+  time.reset();
+
+  try
+  {
+    library.compile(cpp_file);
+  }
+  catch(std::runtime_error& e)
+  {
+    library.leave_files();
+    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+  }
+
+  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+}
+
+/// \brief Stores the compiled library in the cache entry with the given name and key, if the name is not empty.
+static void store_compiled_rewriter(const uncompiled_library& library,
+    const std::string& cache_directory,
+    const std::string& cache_name,
+    const std::string& cache_key)
+{
+  if (cache_name.empty())
+  {
+    return;
+  }
+
+  // The library is stored before its key, such that an entry with a key is complete.
+  if (write_file_atomically(cache_name + ".so", read_file(library.filename()))
+      && write_file_atomically(cache_name + ".key", cache_key))
+  {
+    mCRL2log(verbose) << "stored compiled rewriter as " << cache_name << ".so" << std::endl;
+    evict_compiled_rewriters(cache_directory);
+  }
+  else
+  {
+    mCRL2log(warning) << "Could not store the compiled rewriter in " << cache_directory << "." << std::endl;
+  }
+}
+
+/// \brief Yields a C++ string literal with the given contents, split over several lines.
+static std::string string_literal(const std::string& contents)
+{
+  std::ostringstream literal;
+  literal << "\"";
+  std::size_t line_length = 0;
+  for (const char c: contents)
+  {
+    if (line_length >= 120)
+    {
+      literal << "\"\n\"";
+      line_length = 0;
+    }
+    if (c == '"' || c == '\\')
+    {
+      literal << '\\' << c;
+    }
+    else if (std::isprint(static_cast<unsigned char>(c)) != 0)
+    {
+      literal << c;
+    }
+    else
+    {
+      literal << '\\' << std::oct << std::setw(3) << std::setfill('0') << static_cast<unsigned int>(static_cast<unsigned char>(c)) << std::dec;
+    }
+    ++line_length;
+  }
+  literal << "\"";
+  return literal.str();
+}
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2843,9 +3087,11 @@ void filter_function_symbols(const function_symbol_vector& source, function_symb
   }
 }
 
-void RewriterCompilingJitty::generate_code(const std::string& filename)
+void RewriterCompilingJitty::generate_code(std::ostream& output)
 {
-  std::ofstream cpp_file(filename);
+  // The code is first generated in cpp_file, as the arrays with the cached terms that it uses can only be
+  // declared when all code has been generated.
+  std::stringstream cpp_file;
   std::stringstream rewr_code;
   // arity_bound is one larger than the maximal arity. 
   arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
@@ -2868,9 +3114,10 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
   functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
 
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
-  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+  // The index bound is not written to the generated code, as it depends on the number of function symbols
+  // that exist in this process, and would prevent reuse of a cached compiled rewriter.
+  output << "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
+  output << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
 
   cpp_file << "namespace {\n"
                "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
@@ -2917,18 +3164,17 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
 
   cpp_file << rewr_code.str();
 
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_not_in_normal_form == (void *)" << &functions_when_arguments_are_not_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  assert(&this_rewriter->functions_when_arguments_are_in_normal_form == (void *)" << &functions_when_arguments_are_in_normal_form << ");  // Check that this table matches the one rewriter is actually using.\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
-  cpp_file << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_in_normal_form)\n"
-           << "  {\n"
-           << "    f = nullptr;\n"
-           << "  }\n";
+  // The tables of rewrite functions are only filled after the cached terms have been loaded, as the
+  // entries of the tables are determined by the indices of the function symbols in the loading process.
+  std::stringstream table_code;
+  table_code << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_not_in_normal_form)\n"
+             << "  {\n"
+             << "    f = nullptr;\n"
+             << "  }\n";
+  table_code << "  for(rewriter_function& f: this_rewriter->functions_when_arguments_are_in_normal_form)\n"
+             << "  {\n"
+             << "    f = nullptr;\n"
+             << "  }\n";
 
   // Fill tables with the rewrite functions
   RewriterCompilingJitty::substitution_type sigma;
@@ -2940,14 +3186,14 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
       std::size_t index = atermpp::detail::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(f.fs());
       if (f.arity()>0)
       {
-        cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term;\n";
-        cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-                 << index
-                 << " + " << f.arity() << "] = rewr_functions::"
-                 << f.name() << "_term_arg_in_normal_form;\n";
+        table_code << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
+                   << m_nf_cache->insert_index(f.fs())
+                   << " + " << f.arity() << "] = rewr_functions::"
+                   << f.name(*m_nf_cache) << "_term;\n";
+        table_code << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
+                   << m_nf_cache->insert_index(f.fs())
+                   << " + " << f.arity() << "] = rewr_functions::"
+                   << f.name(*m_nf_cache) << "_term_arg_in_normal_form;\n";
       }
       else
       { 
@@ -2960,9 +3206,57 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
     }
   }
 
-
-  cpp_file << "}\n";
-  cpp_file.close();
+  // The cached terms are read from their text when the rewriter is loaded, after which their addresses
+  // and the indices of the function symbols are looked up once. The rewriter that loads the code must
+  // have tables that are large enough for these indices.
+  const std::size_t number_of_cached_terms = m_nf_cache->size();
+  const std::size_t number_of_function_symbols = m_nf_cache->function_symbols().size();
+  cpp_file << "bool set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
+              "{\n"
+           << "  if (this_rewriter->arity_bound != " << arity_bound << " || !this_rewriter->load_cached_terms(cached_terms_text))\n"
+           << "  {\n"
+           << "    return false;\n"
+           << "  }\n"
+           << "  for (std::size_t i = 0; i < " << number_of_cached_terms << "; ++i)\n"
+           << "  {\n"
+           << "    cached_terms[i] = &this_rewriter->cached_term(i);\n"
+           << "    cached_addresses[i] = uint_address(*cached_terms[i]);\n"
+           << "  }\n"
+           << "  for (std::size_t i = 0; i < " << number_of_function_symbols << "; ++i)\n"
+           << "  {\n"
+           << "    function_indices[i] = get_index(atermpp::down_cast<function_symbol>(*cached_terms[cached_function_symbols[i]]));\n"
+           << "    if (function_indices[i] >= this_rewriter->index_bound)\n"
+           << "    {\n"
+           << "      return false;\n"
+           << "    }\n"
+           << "  }\n"
+           << table_code.str()
+           << "  return true;\n"
+           << "}\n";
+
+  std::ostringstream cached_terms_text;
+  atermpp::aterm_list cached_terms;
+  for (std::size_t i = m_nf_cache->size(); i > 0; --i)
+  {
+    cached_terms.push_front(m_nf_cache->get(i - 1));
+  }
+  atermpp::write_term_to_text_stream(data::detail::remove_index(cached_terms), cached_terms_text);
+
+  output << "namespace {\n"
+            "// The terms in the normal form cache of the rewriter that the code refers to, and their text.\n"
+            "const atermpp::aterm* cached_terms[" << std::max<std::size_t>(number_of_cached_terms, 1) << "];\n"
+            "uintptr_t cached_addresses[" << std::max<std::size_t>(number_of_cached_terms, 1) << "];\n"
+            "const char cached_terms_text[] =\n" << string_literal(cached_terms_text.str()) << ";\n"
+            "// The indices of the function symbols that the code refers to, and their positions in cached_terms.\n"
+            "std::size_t function_indices[" << std::max<std::size_t>(number_of_function_symbols, 1) << "];\n"
+            "const std::size_t cached_function_symbols[" << std::max<std::size_t>(number_of_function_symbols, 1) << "] = {";
+  for (std::size_t i = 0; i < number_of_function_symbols; ++i)
+  {
+    output << (i == 0 ? "" : ", ") << m_nf_cache->function_symbols()[i];
+  }
+  output << "};\n"
+            "} // namespace\n";
+  output << cpp_file.str();
 }
 
 void RewriterCompilingJitty::BuildRewriteSystem()
@@ -3004,26 +3298,73 @@ void RewriterCompilingJitty::BuildRewriteSystem()
     jittyc_eqns[down_cast<function_symbol>(get_nested_head(rewrite_rule.lhs()))].push_front(rewrite_rule);
   }
 
-  std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
+  // The code is always generated, as this also fills the tables of this rewriter. The code reads
+  // the terms that it refers to from their text when it is loaded, so a cached library that was
+  // compiled for the same rewrite system by another process can be used.
+  std::stringstream code;
+  generate_code(code);
 
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
+  const std::string cache_directory = compiled_rewriter_cache_directory();
+  std::string cache_key;
+  std::string cache_name;
+  if (!cache_directory.empty())
+  {
+    function_symbol_vector function_symbols;
+    filter_function_symbols(m_data_specification_for_enumeration.constructors(), function_symbols, data_equation_selector);
+    filter_function_symbols(m_data_specification_for_enumeration.mappings(), function_symbols, data_equation_selector);
+    cache_key = compiled_rewriter_cache_key(compile_script, rewrite_rules, function_symbols, arity_bound);
+    cache_name = compiled_rewriter_cache_name(cache_directory, cache_key);
+  }
 
-  try
+  // The key is stored next to the library, and compared to rule out hash collisions. The generated
+  // code stores the cached terms of this rewriter in static variables, so a private copy of the
+  // cached library is loaded.
+  std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
+  bool cached = !cache_name.empty()
+      && read_file(cache_name + ".key") == cache_key
+      && rewriter_so->use_compiled(cache_name + ".so", std::filesystem::path(cpp_file).replace_extension(".so").string());
+  if (cached)
   {
-    rewriter_so->compile(cpp_file);
+    mCRL2log(verbose) << "generated rewriter in " << time.time() << "ms, loading cached rewriter " << cache_name << ".so..." << std::endl;
+    std::error_code error;
+    std::filesystem::last_write_time(cache_name + ".key", std::filesystem::file_time_type::clock::now(), error);
   }
-  catch(std::runtime_error& e)
+  else
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    compile_rewriter(*rewriter_so, code.str(), cpp_file, time);
+    store_compiled_rewriter(*rewriter_so, cache_directory, cache_name, cache_key);
   }
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+  rewriter_interface interface;
+  bool loaded = load_rewriter(interface);
+  if (!loaded && cached)
+  {
+    // The cached library does not fit this rewriter, for instance because another process has
+    // replaced the entry while it was copied. It is replaced by a newly compiled library.
+    mCRL2log(warning) << "Could not load the cached rewriter " << cache_name << ".so: " << interface.status
+                      << " Compiling it instead." << std::endl;
+    rewriter_so = std::make_shared<uncompiled_library>(compile_script);
+    time.reset();
+    compile_rewriter(*rewriter_so, code.str(), cpp_file, time);
+    store_compiled_rewriter(*rewriter_so, cache_directory, cache_name, cache_key);
+    loaded = load_rewriter(interface);
+  }
+  if (!loaded)
+  {
+#ifndef MCRL2_DISABLE_JITTYC_VERSION_CHECK
+    throw mcrl2::runtime_error(std::string("Could not load rewriter: ") + interface.status);
+#endif
+  }
+  so_rewr_cleanup = interface.rewrite_cleanup;
+  so_rewr = interface.rewrite_external;
 
+  mCRL2log(verbose) << interface.status << std::endl;
+}
+
+bool RewriterCompilingJitty::load_rewriter(rewriter_interface& interface)
+{
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
-  rewriter_interface interface = {.caller_toolset_version = mcrl2::utilities::get_toolset_version(),
+  interface = {.caller_toolset_version = mcrl2::utilities::get_toolset_version(),
       .status = "Unknown error when loading rewriter.",
       .rewriter = this,
       .rewrite_external = nullptr,
@@ -3055,16 +3396,21 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   }
 #endif
 
-  if (!init(&interface,this))
+  return init(&interface,this);
+}
+
+bool RewriterCompilingJitty::load_cached_terms(const char* text)
+{
+  try
   {
-#ifndef MCRL2_DISABLE_JITTYC_VERSION_CHECK
-    throw mcrl2::runtime_error(std::string("Could not load rewriter: ") + interface.status);
-#endif
+    m_nf_cache->assign(atermpp::down_cast<atermpp::aterm_list>(data::detail::add_index(atermpp::read_term_from_string(text))));
   }
-  so_rewr_cleanup = interface.rewrite_cleanup;
-  so_rewr = interface.rewrite_external;
-
-  mCRL2log(verbose) << interface.status << std::endl;
+  catch (std::runtime_error& e)
+  {
+    mCRL2log(debug) << "Could not read the terms of the compiled rewriter: " << e.what() << std::endl;
+    return false;
+  }
+  return true;
 }
 
 RewriterCompilingJitty::RewriterCompilingJitty(
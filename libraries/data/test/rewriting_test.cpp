@@ -16,11 +16,15 @@
 
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
+#include "mcrl2/data/detail/rewrite/jitty_normal_form_cache.h"
 #include "mcrl2/data/parse.h"
 #include "mcrl2/data/rewriter.h"
 
 #include <boost/test/included/unit_test.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 using namespace mcrl2;
 using namespace mcrl2::core;
 using namespace mcrl2::data;
@@ -1657,3 +1661,107 @@ BOOST_AUTO_TEST_CASE(compile_complex_application)   // Compilation of a term: h(
     data_rewrite_test(R, e, f);
   } 
 }
+
+// Check that the jitty rewriter gives the same results with a normal form cache, also when the cache is small, such
+// that entries are overwritten, and when garbage is collected in between.
+BOOST_AUTO_TEST_CASE(jitty_normal_form_cache_test)
+{
+  data_specification specification = parse_data_specification(
+    "map fib: Nat -> Nat;\n"
+    "    f: Nat -> List(Nat);\n"
+    "var n: Nat;\n"
+    "eqn fib(n) = if(n < 2, n, fib(Int2Nat(n - 2)) + fib(Int2Nat(n - 1)));\n"
+    "    f(n) = [n, fib(n), n + fib(n)];\n");
+  const std::vector<std::string> expressions = {
+    "fib(15)", "fib(15) + fib(14)", "f(12)", "f(fib(5)) ++ f(11)", "#f(fib(7)) < fib(4)", "n + fib(6)",
+    "if(n < 2, fib(7), n)", "exists m: Nat. m < 3 && m + fib(5) == 6", "forall m: Nat. m < 2 => m + fib(4) > 2",
+    "(lambda m: Nat. [m, m + fib(3)])(fib(9))", "n + m whr n = fib(8), m = fib(9) end"
+  };
+  const variable_list variables = parse_variables("n: Nat;");
+
+  data::rewriter R(specification, jitty);
+  for (std::size_t size: {1, 7, 1000})
+  {
+    data::detail::set_jitty_normal_form_cache_size(size);
+    data::rewriter R_cache(specification, jitty);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      for (const std::string& expression: expressions)
+      {
+        data_expression e = parse_data_expression(expression, variables, specification);
+        data_rewrite_test(R_cache, e, R(e));
+      }
+      atermpp::detail::g_thread_term_pool().collect();
+    }
+  }
+  data::detail::set_jitty_normal_form_cache_size(0);
+}
+
+#ifdef MCRL2_ENABLE_JITTYC
+// Check that compiled rewriters are stored in the directory given by MCRL2_COMPILECACHE,
+// and that the second rewriter for the same rewrite system is loaded from this cache without
+// invoking the compiler. The compile script is wrapped by a script that counts its invocations.
+// The second rewriter is created while the first one exists, and is used after the first
+// one has been destroyed.
+BOOST_AUTO_TEST_CASE(compiled_rewriter_cache_test)
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("mcrl2_jittyc_cache_" + std::to_string(getpid()));
+  const std::filesystem::path cache_directory = directory / "cache";
+  const std::filesystem::path compilations = directory / "compilations";
+  const std::filesystem::path compile_script = directory / "compilerewriter";
+  std::filesystem::create_directories(directory);
+
+  const char* env_compile_script = std::getenv("MCRL2_COMPILEREWRITER");
+  const std::string original_compile_script = env_compile_script == nullptr ? "" : env_compile_script;
+  {
+    std::ofstream script(compile_script);
+    script << "#!/bin/sh\n"
+           << "echo >> \"" << compilations.string() << "\"\n"
+           << "exec \"" << (original_compile_script.empty() ? "mcrl2compilerewriter" : original_compile_script) << "\" \"$@\"\n";
+  }
+  std::filesystem::permissions(compile_script, std::filesystem::perms::owner_all);
+  setenv("MCRL2_COMPILEREWRITER", compile_script.c_str(), 1);
+  setenv("MCRL2_COMPILECACHE", cache_directory.c_str(), 1);
+
+  const auto number_of_compilations = [&]()
+  {
+    std::ifstream file(compilations);
+    return std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+  };
+
+  data_specification specification;
+  specification.add_context_sort(sort_nat::nat());
+  const data_expression e = sort_nat::plus(sort_nat::nat(2), sort_nat::nat(3));
+
+  auto R1 = std::make_unique<data::rewriter>(specification, jitty_compiling);
+  BOOST_CHECK_EQUAL(number_of_compilations(), 1);
+  data::rewriter R2(specification, jitty_compiling);
+  BOOST_CHECK_EQUAL(number_of_compilations(), 1);
+  data_rewrite_test(*R1, e, sort_nat::nat(5));
+  data_rewrite_test(R2, e, sort_nat::nat(5));
+  R1.reset();
+  data_rewrite_test(R2, e, sort_nat::nat(5));
+
+  std::size_t number_of_cached_libraries = 0;
+  for (const std::filesystem::directory_entry& entry: std::filesystem::directory_iterator(cache_directory))
+  {
+    if (entry.path().extension() == ".so")
+    {
+      ++number_of_cached_libraries;
+      BOOST_CHECK(std::filesystem::exists(std::filesystem::path(entry.path()).replace_extension(".key")));
+    }
+  }
+  BOOST_CHECK_EQUAL(number_of_cached_libraries, 1);
+
+  unsetenv("MCRL2_COMPILECACHE");
+  if (original_compile_script.empty())
+  {
+    unsetenv("MCRL2_COMPILEREWRITER");
+  }
+  else
+  {
+    setenv("MCRL2_COMPILEREWRITER", original_compile_script.c_str(), 1);
+  }
+  std::filesystem::remove_all(directory);
+}
+#endif // MCRL2_ENABLE_JITTYC
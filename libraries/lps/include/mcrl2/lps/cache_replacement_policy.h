@@ -0,0 +1,97 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/cache_replacement_policy.h
+/// \brief The policies that determine which element is removed from a full enumeration cache.
+
+#ifndef MCRL2_LPS_CACHE_REPLACEMENT_POLICY_H
+#define MCRL2_LPS_CACHE_REPLACEMENT_POLICY_H
+
+#include <string>
+#include "mcrl2/utilities/exception.h"
+
+namespace mcrl2::lps
+{
+
+enum class cache_replacement_policy { lru, clock, frequency };
+
+inline
+cache_replacement_policy parse_cache_replacement_policy(const std::string& s)
+{
+  if (s == "lru")
+  {
+    return cache_replacement_policy::lru;
+  }
+  if (s == "clock")
+  {
+    return cache_replacement_policy::clock;
+  }
+  if (s == "frequency")
+  {
+    return cache_replacement_policy::frequency;
+  }
+  throw mcrl2::runtime_error("unknown cache replacement policy " + s);
+}
+
+inline
+std::string print_cache_replacement_policy(const cache_replacement_policy policy)
+{
+  switch (policy)
+  {
+    case cache_replacement_policy::lru:
+      return "lru";
+    case cache_replacement_policy::clock:
+      return "clock";
+    case cache_replacement_policy::frequency:
+      return "frequency";
+    default:
+      throw mcrl2::runtime_error("unknown cache replacement policy");
+  }
+}
+
+inline
+std::istream& operator>>(std::istream& is, cache_replacement_policy& policy)
+{
+  try
+  {
+    std::string s;
+    is >> s;
+    policy = parse_cache_replacement_policy(s);
+  }
+  catch (mcrl2::runtime_error&)
+  {
+    is.setstate(std::ios_base::failbit);
+  }
+  return is;
+}
+
+inline
+std::ostream& operator<<(std::ostream& os, const cache_replacement_policy policy)
+{
+  os << print_cache_replacement_policy(policy);
+  return os;
+}
+
+inline std::string description(const cache_replacement_policy policy)
+{
+  switch (policy)
+  {
+    case cache_replacement_policy::lru:
+      return "remove the least recently used entry";
+    case cache_replacement_policy::clock:
+      return "remove an entry that was not used recently, using the CLOCK algorithm; this approximates lru at a lower cost";
+    case cache_replacement_policy::frequency:
+      return "remove an entry that was not used frequently, using the generalised CLOCK algorithm";
+    default:
+      throw mcrl2::runtime_error("unknown cache replacement policy");
+  }
+}
+
+} // namespace mcrl2::lps
+
+#endif // MCRL2_LPS_CACHE_REPLACEMENT_POLICY_H
@@ -413,6 +413,9 @@ class confluence_checker
     // cache for the value of is_confluent for pairs (i, j) with i <= j, and i and j both tau-summands
     mutable std::map<std::pair<std::size_t, std::size_t>, bool> m_cache;
 
+    // the maximal number of confluence conditions that is checked by the smt solver at once
+    static constexpr std::size_t smt_batch_size = 16;
+
     enum cache_result
     {
       yes, no, indeterminate
@@ -443,34 +446,42 @@ class confluence_checker
       return data::is_true(x);
     }
 
-    // check if x is a tautology using an smt solver
-    bool is_true_smt(const data::data_expression& x) const
+    // check for each element of x if it is a tautology using an smt solver; all queries are sent to the solver at once
+    std::vector<bool> is_true_smt(const std::vector<data::data_expression>& x) const
     {
-      if (data::is_forall(x))
+      std::vector<bool> result(x.size());
+      std::vector<std::pair<data::variable_list, data::data_expression>> queries;
+      std::vector<std::size_t> query_index;
+      for (std::size_t i = 0; i < x.size(); i++)
       {
-        const auto& x_ = atermpp::down_cast<data::forall>(x);
-        bool result = true;
-        switch (m_solver->solve(x_.variables(), data::sort_bool::not_(x_.body())))
+        if (data::is_forall(x[i]))
+        {
+          const auto& x_ = atermpp::down_cast<data::forall>(x[i]);
+          queries.emplace_back(x_.variables(), data::sort_bool::not_(x_.body()));
+          query_index.push_back(i);
+        }
+        else
         {
-          case smt::answer::SAT: result = true; break;
-          case smt::answer::UNSAT: result = false; break;
-            // since the formula is negated, we over-approximate unknown results
-            // the result of this function will then be an under-approximation
-          case smt::answer::UNKNOWN: result = true; break;
+          // x has no free variables, so just evaluate the expression
+          result[i] = data::is_true(m_rewr(x[i]));
         }
-        return !result;
       }
-      else
+      std::vector<smt::answer> answers = m_solver->solve(queries);
+      for (std::size_t k = 0; k < answers.size(); k++)
       {
-        // x has no free variables, so just evaluate the expression
-        return data::is_true(m_rewr(x));
+        // since the formula is negated, we over-approximate unknown results
+        // the result of this function will then be an under-approximation
+        result[query_index[k]] = answers[k] == smt::answer::UNSAT;
       }
+      return result;
     }
 
-    // check if x evaluates true
-    bool is_true(const data::data_expression& x) const
+    // Returns whether the confluence condition for the summands i and j must be computed, i.e. it is not in the cache
+    // and it is not implied by disjointness.
+    bool needs_check(std::size_t i, std::size_t j, bool check_disjointness) const
     {
-      return m_solver ? is_true_smt(x) : is_true_rewriter(x);
+      return !(m_summands[j].is_tau() && cache_lookup(i, j) != indeterminate) &&
+             !(check_disjointness && disjoint(m_summands[i], m_summands[j]));
     }
 
     // Returns whether the tau summand with index j is confluent. If not, the second value returned is
@@ -479,6 +490,13 @@ class confluence_checker
     std::pair<bool, std::size_t> is_confluent(std::size_t j, ConfluenceCondition confluence_condition, bool check_disjointness) const
     {
       const confluence_summand& summand_j = m_summands[j];
+
+      // With an smt solver the conditions for the next batch_size summands are checked at once, such that the
+      // solver answers them without a round trip per condition. As the check stops at the first summand that is
+      // not confluent, the batches start small and double up to smt_batch_size while all conditions hold.
+      std::map<std::size_t, bool> batch;
+      std::size_t batch_size = 1;
+
       for (std::size_t i = 0; i < m_summands.size(); i++)
       {
         const confluence_summand& summand_i =  m_summands[i];
@@ -505,8 +523,35 @@ class confluence_checker
           continue;
         }
 
-        data::data_expression condition = confluence_condition(summand_i, summand_j);
-        bool confluent = is_true(condition);
+        bool confluent;
+        if (m_solver)
+        {
+          if (batch.find(i) == batch.end())
+          {
+            std::vector<std::size_t> indices;
+            std::vector<data::data_expression> conditions;
+            for (std::size_t k = i; k < m_summands.size() && indices.size() < batch_size; k++)
+            {
+              if (k == i || needs_check(k, j, check_disjointness))
+              {
+                indices.push_back(k);
+                conditions.push_back(confluence_condition(m_summands[k], summand_j));
+              }
+            }
+            std::vector<bool> values = is_true_smt(conditions);
+            batch.clear();
+            for (std::size_t k = 0; k < indices.size(); k++)
+            {
+              batch[indices[k]] = values[k];
+            }
+            batch_size = std::min(2 * batch_size, smt_batch_size);
+          }
+          confluent = batch[i];
+        }
+        else
+        {
+          confluent = is_true_rewriter(confluence_condition(summand_i, summand_j));
+        }
         cache_store(i, j, confluent);
         if (confluent)
         {
@@ -0,0 +1,63 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/parallel_summand_generation.h
+/// \brief Generates summands with multiple threads, used by the communication and parallel operators of the linearizer.
+
+#ifndef MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_GENERATION_H
+#define MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_GENERATION_H
+
+#include <algorithm>
+#include <functional>
+#include "mcrl2/data/data_expression.h"
+#include "mcrl2/utilities/detail/parallel_ordered_for.h"
+
+namespace mcrl2::lps::detail
+{
+
+/// \brief A rewriter that is used by a single thread.
+using thread_rewriter = std::function<data::data_expression(const data::data_expression&)>;
+
+/// \brief A function that creates a rewriter for the calling thread.
+using thread_rewriter_factory = std::function<thread_rewriter()>;
+
+/// \brief Calls process(state, i, result) for every i in [0, n), and passes the results to append in the order of i.
+/// \details The range [0, n) is divided in chunks, and every chunk is stored in its own object of type Result,
+///          which is passed to append by the calling thread. Each thread creates its own state, typically
+///          containing a rewriter, using make_state. As the results are destroyed by the threads that created
+///          them, append must copy the results. The outcome is independent of the number of threads.
+template <typename Result, typename MakeState, typename Process, typename Append>
+void parallel_generate_summands(std::size_t n,
+                                std::size_t number_of_threads,
+                                MakeState make_state,
+                                Process process,
+                                Append append)
+{
+  // Small chunks give a better load balance, as the work per element may differ a lot.
+  const std::size_t chunk_size = number_of_threads <= 1 ? std::max<std::size_t>(1, n)
+                                                        : std::max<std::size_t>(1, n / (8 * number_of_threads));
+  const std::size_t number_of_chunks = (n + chunk_size - 1) / chunk_size;
+
+  utilities::detail::parallel_ordered_for<Result>(number_of_chunks, number_of_threads, number_of_chunks, make_state,
+    [&](auto& state, std::size_t chunk, Result& result)
+    {
+      const std::size_t last = std::min(n, (chunk + 1) * chunk_size);
+      for (std::size_t i = chunk * chunk_size; i < last; ++i)
+      {
+        process(state, i, result);
+      }
+    },
+    [&](std::size_t, Result& result)
+    {
+      append(result);
+    });
+}
+
+} // namespace mcrl2::lps::detail
+
+#endif // MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_GENERATION_H
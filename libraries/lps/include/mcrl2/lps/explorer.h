@@ -54,7 +54,7 @@ class explorer: public abortable
     static constexpr bool is_stochastic = Stochastic;
     static constexpr bool is_timed = Timed;
 
-    using indexed_set_for_states_type = atermpp::indexed_set<state, mcrl2::utilities::detail::GlobalThreadSafe>;
+    using indexed_set_for_states_type = atermpp::concurrent_indexed_set<state>;
 
     struct transition
     {
@@ -94,7 +94,7 @@ class explorer: public abortable
     volatile std::atomic<bool> m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    summand_cache_map global_cache;
+    summand_cache global_cache;
 
     indexed_set_for_states_type m_discovered;
 
@@ -585,15 +585,11 @@ class explorer: public abortable
       }
       else
       {
-        summand_cache_map& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        utilities::shared_guard g = atermpp::detail::g_thread_term_pool().lock_shared();
+        summand_cache& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
 
-        auto q = cache.find(detail::cheap_cache_key(sigma, summand.gamma));
-        if (q == cache.end())
+        atermpp::term_list<data::data_expression_list> solutions;
+        if (!cache.find(detail::cheap_cache_key(sigma, summand.gamma), solutions))
         {
-          g.unlock_shared();
-
-          atermpp::term_list<data::data_expression_list> solutions;
           // Enumerate all satisfying valuations for this summand and store them in the cache.
           enumerate_solutions(
             summand, sigma, rewr, condition, enumerator,
@@ -603,14 +599,10 @@ class explorer: public abortable
             }
           );
           summand.compute_key(key, sigma);
-          q = cache.insert({key, solutions}).first;
-        }
-        else
-        {
-          g.unlock_shared();
+          cache.insert(key, solutions);
         }
 
-        for (const auto& e : static_cast<atermpp::term_list<data::data_expression_list>&>(q->second))
+        for (const auto& e : solutions)
         {
           process_transition(e.empty() ? nullptr : &e);
         }
@@ -782,6 +774,7 @@ class explorer: public abortable
         m_global_rewr(rewr),
         m_global_enumerator(m_global_rewr, lpsspec.data(), m_global_rewr, m_global_id_generator, false),
         m_global_lpsspec(preprocess(lpsspec)),
+        global_cache(m_options.global_cache ? m_options.cache_size : 0, m_options.cache_policy),
         m_discovered(m_options.number_of_threads)
     {
 #ifdef MCRL2_USE_CONTROL_FLOW
@@ -814,11 +807,11 @@ class explorer: public abortable
         caching cache_strategy = m_options.cached ? (m_options.global_cache ? lps::caching::global : lps::caching::local) : lps::caching::none;
         if (is_confluent_tau(summand.multi_action()))
         {
-          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_confluent_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy, m_options.cache_size, m_options.cache_policy);
         }
         else
         {
-          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy);
+          m_regular_summands.emplace_back(summand, i, m_global_lpsspec.process().process_parameters(), cache_strategy, m_options.cache_size, m_options.cache_policy);
         }
       }
 
@@ -1177,6 +1170,29 @@ class explorer: public abortable
       return m_discovered;
     }
 
+    /// \brief Prints the number of hits, misses and evictions of the enumeration caches.
+    /// \details For local caches the numbers are printed for each summand.
+    void report_cache_statistics() const
+    {
+      if (!m_options.cached || m_options.use_projections)
+      {
+        return;
+      }
+      if (m_options.global_cache)
+      {
+        mCRL2log(log::verbose) << "Global enumeration cache: " << global_cache << "." << std::endl;
+        return;
+      }
+
+      for (const std::vector<explorer_summand>* summands: { &m_regular_summands, &m_confluent_summands })
+      {
+        for (const explorer_summand& summand: *summands)
+        {
+          mCRL2log(log::verbose) << "Enumeration cache of summand " << summand.index << ": " << summand.local_cache << "." << std::endl;
+        }
+      }
+    }
+
     const std::vector<explorer_summand>& regular_summands() const
     {
       return m_regular_summands;
@@ -15,6 +15,7 @@
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/lps/multi_action.h"
+#include "mcrl2/lps/cache_replacement_policy.h"
 #include "mcrl2/lps/exploration_strategy.h"
 
 namespace mcrl2::lps
@@ -48,6 +49,8 @@ struct explorer_options
   bool rewrite_actions = true;    // If false, this option prevents rewriting actions.
                                   // Rewriting actions is only needed if they occur in the
                                   // generated lts, or in traces. 
+  std::size_t cache_size = 0;     // The maximum number of entries of an enumeration cache, 0 means unbounded.
+  cache_replacement_policy cache_policy = cache_replacement_policy::lru;
   std::size_t max_states = std::numeric_limits<std::size_t>::max();
   std::size_t max_traces = 0;
   std::size_t highway_todo_max = std::numeric_limits<std::size_t>::max();
@@ -78,6 +81,8 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "search-strategy = " << options.search_strategy << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "global-cache = " << std::boolalpha << options.global_cache << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
+  out << "cache-policy = " << options.cache_policy << std::endl;
   out << "confluence = " << std::boolalpha << options.confluence << std::endl;
   out << "confluence-action = " << options.confluence_action << std::endl;
   out << "use-projections = " << std::boolalpha << options.use_projections << std::endl;
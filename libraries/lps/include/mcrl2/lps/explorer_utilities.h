@@ -12,9 +12,15 @@
 #ifndef MCRL2_LPS_EXPLORER_UTILITIES_H
 #define MCRL2_LPS_EXPLORER_UTILITIES_H
 
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <variant>
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/atermpp/standard_containers/detail/unordered_map_implementation.h"
 #include "mcrl2/data/rewriter.h"
+#include "mcrl2/lps/cache_replacement_policy.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/lps/explorer_projections.h"
@@ -169,6 +175,228 @@ using summand_cache_map = atermpp::utilities::unordered_map<atermpp::aterm,
     std::allocator<std::pair<atermpp::aterm, atermpp::term_list<data::data_expression_list>>>,
     true>;
 
+/// \brief The map of a bounded summand cache, which is constructed from its maximum size.
+class bounded_summand_cache_map : public summand_cache_map
+{
+  public:
+    explicit bounded_summand_cache_map(std::size_t maximum_size)
+    {
+      reserve(maximum_size);
+    }
+};
+
+/// \brief A cache that maps the values of the free variables of the condition of a summand to the solutions
+///        of the condition. If a maximum size is given, the cache policy determines which entry is removed
+///        when the cache is full.
+/// \details The cache can be used by multiple threads. An unbounded cache is a summand_cache_map, which
+///          supports concurrent lookups and insertions. A bounded cache updates its policy on every lookup,
+///          so it is split into shards by the hash of the key, each with its own policy and mutex, such that
+///          threads that look up different keys rarely wait for each other. The solutions are copied out of
+///          the cache, such that an entry can safely be removed while another thread processes its solutions.
+class summand_cache
+{
+  public:
+    using solutions_type = atermpp::term_list<data::data_expression_list>;
+
+  protected:
+    template <template <typename> class Policy>
+    using cache_type = utilities::fixed_size_cache<Policy<bounded_summand_cache_map>>;
+
+    using bounded_cache_type = std::variant<cache_type<utilities::lru_policy>,
+                                            cache_type<utilities::clock_policy>,
+                                            cache_type<utilities::frequency_policy>>;
+
+    /// \brief A part of a bounded cache with its own mutex.
+    struct shard
+    {
+      bounded_cache_type cache;
+      mutable std::mutex mutex;
+
+      explicit shard(bounded_cache_type cache_)
+        : cache(std::move(cache_))
+      {}
+    };
+
+    /// \brief The maximum number of shards of a bounded cache, and the minimum number of entries per shard.
+    static constexpr std::size_t max_shards = 16;
+    static constexpr std::size_t min_shard_size = 256;
+
+    summand_cache_map m_map;                      // The entries of an unbounded cache.
+    std::vector<std::unique_ptr<shard>> m_shards; // The shards of a bounded cache, which is empty if unbounded.
+
+    /// \brief Returns the shard that stores the given key.
+    template <typename Key>
+    shard& get_shard(const Key& key) const
+    {
+      // The lower bits of the hash select the bucket within a shard, so the shard is selected by the higher bits.
+      const std::size_t hash = detail::cache_hash()(key);
+      return *m_shards[(hash >> (std::numeric_limits<std::size_t>::digits / 2)) % m_shards.size()];
+    }
+
+    /// \brief Returns the sum of f applied to the shards of a bounded cache, where an unbounded cache yields 0.
+    template <typename F>
+    std::size_t statistic(F f) const
+    {
+      std::size_t result = 0;
+      for (const std::unique_ptr<shard>& s: m_shards)
+      {
+        std::lock_guard<std::mutex> guard(s->mutex);
+        result += std::visit([&](const auto& cache) -> std::size_t { return f(cache); }, s->cache);
+      }
+      return result;
+    }
+
+    void copy_shards(const std::vector<std::unique_ptr<shard>>& shards)
+    {
+      m_shards.clear();
+      for (const std::unique_ptr<shard>& s: shards)
+      {
+        std::lock_guard<std::mutex> guard(s->mutex);
+        m_shards.push_back(std::make_unique<shard>(s->cache));
+      }
+    }
+
+  public:
+    /// \brief Constructor.
+    /// \param maximum_size The maximum number of entries, where 0 means that the cache is unbounded.
+    /// \param policy The policy that selects the entry that is removed when the cache is full.
+    explicit summand_cache(std::size_t maximum_size = 0, cache_replacement_policy policy = cache_replacement_policy::lru)
+    {
+      if (maximum_size == 0)
+      {
+        return;
+      }
+
+      const std::size_t number_of_shards = std::max<std::size_t>(1, std::min(max_shards, maximum_size / min_shard_size));
+      const std::size_t shard_size = (maximum_size + number_of_shards - 1) / number_of_shards;
+      for (std::size_t i = 0; i < number_of_shards; ++i)
+      {
+        switch (policy)
+        {
+          case cache_replacement_policy::lru:
+            m_shards.push_back(std::make_unique<shard>(cache_type<utilities::lru_policy>(shard_size)));
+            break;
+          case cache_replacement_policy::clock:
+            m_shards.push_back(std::make_unique<shard>(cache_type<utilities::clock_policy>(shard_size)));
+            break;
+          case cache_replacement_policy::frequency:
+            m_shards.push_back(std::make_unique<shard>(cache_type<utilities::frequency_policy>(shard_size)));
+            break;
+        }
+      }
+    }
+
+    summand_cache(const summand_cache& other)
+      : m_map(other.m_map)
+    {
+      copy_shards(other.m_shards);
+    }
+
+    summand_cache(summand_cache&& other) noexcept = default;
+
+    summand_cache& operator=(const summand_cache& other)
+    {
+      if (this != &other)
+      {
+        m_map = other.m_map;
+        copy_shards(other.m_shards);
+      }
+      return *this;
+    }
+
+    summand_cache& operator=(summand_cache&& other) noexcept = default;
+
+    /// \returns True iff the cache has a maximum size.
+    bool bounded() const
+    {
+      return !m_shards.empty();
+    }
+
+    /// \brief Finds the solutions that are stored for the given key.
+    /// \returns True if the key was found, in which case the solutions are assigned to solutions.
+    template <typename Key>
+    bool find(const Key& key, solutions_type& solutions)
+    {
+      if (!bounded())
+      {
+        mcrl2::utilities::shared_guard g = atermpp::detail::g_thread_term_pool().lock_shared();
+        auto i = m_map.find(key);
+        if (i == m_map.end())
+        {
+          return false;
+        }
+        solutions = static_cast<const solutions_type&>(i->second);
+        return true;
+      }
+
+      shard& s = get_shard(key);
+      std::lock_guard<std::mutex> guard(s.mutex);
+      mcrl2::utilities::shared_guard g = atermpp::detail::g_thread_term_pool().lock_shared();
+      return std::visit([&](auto& cache)
+        {
+          auto i = cache.find(key);
+          if (i == cache.end())
+          {
+            return false;
+          }
+          solutions = static_cast<const solutions_type&>((*i).second);
+          return true;
+        }, s.cache);
+    }
+
+    /// \brief Stores the solutions for the given key, which may remove another entry.
+    void insert(const atermpp::aterm& key, const solutions_type& solutions)
+    {
+      if (!bounded())
+      {
+        m_map.insert({key, solutions});
+        return;
+      }
+
+      shard& s = get_shard(key);
+      std::lock_guard<std::mutex> guard(s.mutex);
+      std::visit([&](auto& cache) { cache.emplace(key, solutions); }, s.cache);
+    }
+
+    /// \returns The number of entries in the cache.
+    std::size_t size() const
+    {
+      if (!bounded())
+      {
+        return m_map.size();
+      }
+      return statistic([](const auto& cache) { return cache.size(); });
+    }
+
+    /// \returns The number of successful lookups, which are only counted by a bounded cache.
+    std::size_t hits() const
+    {
+      return statistic([](const auto& cache) { return cache.hits(); });
+    }
+
+    /// \returns The number of unsuccessful lookups, which are only counted by a bounded cache.
+    std::size_t misses() const
+    {
+      return statistic([](const auto& cache) { return cache.misses(); });
+    }
+
+    /// \returns The number of entries that were removed because the cache was full.
+    std::size_t evictions() const
+    {
+      return statistic([](const auto& cache) { return cache.evictions(); });
+    }
+};
+
+inline
+std::ostream& operator<<(std::ostream& out, const summand_cache& cache)
+{
+  if (!cache.bounded())
+  {
+    return out << "size = " << cache.size();
+  }
+  return out << "size = " << cache.size() << ", hits = " << cache.hits() << ", misses = " << cache.misses() << ", evictions = " << cache.evictions();
+}
+
 using projection_cache_map = atermpp::utilities::unordered_map<lps::state,
     std::vector<projected_transition>,
     projection_cache_hash,
@@ -189,7 +417,7 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable summand_cache_map local_cache;
+  mutable summand_cache local_cache;
 
   // attributes for projections (these are not initialized during construction!)
   std::vector<std::size_t> I_r;  // indices of read parameters
@@ -207,14 +435,20 @@ struct explorer_summand
   }
 
   template <typename ActionSummand>
-  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
+  explorer_summand(const ActionSummand& summand,
+                   std::size_t summand_index,
+                   const data::variable_list& process_parameters,
+                   caching cache_strategy_,
+                   std::size_t cache_size = 0,
+                   cache_replacement_policy cache_policy = cache_replacement_policy::lru)
     : variables(summand.summation_variables()),
       condition(summand.condition()),
       multi_action(summand.multi_action()),
       distribution(summand_distribution(summand)),
       next_state(make_data_expression_vector(summand.next_state(process_parameters))),
       index(summand_index),
-      cache_strategy(cache_strategy_)
+      cache_strategy(cache_strategy_),
+      local_cache(cache_strategy_ == caching::local ? cache_size : 0, cache_policy)
   {
     gamma = free_variables(summand.condition(), process_parameters);
     if (cache_strategy_ == caching::global)
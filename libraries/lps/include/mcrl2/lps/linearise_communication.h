@@ -15,6 +15,7 @@
 #include "mcrl2/atermpp/aterm_list.h"
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/lps/detail/configuration.h"
+#include "mcrl2/lps/detail/parallel_summand_generation.h"
 #include "mcrl2/lps/linearise_allow_block.h"
 #include "mcrl2/lps/linearise_utility.h"
 #include "mcrl2/lps/stochastic_action_summand.h"
@@ -358,6 +359,28 @@ public:
   }
 };
 
+/// The summands that result from applying the communication operator to a number of action summands.
+struct communication_result
+{
+  stochastic_action_summand_vector action_summands;
+  deadlock_summand_vector deadlock_summands;
+
+  // The number of summands that are filtered out after construction of the intermediate result (all potential results
+  // of communication that may be allowed/are not blocked).
+  std::size_t disallowed_summands = 0;      // removed by allow
+  std::size_t blocked_summands = 0;         // removed by block
+  std::size_t false_condition_summands = 0; // removed because condition is false
+
+  void append(const communication_result& other)
+  {
+    action_summands.insert(action_summands.end(), other.action_summands.begin(), other.action_summands.end());
+    deadlock_summands.insert(deadlock_summands.end(), other.deadlock_summands.begin(), other.deadlock_summands.end());
+    disallowed_summands += other.disallowed_summands;
+    blocked_summands += other.blocked_summands;
+    false_condition_summands += other.false_condition_summands;
+  }
+};
+
 template <typename DataRewriter>
 class apply_communication_algorithm
 {
@@ -380,6 +403,22 @@ public:
         m_is_block(is_block)
   {}
 
+  /// Creates a copy of other that uses data_rewriter. The communication table is not shared with other.
+  template <typename OtherDataRewriter>
+  apply_communication_algorithm(const apply_communication_algorithm<OtherDataRewriter>& other,
+      DataRewriter& data_rewriter)
+      : m_terminationAction(other.m_terminationAction),
+        m_data_rewriter(data_rewriter),
+        m_communications(other.m_communications),
+        m_allowlist(other.m_allowlist),
+        m_allow_cache(other.m_allow_cache),
+        m_blocked_actions(other.m_blocked_actions),
+        m_allowed_actions(other.m_allowed_actions),
+        m_comm_table(m_communications),
+        m_is_allow(other.m_is_allow),
+        m_is_block(other.m_is_block)
+  {}
+
   ~apply_communication_algorithm() = default;
 
   /// Calculate the communication operator applied to a multiaction.
@@ -403,12 +442,129 @@ public:
     return makeMultiActionConditionList_aux(m, r);
   }
 
+  /// Apply the communication composition to a single action summand.
+  ///
+  /// The resulting action summands are appended to result.action_summands. Unless allow or block are applied inline,
+  /// a delta summand for smmnd is appended to result.deadlock_summands.
+  void apply(const stochastic_action_summand& smmnd, bool nosumelm, communication_result& result)
+  {
+    const data::variable_list& sumvars = smmnd.summation_variables();
+    const process::action_list& multiaction = smmnd.multi_action().actions();
+    const data::data_expression& time = smmnd.multi_action().time();
+    const data::data_expression& condition = smmnd.condition();
+    const data::assignment_list& nextstate = smmnd.assignments();
+    const stochastic_distribution& dist = smmnd.distribution();
+
+    if (!(m_is_allow || m_is_block))
+    {
+      /* Recall a delta summand for every non delta summand.
+       * The reason for this is that with communication, the
+       * conditions for summands can become much more complex.
+       * Many of the actions in these summands are replaced by
+       * delta's later on. Due to the more complex conditions it
+       * will be hard to remove them. By adding a default delta
+       * with a simple condition, makes this job much easier
+       * later on, and will in general reduce the number of delta
+       * summands in the whole system */
+
+      // Create new list of summand variables containing only those that occur in the condition or the timestamp.
+      data::variable_list newsumvars;
+      atermpp::make_term_list(
+          newsumvars,
+          sumvars.begin(),
+          sumvars.end(),
+          [](const data::variable& v) { return v; },
+          [&condition, &time](const data::variable& v)
+          { return occursinterm(condition, v) || occursinterm(time, v); });
+
+      result.deadlock_summands.emplace_back(newsumvars, condition, deadlock(time));
+    }
+
+    /* the multiactionconditionlist is a list containing
+       tuples, with a multiaction and the condition,
+       expressing whether the multiaction can happen. All
+       conditions exclude each other. Furthermore, the list
+       is not empty. If no communications can take place,
+       the original multiaction is delivered, with condition
+       true. */
+
+    // We calculate the communication operator on the multiaction in this single summand. As the actions in the
+    // multiaction can be parameterized with open data expressions, for every subset of applicable communication
+    // expressions this list in principle contains one summand (unless the condition can be rewritten to false, in
+    // which case it is omitted).
+
+    mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
+                                << " actions." << std::endl;
+    mCRL2log(mcrl2::log::trace) << "  Multiaction: " << process::pp(multiaction) << std::endl;
+
+    const tuple_list multiactionconditionlist = apply(multiaction);
+
+    mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
+                                << " actions results in " << multiactionconditionlist.size() << " potential summands"
+                                << std::endl;
+
+    for (std::size_t i = 0; i < multiactionconditionlist.size(); ++i)
+    {
+      const process::action_list& multiaction = multiactionconditionlist.actions[i];
+
+      if (m_is_allow && !allow_(m_allow_cache, multiaction, m_terminationAction))
+      {
+        if constexpr (EnableLineariseStatistics) {
+          ++result.disallowed_summands;
+        }
+
+        continue;
+      }
+      if (m_is_block && encap(m_allowlist, multiaction))
+      {
+        if constexpr (EnableLineariseStatistics) {
+          ++result.blocked_summands;
+        }
+        continue;
+      }
+
+      const data::data_expression communicationcondition = m_data_rewriter(multiactionconditionlist.conditions[i]);
+
+      const data::data_expression newcondition = m_data_rewriter(data::lazy::and_(condition, communicationcondition));
+      stochastic_action_summand new_summand(sumvars,
+          newcondition,
+          smmnd.multi_action().has_time() ? multi_action(multiaction, smmnd.multi_action().time())
+                                          : multi_action(multiaction),
+          nextstate,
+          dist);
+      if (!nosumelm)
+      {
+        if (sumelm(new_summand))
+        {
+          new_summand.condition() = m_data_rewriter(new_summand.condition());
+        }
+      }
+      if constexpr (EnableLineariseStatistics)
+      {
+        if (new_summand.condition() == data::sort_bool::false_())
+        {
+          ++result.false_condition_summands;
+        }
+      }
+
+      if (new_summand.condition() != data::sort_bool::false_())
+      {
+        result.action_summands.push_back(new_summand);
+      }
+    }
+  }
+
   /// Apply the communication composition to a list of action summands.
+  ///
+  /// If number_of_threads > 1, the summands are divided over number_of_threads threads, each with its own rewriter
+  /// created by make_rewriter. The resulting summands do not depend on the number of threads.
   void apply(stochastic_action_summand_vector& action_summands,
       deadlock_summand_vector& deadlock_summands,
       bool nosumelm,
       bool nodeltaelimination,
-      bool ignore_time)
+      bool ignore_time,
+      std::size_t number_of_threads = 1,
+      const thread_rewriter_factory& make_rewriter = thread_rewriter_factory())
   {
     assert(!(m_is_allow && m_is_block));
 
@@ -424,14 +580,6 @@ public:
 
     [[maybe_unused]]
     lps_statistics_t lps_statistics_before = get_statistics(action_summands, deadlock_summands);
-    // number of summands filtered out after construction of intermediate result (all potential results of communication
-    // that may be allowed/are not blocked)
-    [[maybe_unused]]
-    std::size_t disallowed_summands = 0;      // removed by allow
-    [[maybe_unused]]
-    std::size_t blocked_summands = 0;         // removed by block
-    [[maybe_unused]]
-    std::size_t false_condition_summands = 0; // removed because condition is false
 
     mCRL2log(mcrl2::log::trace) << "Calculating communication operator using a set of " << m_communications.size()
                                 << " communication expressions." << std::endl;
@@ -439,8 +587,10 @@ public:
                                 << core::detail::print_set(m_communications) << std::endl;
     mCRL2log(mcrl2::log::trace) << "Allow list: " << std::endl << core::detail::print_set(m_allowlist) << std::endl;
 
-    deadlock_summand_vector resulting_deadlock_summands;
-    deadlock_summands.swap(resulting_deadlock_summands);
+    // The resulting action summands, the delta summands that are recalled for every action summand and the number of
+    // summands that are filtered out after construction of the intermediate result.
+    communication_result result;
+    result.deadlock_summands.swap(deadlock_summands);
 
     const bool inline_allow = m_is_allow || m_is_block;
     if (inline_allow)
@@ -451,122 +601,47 @@ public:
       deadlock_summands.emplace_back(data::variable_list(), data::sort_bool::true_(), deadlock());
     }
 
-    stochastic_action_summand_vector resulting_action_summands;
-
-    for (const stochastic_action_summand& smmnd : action_summands)
+    if (number_of_threads <= 1 || !make_rewriter)
     {
-      const data::variable_list& sumvars = smmnd.summation_variables();
-      const process::action_list& multiaction = smmnd.multi_action().actions();
-      const data::data_expression& time = smmnd.multi_action().time();
-      const data::data_expression& condition = smmnd.condition();
-      const data::assignment_list& nextstate = smmnd.assignments();
-      const stochastic_distribution& dist = smmnd.distribution();
-
-      if (!inline_allow)
+      for (const stochastic_action_summand& smmnd : action_summands)
       {
-        /* Recall a delta summand for every non delta summand.
-         * The reason for this is that with communication, the
-         * conditions for summands can become much more complex.
-         * Many of the actions in these summands are replaced by
-         * delta's later on. Due to the more complex conditions it
-         * will be hard to remove them. By adding a default delta
-         * with a simple condition, makes this job much easier
-         * later on, and will in general reduce the number of delta
-         * summands in the whole system */
-
-        // Create new list of summand variables containing only those that occur in the condition or the timestamp.
-        data::variable_list newsumvars;
-        atermpp::make_term_list(
-            newsumvars,
-            sumvars.begin(),
-            sumvars.end(),
-            [](const data::variable& v) { return v; },
-            [&condition, &time](const data::variable& v)
-            { return occursinterm(condition, v) || occursinterm(time, v); });
-
-        resulting_deadlock_summands.emplace_back(newsumvars, condition, deadlock(time));
+        apply(smmnd, nosumelm, result);
       }
-
-      /* the multiactionconditionlist is a list containing
-         tuples, with a multiaction and the condition,
-         expressing whether the multiaction can happen. All
-         conditions exclude each other. Furthermore, the list
-         is not empty. If no communications can take place,
-         the original multiaction is delivered, with condition
-         true. */
-
-      // We calculate the communication operator on the multiaction in this single summand. As the actions in the
-      // multiaction can be parameterized with open data expressions, for every subset of applicable communication
-      // expressions this list in principle contains one summand (unless the condition can be rewritten to false, in
-      // which case it is omitted).
-
-      mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
-                                  << " actions." << std::endl;
-      mCRL2log(mcrl2::log::trace) << "  Multiaction: " << process::pp(multiaction) << std::endl;
-
-      const tuple_list multiactionconditionlist = apply(multiaction);
-
-      mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
-                                  << " actions results in " << multiactionconditionlist.size() << " potential summands"
-                                  << std::endl;
-
-      for (std::size_t i = 0; i < multiactionconditionlist.size(); ++i)
+    }
+    else
+    {
+      // Every thread uses its own copy of this algorithm, as the communication table is not thread safe.
+      struct thread_state
       {
-        const process::action_list& multiaction = multiactionconditionlist.actions[i];
-
-        if (m_is_allow && !allow_(m_allow_cache, multiaction, m_terminationAction))
-        {
-          if constexpr (EnableLineariseStatistics) {
-            ++disallowed_summands;
-          }
-
-          continue;
-        }
-        if (m_is_block && encap(m_allowlist, multiaction))
-        {
-          if constexpr (EnableLineariseStatistics) {
-            ++blocked_summands;
-          }
-          continue;
-        }
-
-        const data::data_expression communicationcondition = m_data_rewriter(multiactionconditionlist.conditions[i]);
-
-        const data::data_expression newcondition = m_data_rewriter(data::lazy::and_(condition, communicationcondition));
-        stochastic_action_summand new_summand(sumvars,
-            newcondition,
-            smmnd.multi_action().has_time() ? multi_action(multiaction, smmnd.multi_action().time())
-                                            : multi_action(multiaction),
-            nextstate,
-            dist);
-        if (!nosumelm)
-        {
-          if (sumelm(new_summand))
-          {
-            new_summand.condition() = m_data_rewriter(new_summand.condition());
-          }
-        }
-        if constexpr (EnableLineariseStatistics)
-        {
-          if (new_summand.condition() == data::sort_bool::false_())
-          {
-            ++false_condition_summands;
-          }
-        }
-
-        if (new_summand.condition() != data::sort_bool::false_())
-        {
-          resulting_action_summands.push_back(new_summand);
-        }
-      }
+        thread_rewriter rewriter;
+        apply_communication_algorithm<const thread_rewriter> algorithm;
+
+        thread_state(const apply_communication_algorithm& other, thread_rewriter rewr)
+          : rewriter(std::move(rewr)),
+            algorithm(other, rewriter)
+        {}
+
+        // The algorithm refers to the rewriter of this state, so a copy or move would leave it dangling.
+        thread_state(const thread_state&) = delete;
+        thread_state(thread_state&&) = delete;
+        thread_state& operator=(const thread_state&) = delete;
+        thread_state& operator=(thread_state&&) = delete;
+      };
+
+      parallel_generate_summands<communication_result>(action_summands.size(),
+          number_of_threads,
+          [&]() { return thread_state(*this, make_rewriter()); },
+          [&](thread_state& state, std::size_t i, communication_result& local_result)
+          { state.algorithm.apply(action_summands[i], nosumelm, local_result); },
+          [&](const communication_result& local_result) { result.append(local_result); });
     }
 
-    action_summands.swap(resulting_action_summands);
+    action_summands.swap(result.action_summands);
 
     /* Now the resulting delta summands must be added again */
     if (!inline_allow && !nodeltaelimination)
     {
-      for (const deadlock_summand& summand : resulting_deadlock_summands)
+      for (const deadlock_summand& summand : result.deadlock_summands)
       {
         insert_timed_delta_summand(action_summands, deadlock_summands, summand, ignore_time);
       }
@@ -577,9 +652,9 @@ public:
       lps_statistics_t lps_statistics_after = get_statistics(action_summands, deadlock_summands);
       std::cout << log_comm_application(lps_statistics_before,
           lps_statistics_after,
-          disallowed_summands,
-          blocked_summands,
-          false_condition_summands);
+          result.disallowed_summands,
+          result.blocked_summands,
+          result.false_condition_summands);
     }
 
     mCRL2log(mcrl2::log::verbose) << " resulting in " << action_summands.size() << " action summands and "
@@ -587,6 +662,8 @@ public:
   }
 
 protected:
+  template <typename OtherDataRewriter>
+  friend class apply_communication_algorithm;
 
   const process::action& m_terminationAction;
   DataRewriter& m_data_rewriter;
@@ -914,7 +991,9 @@ inline void communicationcomposition(const process::communication_expression_lis
     const bool nosumelm,
     const bool nodeltaelimination,
     const bool ignore_time,
-    const std::function<data::data_expression(const data::data_expression&)>& RewriteTerm)
+    const std::function<data::data_expression(const data::data_expression&)>& RewriteTerm,
+    const std::size_t number_of_threads = 1,
+    const detail::thread_rewriter_factory& make_rewriter = detail::thread_rewriter_factory())
 
 {
   detail::apply_communication_algorithm(terminationAction,
@@ -923,7 +1002,7 @@ inline void communicationcomposition(const process::communication_expression_lis
       allowlist,
       is_allow,
       is_block)
-      .apply(action_summands, deadlock_summands, nosumelm, nodeltaelimination, ignore_time);
+      .apply(action_summands, deadlock_summands, nosumelm, nodeltaelimination, ignore_time, number_of_threads, make_rewriter);
 }
 
 } // namespace mcrl2::lps
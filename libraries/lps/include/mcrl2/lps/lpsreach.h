@@ -43,6 +43,9 @@ class lpsreach_algorithm
     template <typename Context, bool ActionLabel>
     friend void symbolic::learn_successors_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
 
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::learn_successors_parallel(Context& context, const sylvan::ldds::ldd& X, symbolic::learn_successors_workers& workers);
+
   protected:
     const symbolic::symbolic_reachability_options& m_options;
     data::rewriter m_rewr;
@@ -53,6 +56,9 @@ class lpsreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
     symbolic_lts m_lts;
+
+    /// \brief The threads that learn transitions in parallel, which are created by the first call of learn_successors.
+    std::unique_ptr<symbolic::learn_successors_workers> m_learn_workers;
     
     /// \brief Rewrites all arguments of the given action.
     template<typename Rewriter, data::IsSubstitution Substitution>
@@ -76,13 +82,24 @@ class lpsreach_algorithm
     }
 
     // R.L := R.L U {(x,y) in R | x in X}
-    void learn_successors(std::size_t i, symbolic::summand_group& R, const ldd& X)
+    void learn_successors(std::size_t i, lps_summand_group& R, const ldd& X)
     {
       mCRL2log(log::trace) << "learn successors of summand group " << i << " for X = " << print_states(m_lts.data_index, X, R.read) << std::endl;
 
       using namespace sylvan::ldds;
-      std::pair<lpsreach_algorithm&, symbolic::summand_group&> context{*this, R};
-      sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
+      std::pair<lpsreach_algorithm&, lps_summand_group&> context{*this, R};
+      if (m_options.max_workers > 1)
+      {
+        if (!m_learn_workers)
+        {
+          m_learn_workers = std::make_unique<symbolic::learn_successors_workers>(m_options.max_workers, m_rewr, m_sigma, m_lts.data_spec);
+        }
+        symbolic::learn_successors_parallel<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>(context, X, *m_learn_workers);
+      }
+      else
+      {
+        sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<lpsreach_algorithm&, lps_summand_group&>, true>, &context);
+      }
     }
 
     template <typename Specification>
@@ -122,6 +139,7 @@ class lpsreach_algorithm
       using utilities::detail::as_vector;
 
       lps::specification lpsspec_ = preprocess(lpsspec);
+      m_lts.data_spec = lpsspec_.data();
       m_lts.process_parameters = lpsspec_.process().process_parameters();
 
       // Rewrite the initial expressions to normal form,
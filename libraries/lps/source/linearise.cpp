@@ -52,6 +52,7 @@
 #include "mcrl2/lps/replace_capture_avoiding_with_an_identifier_generator.h"
 #include "mcrl2/lps/sumelm.h"
 
+#include "mcrl2/lps/detail/parallel_summand_generation.h"
 #include "mcrl2/lps/detail/ultimate_delay.h"
 
 // Process libraries.
@@ -544,6 +545,28 @@ class specification_basic_type
       return t;
     }
 
+    /// \brief Returns a function that creates a rewriter for the calling thread.
+    /// \details If multiple threads are used, every thread gets a clone of the rewriter. This function must be
+    ///          called by the main thread before the threads are started, as it brings the rewriter up to date.
+    lps::detail::thread_rewriter_factory make_thread_rewriter_factory()
+    {
+      if (options.norewrite)
+      {
+        return []() -> lps::detail::thread_rewriter { return [](const data_expression& t) { return t; }; };
+      }
+      if (fresh_equation_added)
+      {
+        rewr=rewriter(data,options.rewrite_strategy);
+        fresh_equation_added=false;
+      }
+      return [this]() -> lps::detail::thread_rewriter
+      {
+        data::rewriter thread_rewr=rewr.clone(); // A rewriter cannot be used by multiple threads at the same time.
+        thread_rewr.thread_initialise();
+        return [thread_rewr](const data_expression& t) { return thread_rewr(t); };
+      };
+    }
+
     data_expression_list RewriteTermList(const data_expression_list& t)
     {
       data_expression_vector v;
@@ -7753,8 +7776,8 @@ class specification_basic_type
         allow_cache = lps::detail::make_allow_list_cache(allowlist);
       }
 
-      // First combine the action summands.
-      for (const stochastic_action_summand& summand1: action_summands1)
+      // Combine summand1 with all summands in action_summands2, and add the results to result.
+      auto combine = [&](const auto& rewrite, const stochastic_action_summand& summand1, stochastic_action_summand_vector& result)
       {
         const variable_list& sumvars1=summand1.summation_variables();
         const action_list multiaction1=summand1.multi_action().actions();
@@ -7828,11 +7851,11 @@ class specification_basic_type
                                               distribution1.variables()+distribution2.variables(),
                                               real_times_optimized(distribution1.distribution(),distribution2.distribution()));
 
-            condition3=RewriteTerm(condition3);
+            condition3=rewrite(condition3);
             if (condition3!=sort_bool::false_())
             {
               assert(std::is_sorted(multiaction3.begin(), multiaction3.end(), action_compare()));
-              action_summands.emplace_back(allsums,
+              result.emplace_back(allsums,
                   condition3,
                   has_time3 ? multi_action(multiaction3, action_time3) : multi_action(multiaction3),
                   nextstate3,
@@ -7840,6 +7863,29 @@ class specification_basic_type
             }
           }
         }
+      };
+
+      // First combine the action summands.
+      if (options.number_of_threads<=1)
+      {
+        for (const stochastic_action_summand& summand1: action_summands1)
+        {
+          combine([this](const data_expression& t) { return RewriteTerm(t); }, summand1, action_summands);
+        }
+      }
+      else
+      {
+        lps::detail::parallel_generate_summands<stochastic_action_summand_vector>(action_summands1.size(),
+            options.number_of_threads,
+            make_thread_rewriter_factory(),
+            [&](const lps::detail::thread_rewriter& rewrite, std::size_t i, stochastic_action_summand_vector& result)
+            {
+              combine(rewrite, action_summands1[i], result);
+            },
+            [&](const stochastic_action_summand_vector& result)
+            {
+              action_summands.insert(action_summands.end(), result.begin(), result.end());
+            });
       }
     }
 
@@ -8378,7 +8424,8 @@ class specification_basic_type
         {
           generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
-          communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+          communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); },
+                                   options.number_of_threads,make_thread_rewriter_factory());
           return;
         }
 
@@ -8422,7 +8469,8 @@ class specification_basic_type
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
           // Encode the actions of the block list in one multi action.
           communicationcomposition(comm(par).comm_set(),action_name_multiset_list( { action_name_multiset(block(t).block_set())} ),
-                                                     false,true,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+                                                     false,true,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); },
+                                   options.number_of_threads,make_thread_rewriter_factory());
           return;
         }
 
@@ -8444,7 +8492,8 @@ class specification_basic_type
       {
         generateLPEmCRLterm(action_summands,deadlock_summands,comm(t).operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
-        communicationcomposition(comm(t).comm_set(),action_name_multiset_list(),false,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+        communicationcomposition(comm(t).comm_set(),action_name_multiset_list(),false,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); },
+                                   options.number_of_threads,make_thread_rewriter_factory());
         return;
       }
 
@@ -188,6 +188,25 @@ BOOST_AUTO_TEST_CASE(linearisation_of_distribution_over_initial_process)
   run_linearisation_test_case(spec,true);
 }   
 
+BOOST_AUTO_TEST_CASE(linearisation_with_multiple_threads)
+{
+  const std::string spec =
+     "act a,b,c,d:Nat;\n"
+     "proc P(n:Nat)=sum m:Nat.(m<3) -> a(m).P(n+m) + b(n).P(n);\n"
+     "     Q(n:Nat)=sum m:Nat.(m<2) -> c(m).Q(m) + b(n).Q(n+1);\n"
+     "init allow({d,a|b,c}, comm({a|c->d}, P(0)||Q(1)||P(1)));\n";
+
+  t_lin_options options;
+  stochastic_specification sequential = linearise(spec, options);
+  options.number_of_threads = 4;
+  stochastic_specification parallel = linearise(spec, options);
+  BOOST_CHECK(mcrl2::lps::detail::is_well_typed(parallel));
+
+  // The summands, including the names of their fresh variables, do not depend on the number of threads.
+  BOOST_CHECK_EQUAL(lps::pp(sequential), lps::pp(parallel));
+  BOOST_CHECK(sequential == parallel);
+}
+
 #else // ndef MCRL2_SKIP_LONG_TESTS
 
 BOOST_AUTO_TEST_CASE(skip_linearization_test)
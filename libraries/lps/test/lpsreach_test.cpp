@@ -0,0 +1,98 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lpsreach_test.cpp
+/// \brief Tests for the symbolic reachability algorithm on linear processes.
+
+#define BOOST_TEST_MODULE lpsreach_test
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(dummy_test)
+{
+  // This is an empty test since at least one test is required.
+}
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/lps/lpsreach.h"
+#include "mcrl2/lps/parse.h"
+#include "mcrl2/symbolic/test_utility.h"
+
+#include <sylvan_ldd.hpp>
+
+using namespace mcrl2;
+
+TASK_DECL_0(bool, learn_successors_in_parallel_task);
+#define learn_successors_in_parallel_task() RUN(learn_successors_in_parallel_task)
+
+// The transitions that are learned with multiple threads must be the same as those learned by a single thread,
+// including the indices of the values and actions.
+TASK_IMPL_0(bool, learn_successors_in_parallel_task)
+{
+  const std::string text =
+    "act a: Nat;\n"
+    "    b: Bool;\n"
+    "proc P(n: Nat, c: Bool) =\n"
+    "       sum m: Nat. (m < 3 && n < 20) -> a(m) . P(n + m, !c)\n"
+    "     + c -> b(n < 5) . P(n, false)\n"
+    "     + (n > 10) -> a(n) . P(0, true);\n"
+    "init P(0, true);\n";
+  const lps::specification lpsspec = lps::parse_linear_process_specification(text);
+
+  symbolic::symbolic_reachability_options options;
+  options.max_workers = 1;
+  lps::lpsreach_algorithm sequential(lpsspec, options);
+  const sylvan::ldds::ldd sequential_states = sequential.run();
+
+  for (std::size_t number_of_threads: {2, 4})
+  {
+    symbolic::symbolic_reachability_options parallel_options;
+    parallel_options.max_workers = number_of_threads;
+    lps::lpsreach_algorithm parallel(lpsspec, parallel_options);
+    const sylvan::ldds::ldd parallel_states = parallel.run();
+
+    BOOST_CHECK(sequential_states == parallel_states);
+
+    const lps::symbolic_lts& sequential_lts = sequential.get_symbolic_lts();
+    const lps::symbolic_lts& parallel_lts = parallel.get_symbolic_lts();
+    BOOST_REQUIRE_EQUAL(sequential_lts.summand_groups.size(), parallel_lts.summand_groups.size());
+    for (std::size_t i = 0; i < sequential_lts.summand_groups.size(); ++i)
+    {
+      BOOST_CHECK(sequential_lts.summand_groups[i].L == parallel_lts.summand_groups[i].L);
+    }
+
+    BOOST_REQUIRE_EQUAL(sequential_lts.data_index.size(), parallel_lts.data_index.size());
+    for (std::size_t i = 0; i < sequential_lts.data_index.size(); ++i)
+    {
+      BOOST_REQUIRE_EQUAL(sequential_lts.data_index[i].size(), parallel_lts.data_index[i].size());
+      for (std::size_t j = 0; j < sequential_lts.data_index[i].size(); ++j)
+      {
+        BOOST_CHECK_EQUAL(sequential_lts.data_index[i][j], parallel_lts.data_index[i][j]);
+      }
+    }
+
+    BOOST_REQUIRE_EQUAL(sequential_lts.action_index.size(), parallel_lts.action_index.size());
+    for (std::size_t i = 0; i < sequential_lts.action_index.size(); ++i)
+    {
+      BOOST_CHECK_EQUAL(sequential_lts.action_index.at(i), parallel_lts.action_index.at(i));
+    }
+  }
+
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(learn_successors_in_parallel)
+{
+  symbolic::initialise_sylvan();
+
+  learn_successors_in_parallel_task();
+
+  symbolic::quit_sylvan();
+}
+
+#endif // MCRL2_ENABLE_SYLVAN
@@ -20,6 +20,7 @@
 
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/trace.h"
+#include <algorithm>
 #include <cstddef>
 
 namespace mcrl2::lts::detail
@@ -130,27 +131,31 @@ class counter_example_constructor
       }
     }
 
-    /// \brief This function returns the trace from the root to the current index.
-    template < class LTS_TYPE >
-    trace get_trace(const LTS_TYPE& l, index_type index) const {
-      // We first store the label indices in reverse order in a stack.
-      std::stack< index_type > reversed_label_indices;
+    /// \brief This function returns the label indices of the trace from the root to the current index.
+    std::vector<std::size_t> get_label_indices(index_type index) const
+    {
+      std::vector<std::size_t> result;
       for(index_type current_index=index; 
           current_index!=m_root_index; 
           current_index=m_backward_tree[current_index].previous_entry_index())
       {
-        reversed_label_indices.push(m_backward_tree[current_index].label_index());
+        result.push_back(m_backward_tree[current_index].label_index());
       }
+      std::reverse(result.begin(), result.end());
+      return result;
+    }
 
+    /// \brief This function returns the trace from the root to the current index.
+    template < class LTS_TYPE >
+    trace get_trace(const LTS_TYPE& l, index_type index) const {
       trace result;
-      while (!reversed_label_indices.empty())
+      for (std::size_t label_index: get_label_indices(index))
       {
         result.add_action(mcrl2::lps::multi_action(mcrl2::process::action(
                                 mcrl2::process::action_label(
-                                       core::identifier_string(mcrl2::lts::pp(l.action_label(reversed_label_indices.top()))),
+                                       core::identifier_string(mcrl2::lts::pp(l.action_label(label_index))),
                                        mcrl2::data::sort_expression_list()),
                                 mcrl2::data::data_expression_list())));
-        reversed_label_indices.pop();
       }
       return result;
     }
@@ -23,6 +23,29 @@
 namespace mcrl2::lts::detail
 {
 
+/**
+ * \brief create_regular_formula Creates a regular formula that represents action a
+ * \details In case the action comes from an LTS in the lts format.
+ * \param[in] a The action for which to create a regular formula
+ * \return The created regular formula
+ */
+inline regular_formulas::regular_formula create_regular_formula(const mcrl2::lps::multi_action& a)
+{
+  return regular_formulas::regular_formula(action_formulas::multi_action(a.actions()));
+}
+
+/**
+ * \brief create_regular_formula Creates a regular formula that represents action a
+ * \details In case the action comes from an LTS in the aut or fsm format.
+ * \param[in] a The action for which to create a regular formula
+ * \return The created regular formula
+ */
+inline regular_formulas::regular_formula create_regular_formula(const mcrl2::lts::action_label_string& a)
+{
+  return mcrl2::regular_formulas::regular_formula(mcrl2::action_formulas::multi_action(
+    process::action_list({ process::action(process::action_label(a, {}), {}) })));
+}
+
 template < class LTS_TYPE>
 class bisim_partitioner
 {
@@ -817,29 +840,6 @@ class bisim_partitioner
         { return mcrl2::state_formulas::and_(a, b); }, mcrl2::state_formulas::true_());
     }
 
-    /**
-     * \brief create_regular_formula Creates a regular formula that represents action a
-     * \details In case the action comes from an LTS in the lts format.
-     * \param[in] a The action for which to create a regular formula
-     * \return The created regular formula
-     */
-    regular_formulas::regular_formula create_regular_formula(const mcrl2::lps::multi_action& a) const
-    {
-      return regular_formulas::regular_formula(action_formulas::multi_action(a.actions()));
-    }
-
-    /**
-     * \brief create_regular_formula Creates a regular formula that represents action a
-     * \details In case the action comes from an LTS in the aut or fsm format.
-     * \param[in] a The action for which to create a regular formula
-     * \return The created regular formula
-     */
-    regular_formulas::regular_formula create_regular_formula(const mcrl2::lts::action_label_string& a) const
-    {
-      return mcrl2::regular_formulas::regular_formula(mcrl2::action_formulas::multi_action(
-        process::action_list({ process::action(process::action_label(a, {}), {}) })));
-    }
-
     /**
      * \brief until_formula Creates a state formula that corresponds to the until operator phi1<a>phi2 from HMLU
      * \details This operator intuitively means: "phi1 holds while stuttering until we can do an a-step after which phi2 holds"
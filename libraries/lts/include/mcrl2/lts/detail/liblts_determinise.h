@@ -0,0 +1,274 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_determinise.h
+/// \brief Determinisation of an LTS by a subset construction in which the successors of the
+///        sets of states are calculated by multiple threads.
+
+#ifndef MCRL2_LTS_DETAIL_LIBLTS_DETERMINISE_H
+#define MCRL2_LTS_DETAIL_LIBLTS_DETERMINISE_H
+
+#include "mcrl2/lts/detail/liblts_bisim_gj.h"
+#include "mcrl2/lts/detail/tree_set.h"
+#include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief The number of transitions of the deterministic LTS after which its explored part is minimised for the
+///        first time, when minimising during the subset construction.
+constexpr std::size_t subset_construction_minimisation_threshold = 1UL << 20;
+
+/// \brief For every label, the sorted set of states that is reached from a set of states by that
+///        label. The labels are increasing, and the states reached by labels[i] are in the range
+///        [bounds[i], bounds[i+1]) of targets.
+struct subset_successors
+{
+  std::vector<std::size_t> labels;
+  std::vector<std::size_t> bounds;
+  std::vector<std::ptrdiff_t> targets;
+};
+
+/// \brief Adds the states in the set of subsets with the given node to states, in increasing order.
+/// \details The store is only read, so threads can do this at the same time as long as no sets are added.
+inline void collect_subset(tree_set_store& subsets, const std::ptrdiff_t set, std::vector<std::ptrdiff_t>& states)
+{
+  if (subsets.is_set_empty(set))
+  {
+    return;
+  }
+  if (subsets.is_set_empty(subsets.get_set_child_right(set)))
+  {
+    states.push_back(subsets.get_set_child_left(set));
+    return;
+  }
+  collect_subset(subsets, subsets.get_set_child_left(set), states);
+  collect_subset(subsets, subsets.get_set_child_right(set), states);
+}
+
+/// \brief Calculates the successors of the set of states with the given tag in subsets. The states and
+///        buffer are scratch space, such that threads that calculate successors at the same time do
+///        not share any data.
+inline void calculate_subset_successors(tree_set_store& subsets,
+    const std::ptrdiff_t tag,
+    const outgoing_transitions_per_state_t& outgoing,
+    const std::vector<std::size_t>& hidden_labels,
+    std::vector<std::ptrdiff_t>& states,
+    std::vector<std::pair<std::size_t, std::ptrdiff_t>>& buffer,
+    subset_successors& result)
+{
+  states.clear();
+  collect_subset(subsets, subsets.get_set(tag), states);
+  buffer.clear();
+  for (const std::ptrdiff_t s: states)
+  {
+    for (std::size_t i = outgoing.lowerbound(s); i < outgoing.upperbound(s); ++i)
+    {
+      const outgoing_pair_t& p = outgoing.get_transitions()[i];
+      buffer.emplace_back(hidden_labels[label(p)], to(p));
+    }
+  }
+  std::sort(buffer.begin(), buffer.end());
+  buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+
+  result.labels.clear();
+  result.bounds.assign(1, 0);
+  result.targets.clear();
+  for (std::size_t i = 0; i < buffer.size(); ++i)
+  {
+    result.targets.push_back(buffer[i].second);
+    if (i + 1 == buffer.size() || buffer[i + 1].first != buffer[i].first)
+    {
+      result.labels.push_back(buffer[i].first);
+      result.bounds.push_back(result.targets.size());
+    }
+  }
+}
+
+/// \brief Merges the sets with a tag below explored that are bisimilar in the deterministic LTS with the given
+///        transitions, in which every set that is not explored yet is only bisimilar to itself.
+/// \details As the sets that are not explored are kept apart, merged sets are also bisimilar when the exploration
+///          has finished. The sources and targets of the transitions are representatives. The partition is
+///          calculated by the partitioner of Groote and Jansen, in time O(m log n). To keep the sets that are not
+///          explored apart, the k-th of them gets a loop with a fresh label for every bit of k, which are
+///          O(log n) transitions per set. Afterwards, representative[t] is the smallest tag that t is merged with,
+///          and only the transitions of representatives remain.
+inline void minimise_explored_subsets(std::vector<transition>& transitions,
+    std::vector<std::ptrdiff_t>& representative,
+    const std::size_t explored)
+{
+  const std::size_t n = representative.size();
+
+  std::size_t number_of_labels = 1;
+  for (const transition& t: transitions)
+  {
+    number_of_labels = std::max(number_of_labels, t.label() + 1);
+  }
+  std::size_t number_of_bits = 0;
+  while ((n - explored) >> number_of_bits != 0)
+  {
+    ++number_of_bits;
+  }
+
+  lts_aut_t aut;
+  aut.set_num_states(n, false);
+  aut.set_num_action_labels(number_of_labels + 2 * number_of_bits);
+  aut.get_transitions() = transitions;
+  for (std::size_t t = explored; t < n; ++t)
+  {
+    for (std::size_t i = 0; i < number_of_bits; ++i)
+    {
+      aut.add_transition(transition(t, number_of_labels + 2 * i + (((t - explored) >> i) & 1), t));
+    }
+  }
+
+  // The equivalence classes are only numbered when aut is replaced by its quotient.
+  bisim_partitioner_gj<lts_aut_t> partitioner(aut);
+  partitioner.finalize_minimized_LTS();
+
+  // The representative of a block is its smallest set. The representative of a set that was merged before is
+  // smaller than that set, and therefore already updated.
+  std::unordered_map<std::size_t, std::ptrdiff_t> block_representative;
+  for (std::size_t s = 0; s < explored; ++s)
+  {
+    if (representative[s] == static_cast<std::ptrdiff_t>(s))
+    {
+      representative[s] = block_representative.try_emplace(partitioner.get_eq_class(s), s).first->second;
+    }
+    else
+    {
+      representative[s] = representative[representative[s]];
+    }
+  }
+
+  std::size_t number_of_transitions = 0;
+  for (const transition& t: transitions)
+  {
+    if (representative[t.from()] == static_cast<std::ptrdiff_t>(t.from()))
+    {
+      transitions[number_of_transitions++] = transition(t.from(), t.label(), representative[t.to()]);
+    }
+  }
+  transitions.resize(number_of_transitions);
+}
+
+/// \brief Replaces l by the deterministic LTS of which the states are the sets of states of l
+///        that are reachable from the initial state, where the labels in the hidden label set
+///        are replaced by tau.
+/// \details The sets are stored in a tree_set_store, such that sets share their common subsets. The sets are
+///          explored breadth-first in batches. The successors of the sets in a batch are calculated by
+///          number_of_threads threads, after which they are numbered by a single thread in the order of the batch.
+///          So the resulting LTS, including the numbering of its states, does not depend on the number of threads.
+///          If minimisation_threshold is not zero, the explored sets that are bisimilar are merged each time the
+///          number of transitions has reached the threshold, after which the threshold is doubled relative to the
+///          remaining transitions. The result is then deterministic and trace equivalent to l, but not necessarily
+///          minimal.
+template <class LTS_TYPE>
+void subset_construction(LTS_TYPE& l, const std::size_t number_of_threads, const std::size_t minimisation_threshold = 0)
+{
+  const outgoing_transitions_per_state_t outgoing(l.get_transitions(), l.num_states(), true);
+  std::vector<std::size_t> hidden_labels(l.num_action_labels());
+  for (std::size_t a = 0; a < l.num_action_labels(); ++a)
+  {
+    hidden_labels[a] = l.apply_hidden_label_map(a);
+  }
+
+  l.clear_transitions();
+  l.clear_state_labels();
+
+  tree_set_store subsets;
+  std::vector<std::ptrdiff_t> states{static_cast<std::ptrdiff_t>(l.initial_state())};
+  subsets.set_set_tag(subsets.create_set(states));
+  std::vector<std::ptrdiff_t> representative{0};
+  std::size_t next_minimisation = minimisation_threshold;
+
+  // With a single thread the successors are numbered as soon as they are calculated.
+  const std::size_t batch_size = number_of_threads > 1 ? 1024 * number_of_threads : 1;
+  std::vector<subset_successors> successors(batch_size);
+  std::vector<std::pair<std::size_t, std::ptrdiff_t>> buffer;
+
+  for (std::size_t first = 0; first < static_cast<std::size_t>(subsets.get_next_tag());)
+  {
+    const std::size_t last = std::min(static_cast<std::size_t>(subsets.get_next_tag()), first + batch_size);
+    if (last - first == 1)
+    {
+      calculate_subset_successors(subsets, first, outgoing, hidden_labels, states, buffer, successors[0]);
+    }
+    else
+    {
+      utilities::detail::parallel_for(last - first, number_of_threads,
+        [&](const std::size_t begin, const std::size_t end)
+        {
+          std::vector<std::ptrdiff_t> thread_states;
+          std::vector<std::pair<std::size_t, std::ptrdiff_t>> thread_buffer;
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            calculate_subset_successors(subsets, first + i, outgoing, hidden_labels, thread_states, thread_buffer,
+                successors[i]);
+          }
+        });
+    }
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const subset_successors& s = successors[i - first];
+      for (std::size_t j = 0; j < s.labels.size(); ++j)
+      {
+        states.assign(s.targets.begin() + s.bounds[j], s.targets.begin() + s.bounds[j + 1]);
+        const std::ptrdiff_t to = subsets.set_set_tag(subsets.create_set(states));
+        if (to == static_cast<std::ptrdiff_t>(representative.size()))
+        {
+          representative.push_back(to);
+        }
+        l.add_transition(transition(i, s.labels[j], representative[to]));
+      }
+    }
+
+    if (first / 10000 != last / 10000)
+    {
+      mCRL2log(log::debug) << "generated " << subsets.get_next_tag() << " states and " << l.num_transitions()
+                           << " transitions; explored " << last << " states" << std::endl;
+    }
+    first = last;
+
+    if (minimisation_threshold > 0 && l.num_transitions() >= next_minimisation)
+    {
+      minimise_explored_subsets(l.get_transitions(), representative, first);
+      next_minimisation = std::max(minimisation_threshold, 2 * l.num_transitions());
+      mCRL2log(log::debug) << "minimised the explored states; " << l.num_transitions() << " transitions remain"
+                           << std::endl;
+    }
+  }
+
+  // Number the representatives consecutively, in the order of their tags.
+  std::size_t number_of_states = 0;
+  for (std::size_t t = 0; t < representative.size(); ++t)
+  {
+    representative[t] = representative[t] == static_cast<std::ptrdiff_t>(t) ? number_of_states++ : -1;
+  }
+  if (number_of_states < representative.size())
+  {
+    for (transition& t: l.get_transitions())
+    {
+      t = transition(representative[t.from()], t.label(), representative[t.to()]);
+    }
+  }
+
+  l.set_num_states(number_of_states, false); // remove the state values, and reset the number of states.
+  l.set_initial_state(0);
+}
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_LIBLTS_DETERMINISE_H
@@ -21,10 +21,20 @@
 
 #include "mcrl2/lps/exploration_strategy.h"
 #include "mcrl2/lts/detail/counter_example.h"
+#include "mcrl2/lts/detail/liblts_bisim.h"
 #include "mcrl2/lts/detail/liblts_bisim_dnj.h"
+#include "mcrl2/modal_formula/state_formula.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
+#include "mcrl2/utilities/hash_utility.h"
 
 #include <boost/container/flat_set.hpp>
 
+#include <atomic>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace mcrl2::lts 
 {
   
@@ -35,14 +45,85 @@ using state_type = std::size_t;
 using label_type = std::size_t;
 using set_of_states = boost::container::flat_set<state_type>;
 using action_label_set = boost::container::flat_set<label_type>;
-using anti_chain_type = std::multimap<detail::state_type, detail::set_of_states>;
+
+/// \brief A set of states that is stored once in a macro_state_store. Macro states can be copied and compared for
+///        equality as pointers.
+using macro_state = const set_of_states*;
+using anti_chain_type = std::multimap<detail::state_type, detail::macro_state>;
+
+/// \brief Stores sets of states that are encountered during a refinement check once, together with a cache
+///        of the sets that are reached from a set by some action.
+/// \details The store belongs to a single run of a refinement check. Only the sets that are put in the antichain are
+///          stored, such that sets that are subsumed by the antichain do not take memory. The size of the cache of
+///          successors is bounded; it is cleared when it becomes full.
+class macro_state_store
+{
+protected:
+  struct set_of_states_hash
+  {
+    std::size_t operator()(const set_of_states& states) const
+    {
+      std::size_t hash = 0;
+      for (const state_type s: states)
+      {
+        hash = utilities::detail::hash_combine(hash, s);
+      }
+      return hash;
+    }
+  };
+
+  // An unordered_set does not move its elements, which makes it safe to point to them.
+  std::unordered_set<set_of_states, set_of_states_hash> m_macro_states;
+  std::unordered_map<std::pair<macro_state, label_type>, macro_state> m_successors;
+  std::size_t m_max_successors;
+
+public:
+  explicit macro_state_store(const std::size_t max_successors = 1UL << 20)
+      : m_max_successors(max_successors)
+  {}
+
+  /// \brief Returns the unique macro state with the given states.
+  macro_state insert(set_of_states&& states) { return &*m_macro_states.insert(std::move(states)).first; }
+
+  /// \brief Returns the unique macro state with the given states.
+  macro_state insert(const set_of_states& states) { return &*m_macro_states.insert(states).first; }
+
+  /// \brief Returns the macro state with the given states, or nullptr if these states are not stored.
+  /// \details This function can be called by several threads, as long as no macro states are added at the same time.
+  macro_state find(const set_of_states& states) const
+  {
+    const auto i = m_macro_states.find(states);
+    return i == m_macro_states.end() ? nullptr : &*i;
+  }
+
+  /// \brief Returns the macro state reached from spec by action e, or nullptr if it is not in the cache.
+  /// \details This function can be called by several threads, as long as no successors are added at the same time.
+  macro_state find_successor(const macro_state spec, const label_type e) const
+  {
+    const auto i = m_successors.find(std::make_pair(spec, e));
+    return i == m_successors.end() ? nullptr : i->second;
+  }
+
+  /// \brief Records that spec_prime is reached from spec by action e.
+  void add_successor(const macro_state spec, const label_type e, const macro_state spec_prime)
+  {
+    if (m_successors.size() >= m_max_successors)
+    {
+      m_successors.clear();
+    }
+    m_successors.emplace(std::make_pair(spec, e), spec_prime);
+  }
+
+  /// \brief The number of different macro states.
+  std::size_t size() const { return m_macro_states.size(); }
+};
 
 template <class COUNTER_EXAMPLE_CONSTRUCTOR>
 class state_states_counter_example_index_triple
 {
 protected:
   detail::state_type m_state = 0UL;
-  detail::set_of_states m_states;
+  detail::macro_state m_states = nullptr;
   typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type m_counter_example_index;
 
 public:
@@ -50,17 +131,19 @@ public:
 
   /// \brief Constructor.
   state_states_counter_example_index_triple(const state_type state,
-      set_of_states states,
+      const macro_state states,
       const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type& counter_example_index)
       : m_state(state),
-        m_states(std::move(states)),
+        m_states(states),
         m_counter_example_index(counter_example_index)
   {}
 
   /// \brief Get the state.
   state_type state() const { return m_state; }
   /// \brief Get the set of states.
-  const set_of_states& states() const { return m_states; }
+  const set_of_states& states() const { return *m_states; }
+  /// \brief Get the set of states as a macro state.
+  macro_state get_macro_state() const { return m_states; }
 
   /// \brief Get the counter example index.
   const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type& counter_example_index() const
@@ -71,11 +154,19 @@ public:
 
 inline bool antichain_include(anti_chain_type& anti_chain,
   const detail::state_type& impl,
-  const detail::set_of_states& spec);
+  const detail::macro_state spec);
 
 inline bool antichain_insert(anti_chain_type& anti_chain,
   const detail::state_type& impl,
-  const detail::set_of_states& spec);
+  const detail::macro_state spec);
+
+inline bool antichain_include(const anti_chain_type& anti_chain,
+  const detail::state_type& impl,
+  const set_of_states& spec);
+
+inline void antichain_add(anti_chain_type& anti_chain,
+  const detail::state_type& impl,
+  const detail::macro_state spec);
 
 // The class below recalls what the stable states and the states with a divergent
 // self loop of a transition system are, such that it does not have to be recalculated each time again.
@@ -88,28 +179,34 @@ protected:
   std::vector<std::vector<transition>> m_sorted_transitions;
   std::vector<bool> m_divergent;
   std::vector<action_label_set> m_enabled_actions;
+  std::vector<label_type> m_hidden_labels;
 
 private:
   void calculate_weak_property_cache(const bool weak_reduction)
   {
+    for (label_type a = 0; a < m_l.num_action_labels(); ++a)
+    {
+      m_hidden_labels.push_back(m_l.apply_hidden_label_map(a));
+    }
+
     scc_partitioner<LTS_TYPE> strongly_connected_component_partitioner(m_l);
     
     for (const transition& t : m_l.get_transitions())
     {
 
       assert(t.from() < m_l.num_states());
-      if (m_l.is_tau(m_l.apply_hidden_label_map(t.label())) && weak_reduction)
+      if (m_l.is_tau(m_hidden_labels[t.label()]) && weak_reduction)
       {
         m_tau_reachable_states[t.from()].push_back(t.to()); // There is an outgoing tau.
       }
       m_sorted_transitions[t.from()].push_back(t);
 
-      if (weak_reduction && m_l.is_tau(m_l.apply_hidden_label_map(t.label()))
+      if (weak_reduction && m_l.is_tau(m_hidden_labels[t.label()])
           && strongly_connected_component_partitioner.in_same_class(t.from(), t.to()))
       {
         m_divergent[t.from()] = true; // There is a self loop.
       }
-      m_enabled_actions[t.from()].insert(m_l.apply_hidden_label_map(t.label()));
+      m_enabled_actions[t.from()].insert(m_hidden_labels[t.label()]);
     }
   }
 
@@ -139,18 +236,33 @@ public:
   bool diverges(const state_type s) const { return m_divergent[s]; }
 
   const action_label_set& action_labels(const state_type s) const { return m_enabled_actions[s]; }
+
+  /// \brief The label a after applying the hidden label map, which is calculated once for every label.
+  label_type hidden_label(const label_type a) const { return m_hidden_labels[a]; }
+
+  /// \brief Whether the hidden label a is the internal action.
+  bool is_tau(const label_type a) const { return m_l.is_tau(a); }
+
+  std::size_t num_states() const { return m_sorted_transitions.size(); }
 };
 
 template<class LTS_TYPE>
 set_of_states
 collect_reachable_states_via_taus(state_type s, const lts_cache<LTS_TYPE>& weak_property_cache, bool weak_reduction);
 
+/// \brief Scratch space to calculate a set of states. Each thread needs its own buffer.
+struct macro_state_buffer
+{
+  std::vector<state_type> states;
+  std::vector<bool> visited;
+};
+
 template<class LTS_TYPE>
-set_of_states collect_reachable_states_via_an_action(state_type s,
+set_of_states collect_reachable_states_via_an_action(const set_of_states& spec,
   label_type e,
   const lts_cache<LTS_TYPE>& weak_property_cache,
   bool weak_reduction,
-  const LTS_TYPE& l);
+  macro_state_buffer& buffer);
 
 template<class LTS_TYPE>
 bool refusals_contained_in(state_type impl,
@@ -222,6 +334,322 @@ reduce(LTS_TYPE& lts, const bool weak_reduction, const bool preserve_divergence,
   return std::make_pair(l2_init, l2_init == lts.initial_state());
 }
 
+namespace detail
+{
+
+/// \brief The set of states that the specification reaches by the action of a transition of the implementation.
+/// \details It is either a macro state, if it is stored, or a set of states that is not stored (yet).
+struct macro_state_successor
+{
+  macro_state known = nullptr;
+  set_of_states states;
+};
+
+/// \brief How a pair of a state and a set of states is handled, which is determined before its successors are
+///        calculated.
+enum class refinement_pair_verdict
+{
+  explore,   // The successors of the pair are explored.
+  skip,      // The pair has no successors that need to be explored.
+  violation, // The pair violates the refinement relation.
+  unknown    // The pair is not considered, as an earlier pair in the batch violates the refinement relation.
+};
+
+/// \brief Determines for every pair in batch its verdict using check, and calculates for every pair that is to be
+///        explored, and every outgoing transition of the state of that pair, the set of states that is reached from
+///        the states of that pair by the same action.
+/// \details The batch is divided over the threads of the pool, which each use their own buffer. Only the
+///          weak_property_cache and the store are read, such that the threads do not interfere. When a pair is a
+///          violation, or has an empty successor, which is also a violation, the pairs after it in the batch are
+///          not considered.
+template <class LTS_TYPE, class STATE_STATES_PAIR, class CHECK>
+void calculate_successors(const std::vector<STATE_STATES_PAIR>& batch,
+    std::vector<refinement_pair_verdict>& verdicts,
+    std::vector<std::vector<macro_state_successor>>& successors,
+    const lts_cache<LTS_TYPE>& weak_property_cache,
+    const macro_state_store& store,
+    const bool weak_reduction,
+    std::vector<macro_state_buffer>& buffers,
+    utilities::detail::parallel_for_pool& pool,
+    CHECK check)
+{
+  verdicts.assign(batch.size(), refinement_pair_verdict::unknown);
+  successors.resize(batch.size());
+  std::atomic<std::size_t> first_violation = batch.size();
+  auto violation_at = [&](const std::size_t i)
+  {
+    std::size_t current = first_violation.load();
+    while (i < current && !first_violation.compare_exchange_weak(current, i))
+    {
+    }
+  };
+
+  auto calculate = [&](const std::size_t i, macro_state_buffer& buffer)
+  {
+    successors[i].clear();
+    if (i > first_violation.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    verdicts[i] = check(batch[i]);
+    if (verdicts[i] != refinement_pair_verdict::explore)
+    {
+      if (verdicts[i] == refinement_pair_verdict::violation)
+      {
+        violation_at(i);
+      }
+      return;
+    }
+
+    for (const transition& t : weak_property_cache.transitions(batch[i].state()))
+    {
+      macro_state_successor& successor = successors[i].emplace_back();
+      const label_type e = weak_property_cache.hidden_label(t.label());
+      if (weak_property_cache.is_tau(e) && weak_reduction) // if e=tau then
+      {
+        successor.known = batch[i].get_macro_state(); // spec' := spec;
+      }
+      else
+      {
+        // spec' := {s' | exists s in spec. s-e->s'};
+        successor.known = store.find_successor(batch[i].get_macro_state(), e);
+        if (successor.known == nullptr)
+        {
+          successor.states
+              = collect_reachable_states_via_an_action(batch[i].states(), e, weak_property_cache, weak_reduction, buffer);
+          successor.known = store.find(successor.states);
+          if (successor.states.empty())
+          {
+            violation_at(i);
+          }
+        }
+      }
+    }
+  };
+
+  // Hand out small chunks, as the work per pair differs a lot.
+  const std::size_t chunk_size = 16;
+  std::atomic<std::size_t> next_chunk = 0;
+  auto worker = [&](macro_state_buffer& buffer)
+  {
+    for (std::size_t first = chunk_size * next_chunk++; first < batch.size(); first = chunk_size * next_chunk++)
+    {
+      for (std::size_t i = first; i < std::min(first + chunk_size, batch.size()); ++i)
+      {
+        calculate(i, buffer);
+      }
+    }
+  };
+
+  assert(buffers.size() >= pool.number_of_threads());
+  // Every range consists of a single worker, which takes chunks until the batch is done.
+  const std::size_t number_of_workers = std::min((batch.size() + chunk_size - 1) / chunk_size, pool.number_of_threads());
+  pool.parallel_for(number_of_workers, [&](const std::size_t begin, std::size_t)
+    {
+      worker(buffers[begin]);
+    });
+}
+
+/// \brief Explores pairs of a state and a set of states of l on the fly, starting with the pairs of a state impl and
+///        the set of states reachable from a state spec in initial_pairs, until a pair is found that violates the
+///        refinement relation.
+/// \details Pairs that are subsumed by the antichain are not explored. The transitions leading to the
+///          explored pairs are recorded in generate_counter_example, where the traces of all initial pairs start at
+///          its root. With the breadth-first strategy, the initial pairs are explored simultaneously, such that the
+///          counterexample is a shortest trace that leads to a violation from any of them.
+///          With the breadth-first strategy and more than one thread, the sets of states reached by the
+///          pairs at the front of working are calculated in parallel, after which these pairs are handled
+///          one by one in the same order as with a single thread. So the outcome and the counterexample do
+///          not depend on the number of threads.
+/// \return The counterexample index of the trace that leads to a violation, or std::nullopt if the
+///         refinement relation holds.
+template <class LTS_TYPE, class COUNTER_EXAMPLE_CONSTRUCTOR>
+std::optional<typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type> find_refinement_counter_example(const LTS_TYPE& l,
+    const lts_cache<LTS_TYPE>& weak_property_cache,
+    macro_state_store& store,
+    const std::vector<std::pair<state_type, state_type>>& initial_pairs,
+    const refinement_type refinement,
+    const bool weak_reduction,
+    const lps::exploration_strategy strategy,
+    COUNTER_EXAMPLE_CONSTRUCTOR& generate_counter_example,
+    const std::size_t number_of_threads = 1)
+{
+  using state_states_pair = state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR>;
+  std::deque<state_states_pair> working;
+  anti_chain_type anti_chain;
+  refinement_statistics<state_states_pair> stats(anti_chain, working);
+
+  // let antichain := emptyset;
+  for (const auto& [impl, spec]: initial_pairs)
+  {
+    // let working be a stack containg the triple (init1,{s|init2-->s},root_index);
+    const macro_state initial_spec
+        = store.insert(collect_reachable_states_via_taus(spec, weak_property_cache, weak_reduction));
+    if (antichain_insert(anti_chain, impl, initial_spec)) // antichain := antichain united with (impl,spec);
+                                                          // This line occurs at another place in the code than in
+                                                          // the original algorithm, where insertion in the anti-chain
+                                                          // was too late, causing too many impl-spec pairs to be
+                                                          // investigated.
+    {
+      working.emplace_back(impl, initial_spec, generate_counter_example.root_index());
+    }
+  }
+
+  // Determines whether the pair must be explored. The acceptance sets are only printed when requested, which is
+  // only done by the calling thread.
+  auto check = [&](const state_states_pair& impl_spec, const bool print_counter_example)
+  {
+    if (refinement == refinement_type::failures_divergence)
+    {
+      // if diverges(spec) and CheckDiv then the pair needs no further investigation.
+      for (state_type s : impl_spec.states())
+      {
+        if (weak_property_cache.diverges(s))
+        {
+          return refinement_pair_verdict::skip;
+        }
+      }
+
+      if (weak_property_cache.diverges(impl_spec.state())) // if impl diverges and CheckDiv
+      {
+        return refinement_pair_verdict::violation;
+      }
+    }
+
+    if (refinement == refinement_type::failures || refinement == refinement_type::failures_divergence)
+    {
+      label_type offending_action = std::size_t(-1);
+      // if refusals(impl) not contained in refusals(spec) then
+      if (!refusals_contained_in(impl_spec.state(),
+              impl_spec.states(),
+              weak_property_cache,
+              offending_action,
+              l,
+              print_counter_example && !generate_counter_example.is_dummy(),
+              generate_counter_example.is_structured()))
+      {
+        return refinement_pair_verdict::violation;
+      }
+    }
+    return refinement_pair_verdict::explore;
+  };
+
+  // Depth-first search must handle the pairs one by one, as the order of working changes after each pair.
+  const std::size_t max_batch_size
+      = strategy == lps::exploration_strategy::es_breadth && number_of_threads > 1 ? 256 * number_of_threads : 1;
+  utilities::detail::parallel_for_pool pool(max_batch_size > 1 ? number_of_threads : 1);
+  std::vector<macro_state_buffer> buffers(pool.number_of_threads());
+  std::vector<state_states_pair> batch;
+  std::vector<refinement_pair_verdict> verdicts;
+  std::vector<std::vector<macro_state_successor>> successors;
+
+  while (!working.empty()) // while working!=empty
+  {
+    stats.max_working = std::max(working.size(), stats.max_working);
+    stats.max_antichain = std::max(anti_chain.size(), stats.max_antichain);
+    const std::size_t batch_size = std::min(working.size(), max_batch_size);
+    batch.assign(working.begin(), working.begin() + batch_size);
+    working.erase(working.begin(), working.begin() + batch_size);
+    calculate_successors(batch, verdicts, successors, weak_property_cache, store, weak_reduction, buffers, pool,
+        [&](const state_states_pair& impl_spec) { return check(impl_spec, false); });
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+      // pop (impl,spec) from working;
+      const state_states_pair& impl_spec = batch[i];
+      assert(verdicts[i] != refinement_pair_verdict::unknown);
+      if (verdicts[i] == refinement_pair_verdict::skip)
+      {
+        continue;
+      }
+      if (verdicts[i] == refinement_pair_verdict::violation)
+      {
+        check(impl_spec, true); // Print the acceptance sets of the counterexample.
+        report_statistics(stats);
+        return impl_spec.counter_example_index(); // return false;
+      }
+
+      const std::vector<transition>& transitions = weak_property_cache.transitions(impl_spec.state());
+      for (std::size_t j = 0; j < transitions.size(); ++j)
+      {
+        const transition& t = transitions[j];
+        const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type new_counterexample_index
+            = generate_counter_example.add_transition(t.label(), impl_spec.counter_example_index());
+
+        macro_state_successor& successor = successors[i][j];
+        const std::size_t size = successor.known == nullptr ? successor.states.size() : successor.known->size();
+        if (size == 0) // if spec'={} then
+        {
+          report_statistics(stats);
+          return new_counterexample_index; //    return false;
+        }
+
+        // if (impl',spec') in antichain is not true then
+        ++stats.antichain_inserts;
+        macro_state spec_prime = successor.known;
+        if (spec_prime == nullptr)
+        {
+          // The set is only stored when it is added to the antichain. It may have been stored by an earlier pair.
+          spec_prime = store.find(successor.states);
+          if (spec_prime == nullptr)
+          {
+            if (antichain_include(anti_chain, t.to(), successor.states))
+            {
+              continue;
+            }
+            spec_prime = store.insert(std::move(successor.states));
+            antichain_add(anti_chain, t.to(), spec_prime);
+          }
+          else if (!antichain_insert(anti_chain, t.to(), spec_prime))
+          {
+            store.add_successor(impl_spec.get_macro_state(), weak_property_cache.hidden_label(t.label()), spec_prime);
+            continue;
+          }
+          store.add_successor(impl_spec.get_macro_state(), weak_property_cache.hidden_label(t.label()), spec_prime);
+        }
+        else if (!antichain_insert(anti_chain, t.to(), spec_prime))
+        {
+          continue;
+        }
+
+        ++stats.antichain_misses;
+        const state_states_pair impl_spec_counterex(t.to(), spec_prime, new_counterexample_index);
+        if (strategy == lps::exploration_strategy::es_breadth)
+        {
+          working.push_back(impl_spec_counterex); // add(impl,spec') at the bottom of the working;
+        }
+        else if (strategy == lps::exploration_strategy::es_depth)
+        {
+          working.push_front(impl_spec_counterex); // push(impl,spec') into working;
+        }
+      }
+    }
+  }
+
+  report_statistics(stats);
+  return std::nullopt; // return true;
+}
+
+/// \brief Explores pairs of a state and a set of states of l on the fly, starting with impl and the set of states
+///        reachable from spec, until a pair is found that violates the refinement relation.
+template <class LTS_TYPE, class COUNTER_EXAMPLE_CONSTRUCTOR>
+std::optional<typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type> find_refinement_counter_example(const LTS_TYPE& l,
+    const lts_cache<LTS_TYPE>& weak_property_cache,
+    macro_state_store& store,
+    const state_type impl,
+    const state_type spec,
+    const refinement_type refinement,
+    const bool weak_reduction,
+    const lps::exploration_strategy strategy,
+    COUNTER_EXAMPLE_CONSTRUCTOR& generate_counter_example,
+    const std::size_t number_of_threads = 1)
+{
+  return find_refinement_counter_example(l, weak_property_cache, store, {{impl, spec}}, refinement, weak_reduction,
+      strategy, generate_counter_example, number_of_threads);
+}
+
+} // namespace detail
+
 /// \brief This function checks using algorithms in the paper mentioned above
 /// whether transition system l1 is included in transition system l2, in the
 /// sense of trace inclusions, failures inclusion and divergence failures
@@ -232,6 +660,7 @@ reduce(LTS_TYPE& lts, const bool weak_reduction, const bool preserve_divergence,
 /// LTSs. \param generate_counter_example If set, a labelled transition system is generated
 ///        that can act as a counterexample. It consists of a trace, followed by
 ///        outgoing transitions representing a refusal set.
+/// \param number_of_threads The number of threads that calculate sets of states with the breadth-first strategy.
 template <class LTS_TYPE, class COUNTER_EXAMPLE_CONSTRUCTOR = detail::dummy_counter_example_constructor>
 bool destructive_refinement_checker(LTS_TYPE& l1,
     LTS_TYPE& l2,
@@ -239,7 +668,8 @@ bool destructive_refinement_checker(LTS_TYPE& l1,
     const bool weak_reduction,
     const lps::exploration_strategy strategy,
     const bool preprocess = true,
-    COUNTER_EXAMPLE_CONSTRUCTOR generate_counter_example = detail::dummy_counter_example_constructor())
+    COUNTER_EXAMPLE_CONSTRUCTOR generate_counter_example = detail::dummy_counter_example_constructor(),
+    const std::size_t number_of_threads = 1)
 {
   assert(strategy == lps::exploration_strategy::es_breadth
          || strategy == lps::exploration_strategy::es_depth); // Need a valid strategy.
@@ -278,133 +708,161 @@ bool destructive_refinement_checker(LTS_TYPE& l1,
     }
   }
 
-  std::deque<detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR>> working;
-  detail::anti_chain_type anti_chain;
-    refinement_statistics<detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR>> stats(
-      anti_chain,
-      working);
   const detail::lts_cache<LTS_TYPE> weak_property_cache(l1, weak_reduction);
+  detail::macro_state_store store;
+  const std::optional<typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type> counter_example
+      = detail::find_refinement_counter_example(l1,
+          weak_property_cache,
+          store,
+          l1.initial_state(),
+          init_l2,
+          refinement,
+          weak_reduction,
+          strategy,
+          generate_counter_example,
+          number_of_threads);
+  if (counter_example)
+  {
+    generate_counter_example.save_counter_example(*counter_example, l1);
+    return false;
+  }
+  return true;
+}
 
-    // let working be a stack containg the triple (init1,{s|init2-->s},root_index);
-    working.push_back({detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR>(l1.initial_state(),
-      detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, weak_reduction),
-      generate_counter_example.root_index())});
-
-  // let antichain := emptyset;
-    detail::antichain_insert(anti_chain,
-      working.front().state(),
-      working.front().states()); // antichain := antichain united with (impl,spec);
-                        // This line occurs at another place in the code than in
-                        // the original algorithm, where insertion in the anti-chain
-                        // was too late, causing too many impl-spec pairs to be investigated.
+namespace detail
+{
 
-  while (!working.empty()) // while working!=empty
+/// \brief Returns a formula that holds in exactly those states of l that can perform the given trace of labels.
+/// \details If weak_reduction is true, internal actions in the trace are skipped and internal actions are allowed
+///          before every action of the trace.
+template <class LTS_TYPE>
+state_formulas::state_formula trace_formula(const LTS_TYPE& l,
+    const std::vector<std::size_t>& trace,
+    const bool weak_reduction)
+{
+  const regular_formulas::regular_formula internal_action{action_formulas::multi_action(process::action_list())};
+  state_formulas::state_formula result = state_formulas::true_();
+  for (auto i = trace.rbegin(); i != trace.rend(); ++i)
   {
-    // pop (impl,spec) from working;
-    detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR>
-        impl_spec = working.front();
-    stats.max_working = std::max(working.size(), stats.max_working);
-    stats.max_antichain = std::max(anti_chain.size(), stats.max_antichain);
-    working.pop_front(); // At this point it could be checked whether impl_spec still exists in anti_chain.
-                         // Small scale experiments show that this is a little bit more expensive than doing the
-                         // explicit check below.
-
-    bool spec_diverges = false;
-    if (refinement == refinement_type::failures_divergence)
+    const std::size_t label = l.apply_hidden_label_map(*i);
+    if (l.is_tau(label))
     {
-      // Only compute when the result is required.
-      for (detail::state_type s : impl_spec.states())
+      if (!weak_reduction)
       {
-        if (weak_property_cache.diverges(s))
-        {
-          spec_diverges = true;
-          break;
-        }
+        result = state_formulas::may(internal_action, result);
       }
+      continue;
     }
 
-    // if not diverges(spec) or not CheckDiv (refinement == failures_divergence_preorder)
-    if (!spec_diverges || refinement != refinement_type::failures_divergence)
+    result = state_formulas::may(create_regular_formula(l.action_label(label)), result);
+    if (weak_reduction)
     {
-      if (weak_property_cache.diverges(impl_spec.state())
-          && refinement == refinement_type::failures_divergence) // if impl diverges and CheckDiv
-      {
-        generate_counter_example.save_counter_example(impl_spec.counter_example_index(), l1);
-        report_statistics(stats);
-        return false; // return false;
-      }
+      result = state_formulas::may(regular_formulas::trans_or_nil(internal_action), result);
+    }
+  }
+  return result;
+}
 
-      if (refinement == refinement_type::failures || refinement == refinement_type::failures_divergence)
-      {
-        detail::label_type offending_action = std::size_t(-1);
-        // if refusals(impl) not contained in refusals(spec) then
-        if (!detail::refusals_contained_in(impl_spec.state(),
-                impl_spec.states(),
-                weak_property_cache,
-                offending_action,
-                l1,
-                !generate_counter_example.is_dummy(),
-                generate_counter_example.is_structured()))
-        {
-          generate_counter_example.save_counter_example(impl_spec.counter_example_index(), l1);
-          report_statistics(stats);
-          return false; // return false;
-        }
-      }
+/// \brief Returns whether state s can perform the given trace of labels.
+/// \details If weak_reduction is true, internal actions in the trace are skipped and internal actions are allowed
+///          before and after every action of the trace.
+template <class LTS_TYPE>
+bool can_perform_trace(const lts_cache<LTS_TYPE>& weak_property_cache,
+    const state_type s,
+    const std::vector<std::size_t>& trace,
+    const bool weak_reduction)
+{
+  macro_state_buffer buffer;
+  set_of_states states = collect_reachable_states_via_taus(s, weak_property_cache, weak_reduction);
+  for (const std::size_t label: trace)
+  {
+    const label_type e = weak_property_cache.hidden_label(label);
+    if (weak_property_cache.is_tau(e) && weak_reduction)
+    {
+      continue;
+    }
+    states = collect_reachable_states_via_an_action(states, e, weak_property_cache, weak_reduction, buffer);
+    if (states.empty())
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-      for (const transition& t : weak_property_cache.transitions(impl_spec.state()))
-      {
-        const typename COUNTER_EXAMPLE_CONSTRUCTOR::index_type new_counterexample_index
-            = generate_counter_example.add_transition(t.label(), impl_spec.counter_example_index());
+} // namespace detail
 
-        detail::set_of_states spec_prime;
-        if (l1.is_tau(l1.apply_hidden_label_map(t.label())) && weak_reduction) // if e=tau then
-        {
-          spec_prime = impl_spec.states(); // spec' := spec;
-        }
-        else
-        { // spec' := {s' | exists s in spec. s-e->s'};
-          for (const detail::state_type s : impl_spec.states())
-          {
-            detail::set_of_states reachable_states_from_s_via_e = detail::collect_reachable_states_via_an_action(s,
-                l1.apply_hidden_label_map(t.label()),
-                weak_property_cache,
-                weak_reduction,
-                l1);
-            spec_prime.insert(reachable_states_from_s_via_e.begin(), reachable_states_from_s_via_e.end());
-          }
-        }
+/// \brief Checks whether l1 and l2 are (weak) trace equivalent by checking trace inclusion in both directions
+///        with the antichain algorithm for trace refinement.
+/// \details Pairs of a state and a set of states are explored on the fly and breadth-first for both directions
+///          together, such that neither LTS is determinised and the search stops at the first trace that is not
+///          shared. The merged LTS is reduced modulo strong, or if
+///          weak_reduction is set branching, bisimulation first. If the LTSs are not equivalent and
+///          generate_counter_example is set, a shortest distinguishing trace is saved to counter_example_file, or
+///          Counterexample.mcf if it is empty, as a modal formula that is true in l1 and false in l2. With
+///          structured_output the formula is printed to std::cout instead.
+template <class LTS_TYPE>
+bool destructive_trace_equivalence_checker(LTS_TYPE& l1,
+    LTS_TYPE& l2,
+    const bool weak_reduction,
+    const bool generate_counter_example,
+    const std::string& counter_example_file,
+    const bool structured_output = false)
+{
+  std::size_t init_l2 = l2.initial_state() + l1.num_states();
+  mcrl2::lts::detail::merge(l1, l2);
+  l2.clear(); // No use for l2 anymore.
 
-        if (spec_prime.empty()) // if spec'={} then
-        {
-          generate_counter_example.save_counter_example(new_counterexample_index, l1);
-          report_statistics(stats);
-          return false; //    return false;
-        }
-        
-        // if (impl',spec') in antichain is not true then
-        ++stats.antichain_inserts;
-        const detail::state_states_counter_example_index_triple<COUNTER_EXAMPLE_CONSTRUCTOR> impl_spec_counterex(t.to(),
-            spec_prime,
-            new_counterexample_index);
-        if (detail::antichain_insert(anti_chain, t.to(), spec_prime))
-        {
-          ++stats.antichain_misses;
-          if (strategy == lps::exploration_strategy::es_breadth)
-          {
-            working.push_back(impl_spec_counterex); // add(impl,spec') at the bottom of the working;
-          }
-          else if (strategy == lps::exploration_strategy::es_depth)
-          {
-            working.push_front(impl_spec_counterex); // push(impl,spec') into working;
-          }
-        }
-      }
-    }
+  bool initial_equal = false;
+  std::tie(init_l2, initial_equal) = reduce(l1, weak_reduction, false, init_l2);
+  if (initial_equal)
+  {
+    mCRL2log(log::verbose) << "The two LTSs are" << (weak_reduction ? " branching" : "")
+                           << " bisimilar, so there is no need to check trace equivalence.\n";
+    return true;
   }
 
-  report_statistics(stats);
-return true;
+  // Both inclusions are checked in a single breadth-first search, such that the counterexample is a shortest
+  // trace that distinguishes the LTSs.
+  const detail::lts_cache<LTS_TYPE> weak_property_cache(l1, weak_reduction);
+  detail::macro_state_store store;
+  const std::vector<std::pair<detail::state_type, detail::state_type>> initial_pairs
+      = {{l1.initial_state(), init_l2}, {init_l2, l1.initial_state()}};
+  if (!generate_counter_example)
+  {
+    detail::dummy_counter_example_constructor dummy;
+    return !detail::find_refinement_counter_example(l1, weak_property_cache, store, initial_pairs,
+        refinement_type::trace, weak_reduction, lps::exploration_strategy::es_breadth, dummy);
+  }
+
+  detail::counter_example_constructor cec("", counter_example_file, structured_output);
+  const std::optional<detail::counter_example_constructor::index_type> counter_example
+      = detail::find_refinement_counter_example(l1, weak_property_cache, store, initial_pairs,
+          refinement_type::trace, weak_reduction, lps::exploration_strategy::es_breadth, cec);
+  if (!counter_example)
+  {
+    return true;
+  }
+
+  // The trace can be done by exactly one of the LTSs. If l1 cannot do it, the formula is turned around by a negation.
+  const std::vector<std::size_t> trace = cec.get_label_indices(*counter_example);
+  state_formulas::state_formula formula = detail::trace_formula(l1, trace, weak_reduction);
+  if (!detail::can_perform_trace(weak_property_cache, l1.initial_state(), trace, weak_reduction))
+  {
+    formula = state_formulas::not_(formula);
+  }
+
+  if (structured_output)
+  {
+    std::cout << "counterexample: " << state_formulas::pp(formula) << std::endl;
+    return false;
+  }
+
+  const std::string filename = counter_example_file.empty() ? "Counterexample.mcf" : counter_example_file;
+  std::ofstream counter_file(filename);
+  counter_file << state_formulas::pp(formula);
+  mCRL2log(log::info) << "Saved counterexample to: \"" << filename << "\"" << std::endl;
+  return false;
 }
 
 namespace detail
@@ -451,32 +909,94 @@ set_of_states collect_reachable_states_via_taus(const state_type s,
   return collect_reachable_states_via_taus(set_with_s, weak_property_cache, weak_reduction);
 }
 
+/* This function calculates the set of states {s' | exists s in spec. s -e-> s'}, extended with all states that
+   are reachable from these states by internal transitions if weak_reduction is true. In the latter case spec must
+   be closed under internal transitions, which holds for all sets of states that are explored. Only the
+   weak_property_cache is used, so that several threads can calculate sets of states at the same time, each with
+   its own buffer.
+*/
 template <class LTS_TYPE>
-set_of_states collect_reachable_states_via_an_action(const state_type s,
+set_of_states collect_reachable_states_via_an_action(const set_of_states& spec,
     const label_type e, // This is already the hidden action.
     const lts_cache<LTS_TYPE>& weak_property_cache,
     const bool weak_reduction,
-    const LTS_TYPE& l)
+    macro_state_buffer& buffer)
 {
-  const set_of_states set_before_action_e = collect_reachable_states_via_taus(s, weak_property_cache, weak_reduction);
-  set_of_states states_reachable_via_e;
-  for (const state_type s : set_before_action_e)
+  std::vector<state_type>& states = buffer.states;
+  std::vector<bool>& visited = buffer.visited;
+  states.clear();
+  visited.resize(weak_property_cache.num_states(), false);
+
+  auto add = [&](const state_type s)
+  {
+    if (!visited[s])
+    {
+      visited[s] = true;
+      states.push_back(s);
+    }
+  };
+
+  for (const state_type s : spec)
   {
     for (const transition& t : weak_property_cache.transitions(s))
     {
-              if (l.apply_hidden_label_map(t.label()) == e)
-        {
-          assert(set_before_action_e.count(t.from()) > 0);
-          states_reachable_via_e.insert(t.to());
-              }
+      if (weak_property_cache.hidden_label(t.label()) == e)
+      {
+        add(t.to());
+      }
     }
   }
-  return collect_reachable_states_via_taus(states_reachable_via_e, weak_property_cache, weak_reduction);
+
+  if (weak_reduction)
+  {
+    // The states vector grows while it is traversed.
+    for (std::size_t i = 0; i < states.size(); ++i)
+    {
+      for (const state_type s : weak_property_cache.tau_reachable_states(states[i]))
+      {
+        add(s);
+      }
+    }
+  }
+
+  for (const state_type s : states)
+  {
+    visited[s] = false;
+  }
+  std::sort(states.begin(), states.end());
+  return set_of_states(boost::container::ordered_unique_range, states.begin(), states.end());
+}
+
+/* This function returns the stored macro state reached from spec by the hidden action e, which is not an internal
+   action if weak_reduction is true. If these states are not stored, nullptr is returned and the states are put in
+   states, such that the caller can decide whether they must be stored. The successors of macro states are cached
+   in the store.
+*/
+template <class LTS_TYPE>
+macro_state find_reachable_macro_state_via_an_action(macro_state_store& store,
+    const macro_state spec,
+    const label_type e,
+    const lts_cache<LTS_TYPE>& weak_property_cache,
+    const bool weak_reduction,
+    set_of_states& states,
+    macro_state_buffer& buffer)
+{
+  macro_state result = store.find_successor(spec, e);
+  if (result == nullptr)
+  {
+    states = collect_reachable_states_via_an_action(*spec, e, weak_property_cache, weak_reduction, buffer);
+    result = store.find(states);
+    if (result != nullptr)
+    {
+      store.add_successor(spec, e, result);
+    }
+  }
+  return result;
 }
 
 inline bool antichain_include(anti_chain_type& anti_chain,
   const detail::state_type& impl,
-  const detail::set_of_states& spec)
+  const detail::macro_state spec)
 {
   // First check whether there is a set in the antichain for impl_spec.state() which is smaller than impl_spec.states().
   // If so, impl_spec.states() is included in the antichain.
@@ -484,8 +1004,27 @@ inline bool antichain_include(anti_chain_type& anti_chain,
        i != anti_chain.upper_bound(impl);
        ++i)
   {
-    const set_of_states s = i->second;
+    const set_of_states& s = *i->second;
     // If s is included in impl_spec.states()
+    if (i->second == spec || std::includes(spec->begin(), spec->end(), s.begin(), s.end()))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+inline bool antichain_include(const anti_chain_type& anti_chain,
+  const detail::state_type& impl,
+  const set_of_states& spec)
+{
+  // As spec is not stored, it is not equal to a set in the antichain, which are all stored.
+  for (anti_chain_type::const_iterator i = anti_chain.lower_bound(impl);
+       i != anti_chain.upper_bound(impl);
+       ++i)
+  {
+    const set_of_states& s = *i->second;
     if (std::includes(spec.begin(), spec.end(), s.begin(), s.end()))
     {
       return true;
@@ -497,7 +1036,7 @@ inline bool antichain_include(anti_chain_type& anti_chain,
 
 inline bool antichain_include_inverse(anti_chain_type& anti_chain,
   const detail::state_type& impl,
-  const detail::set_of_states& spec)
+  const detail::macro_state spec)
 {
   // First check whether there is a set in the antichain for impl_spec.state() which is smaller than impl_spec.states().
   // If so, impl_spec.states() is included in the antichain.
@@ -505,9 +1044,9 @@ inline bool antichain_include_inverse(anti_chain_type& anti_chain,
        i != anti_chain.upper_bound(impl);
        ++i)
   {
-    const set_of_states s = i->second;
+    const set_of_states& s = *i->second;
     // If s is included in impl_spec.states()
-    if (std::includes(s.begin(), s.end(), spec.begin(), spec.end()))
+    if (i->second == spec || std::includes(s.begin(), s.end(), spec->begin(), spec->end()))
     {
       return true;
     }
@@ -528,21 +1067,31 @@ inline bool antichain_include_inverse(anti_chain_type& anti_chain,
  */
 inline bool antichain_insert(anti_chain_type& anti_chain,
   const detail::state_type& impl,
-  const detail::set_of_states& spec)
+  const detail::macro_state spec)
 {
   if (antichain_include(anti_chain, impl, spec))
   {
     return false;
   }
+  antichain_add(anti_chain, impl, spec);
+  return true;
+}
 
+/* This function inserts <impl, spec> in the anti_chain, where spec is not included in the antichain. All sets
+   associated to impl that are a superset of spec are removed.
+ */
+inline void antichain_add(anti_chain_type& anti_chain,
+  const detail::state_type& impl,
+  const detail::macro_state spec)
+{
   // Here impl_spec.states() must be inserted in the antichain. Moreover, all sets in the antichain that
   // are a superset of impl_spec.states() must be removed.
   for (anti_chain_type::iterator i = anti_chain.lower_bound(impl);
        i != anti_chain.upper_bound(impl);)
   {
-    const set_of_states s = i->second;
+    const set_of_states& s = *i->second;
     // if s is a superset of impl_spec.states()
-    if (std::includes(s.begin(), s.end(), spec.begin(), spec.end()))
+    if (std::includes(s.begin(), s.end(), spec->begin(), spec->end()))
     {
       // set s must be removed.
       i = anti_chain.erase(i);
@@ -553,65 +1102,6 @@ inline bool antichain_insert(anti_chain_type& anti_chain,
     }
   }
   anti_chain.emplace(impl, spec);
-  return true;
-}
-
-/* Calculate the states that are stable and reachable through tau-steps */
-template <class LTS_TYPE>
-const set_of_states& calculate_tau_reachable_states(const set_of_states& states,
-    const lts_cache<LTS_TYPE>& weak_property_cache)
-{
-  static std::map<set_of_states, set_of_states> cache;
-  const std::map<set_of_states, set_of_states>::const_iterator i = cache.find(states);
-  if (i != cache.end())
-  {
-    return i->second;
-  }
-
-  static set_of_states visited;
-  assert(visited.empty());
-  static std::stack<state_type> todo_stack;
-  assert(todo_stack.empty());
-  set_of_states result;
-
-  for (const state_type s : states)
-  {
-    if (weak_property_cache.stable(s))
-    {
-      // Put the outgoing action labels in a set and put these in the result.
-      result.insert(s);
-    }
-    else
-    {
-      visited.insert(s);
-      todo_stack.push(s);
-    }
-  }
-
-  while (todo_stack.size() > 0)
-  {
-    const state_type current_state = todo_stack.top();
-    todo_stack.pop();
-    // Consider the states reachable in one tau step.
-    for (const state_type s : weak_property_cache.tau_reachable_states(current_state))
-    {
-      if (weak_property_cache.stable(s))
-      {
-        // Put the outgoing action labels in a set and put these in the result.
-        result.insert(s);
-      }
-      else
-      {
-        if (visited.insert(s).second) // t.to() is a new state.
-        {
-          todo_stack.push(s);
-        }
-      }
-    }
-  }
-  cache[states] = result;
-  visited.clear();
-  return cache[states];
 }
 
 /// \brief This function checks that the refusals(impl) are contained in the refusals of spec, where
@@ -29,7 +29,7 @@ std::ostream& operator<<(std::ostream& out, const detail::anti_chain_type& a)
   for (const auto& [impl, spec] : a)
   {
     out << "  (" << impl << ", {";
-    for (const auto& s : spec)
+    for (const auto& s : *spec)
     {
       out << ", " << s;
     }
@@ -48,6 +48,8 @@ std::pair<bool, trace> check_trace_inclusion(LTS_TYPE& l1,
     detail::anti_chain_type& anti_chain,
     detail::anti_chain_type& anti_chain_positive,
     detail::anti_chain_type& anti_chain_negative,
+    detail::macro_state_store& store,
+    detail::macro_state_buffer& buffer,
     detail::state_type init_l1,
     detail::state_type init_l2,
     bool weak_reduction,
@@ -59,14 +61,14 @@ std::pair<bool, trace> check_trace_inclusion(LTS_TYPE& l1,
   // let working be a stack containg the triple (init1,{s|init2-->s},root_index);
   working.clear();
   working.push_back({state_type_if(init_l1,
-      detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, weak_reduction),
+      store.insert(detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, weak_reduction)),
       generate_counter_example.root_index())});
 
   // let antichain := emptyset;
   anti_chain.clear();
   detail::antichain_insert(anti_chain,
       working.front().state(),
-      working.front().states()); // antichain := antichain united with (impl,spec);
+      working.front().get_macro_state()); // antichain := antichain united with (impl,spec);
                                  // This line occurs at another place in the code than in
                                  // the original algorithm, where insertion in the anti-chain
                                  // was too late, causing too many impl-spec pairs to be investigated.
@@ -92,7 +94,7 @@ std::pair<bool, trace> check_trace_inclusion(LTS_TYPE& l1,
     mCRL2log(log::trace) << "check_trace_inclusion(): positive_antichain = " << anti_chain_positive << std::endl;
     mCRL2log(log::trace) << "check_trace_inclusion(): negative_antichain = " << anti_chain_negative << std::endl;
 
-    if (!enable_counter_example && detail::antichain_include_inverse(anti_chain_negative, impl_spec.state(), impl_spec.states()))
+    if (!enable_counter_example && detail::antichain_include_inverse(anti_chain_negative, impl_spec.state(), impl_spec.get_macro_state()))
     {
       mCRL2log(log::trace) << "check_trace_inclusion(): Found in negative antichain\n";
       return std::make_pair(false,
@@ -105,36 +107,32 @@ std::pair<bool, trace> check_trace_inclusion(LTS_TYPE& l1,
       const typename detail::counter_example_constructor::index_type new_counterexample_index
           = generate_counter_example.add_transition(t.label(), impl_spec.counter_example_index());
 
-      detail::set_of_states spec_prime;
-      if (l1.is_tau(l1.apply_hidden_label_map(t.label())) && weak_reduction) // if e=tau then
-      {
-        spec_prime = impl_spec.states(); // spec' := spec;
-      }
-      else
+      detail::macro_state spec_prime = impl_spec.get_macro_state(); // spec' := spec;
+      detail::set_of_states states_prime;
+      if (!weak_property_cache.is_tau(weak_property_cache.hidden_label(t.label())) || !weak_reduction) // if e!=tau then
       { // spec' := {s' | exists s in spec. s-e->s'};
-        for (const auto& s : impl_spec.states())
-        {
-          detail::set_of_states reachable_states_from_s_via_e = detail::collect_reachable_states_via_an_action(s,
-              l1.apply_hidden_label_map(t.label()),
-              weak_property_cache,
-              weak_reduction,
-              l1);
-          spec_prime.insert(reachable_states_from_s_via_e.begin(), reachable_states_from_s_via_e.end());
-        }
+        spec_prime = detail::find_reachable_macro_state_via_an_action(store,
+            impl_spec.get_macro_state(),
+            weak_property_cache.hidden_label(t.label()),
+            weak_property_cache,
+            weak_reduction,
+            states_prime,
+            buffer);
       }
+      const detail::set_of_states& states = spec_prime == nullptr ? states_prime : *spec_prime;
 
-      if (spec_prime.empty()) // if spec'={} then
+      if (states.empty()) // if spec'={} then
       {
         detail::antichain_insert(anti_chain_negative,
             init_l1,
-            detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, weak_reduction));
+            store.insert(detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, weak_reduction)));
         mCRL2log(log::debug) << "check_trace_inclusion(): spec_prime is empty\n";
         return std::make_pair(false,
             generate_counter_example.get_trace(l1, new_counterexample_index)); //    return false;
       }
       
       mCRL2log(log::trace) << "check_trace_inclusion(): spec_prime = {";
-      for (const auto& state : spec_prime) 
+      for (const auto& state : states) 
       {
         mCRL2log(log::trace) << ", " << state;
       }
@@ -143,10 +141,28 @@ std::pair<bool, trace> check_trace_inclusion(LTS_TYPE& l1,
 
       // if (impl',spec') in antichain is not true then
       ++stats.antichain_inserts;
-      const state_type_if impl_spec_counterex(t.to(), spec_prime, new_counterexample_index);
-      if (!detail::antichain_include(anti_chain_positive, t.to(), spec_prime)
-          && detail::antichain_insert(anti_chain, t.to(), spec_prime))
+      bool added = false;
+      if (spec_prime == nullptr)
+      {
+        // The set is only stored when it is added to the antichain.
+        if (!detail::antichain_include(anti_chain_positive, t.to(), states_prime)
+            && !detail::antichain_include(anti_chain, t.to(), states_prime))
+        {
+          spec_prime = store.insert(std::move(states_prime));
+          store.add_successor(impl_spec.get_macro_state(), weak_property_cache.hidden_label(t.label()), spec_prime);
+          detail::antichain_add(anti_chain, t.to(), spec_prime);
+          added = true;
+        }
+      }
+      else
       {
+        added = !detail::antichain_include(anti_chain_positive, t.to(), spec_prime)
+                && detail::antichain_insert(anti_chain, t.to(), spec_prime);
+      }
+
+      if (added)
+      {
+        const state_type_if impl_spec_counterex(t.to(), spec_prime, new_counterexample_index);
         mCRL2log(log::trace) << "check_trace_inclusion(): Added to working\n";
         ++stats.antichain_misses;
         if (strategy == lps::exploration_strategy::es_breadth)
@@ -339,17 +355,19 @@ bool destructive_impossible_futures(LTS& l1,
   mcrl2::lts::detail::merge(l1, l2);
 
   const detail::lts_cache<LTS> weak_property_cache(l1, true);
+  detail::macro_state_store store;
+  detail::macro_state_buffer buffer;
 
   // The name and output are not used anyway.
   detail::counter_example_constructor ce_constructor("impossible_futures", counter_example_file, structured_output);
 
   std::deque<state_type_if> working = std::deque({state_type_if(l1.initial_state(),
-      detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, true),
+      store.insert(detail::collect_reachable_states_via_taus(init_l2, weak_property_cache, true)),
       ce_constructor.root_index())});
   detail::anti_chain_type anti_chain;
   detail::antichain_insert(anti_chain,
       working.front().state(),
-      working.front().states()); // antichain := antichain united with (impl,spec);
+      working.front().get_macro_state()); // antichain := antichain united with (impl,spec);
   refinement_statistics<state_type_if> stats(anti_chain, working);
 
   // Used for the weak trace refinement checks
@@ -392,6 +410,8 @@ bool destructive_impossible_futures(LTS& l1,
                   inner_anti_chain,
                   positive_anti_chain,
                   negative_anti_chain,
+                  store,
+                  buffer,
                   t,
                   impl,
                   true,
@@ -441,25 +461,21 @@ bool destructive_impossible_futures(LTS& l1,
 
       mCRL2log(log::trace) << "Taking transition: " << l1.action_label(t.label()) << " from " << impl << " to " << t.to() << std::endl;
 
-      detail::set_of_states spec_prime;
-      if (l1.is_tau(l1.apply_hidden_label_map(t.label())))
+      detail::macro_state spec_prime = front.get_macro_state();
+      detail::set_of_states states_prime;
+      if (!weak_property_cache.is_tau(weak_property_cache.hidden_label(t.label())))
       {
-        spec_prime = spec;
-      }
-      else
-      {
-        for (const detail::state_type& s : spec)
-        {
-          detail::set_of_states reachable_states_from_s_via_e = detail::collect_reachable_states_via_an_action(s,
-              l1.apply_hidden_label_map(t.label()),
-              weak_property_cache,
-              true,
-              l1);
-          spec_prime.insert(reachable_states_from_s_via_e.begin(), reachable_states_from_s_via_e.end());
-        }
+        spec_prime = detail::find_reachable_macro_state_via_an_action(store,
+            front.get_macro_state(),
+            weak_property_cache.hidden_label(t.label()),
+            weak_property_cache,
+            true,
+            states_prime,
+            buffer);
       }
+      const detail::set_of_states& states = spec_prime == nullptr ? states_prime : *spec_prime;
 
-      if (spec_prime.empty())
+      if (states.empty())
       {
         if (generate_counter_example)
         {
@@ -490,20 +506,36 @@ bool destructive_impossible_futures(LTS& l1,
       }
 
       mCRL2log(log::trace) << "spec_prime = {";
-      for (const auto& state : spec_prime) 
+      for (const auto& state : states) 
       {
         mCRL2log(log::trace) << ", " << state;
       }
       mCRL2log(log::trace)  << "}\n";
 
-      state_states_counter_example_index_triple<counter_example_constructor> impl_spec_counterex
-          = detail::state_states_counter_example_index_triple<detail::counter_example_constructor>(t.to(),
-              spec_prime,
-              new_counterexample_index);
-
       ++stats.antichain_inserts;
-      if (detail::antichain_insert(anti_chain, t.to(), spec_prime))
+      bool added = false;
+      if (spec_prime == nullptr)
+      {
+        // The set is only stored when it is added to the antichain.
+        if (!detail::antichain_include(anti_chain, t.to(), states_prime))
+        {
+          spec_prime = store.insert(std::move(states_prime));
+          store.add_successor(front.get_macro_state(), weak_property_cache.hidden_label(t.label()), spec_prime);
+          detail::antichain_add(anti_chain, t.to(), spec_prime);
+          added = true;
+        }
+      }
+      else
+      {
+        added = detail::antichain_insert(anti_chain, t.to(), spec_prime);
+      }
+
+      if (added)
       {
+        state_states_counter_example_index_triple<counter_example_constructor> impl_spec_counterex
+            = detail::state_states_counter_example_index_triple<detail::counter_example_constructor>(t.to(),
+                spec_prime,
+                new_counterexample_index);
         mCRL2log(log::trace) << "Added to working\n";
         ++stats.antichain_misses;
         if (strategy == lps::exploration_strategy::es_breadth)
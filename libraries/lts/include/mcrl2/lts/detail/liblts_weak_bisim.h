@@ -7,23 +7,436 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 //
 /// \file lts/detail/liblts_weak_bisim.h
-/// \brief This file defines an algorithm for weak bisimulation, by
-///        calculating the transitive tau closure and apply strong
-///        bisimulation afterwards. In order to apply this algorithm
-///        it is advisable to first apply a branching bisimulation reduction.
+/// \brief This file defines an algorithm for weak bisimulation. It first applies
+///        a branching bisimulation reduction, and subsequently refines a partition
+///        using weak signatures that are calculated on the fly, such that the
+///        transitive tau closure is never stored.
 
 #ifndef MCRL2_LTS_WEAK_BISIM_H
 #define MCRL2_LTS_WEAK_BISIM_H
+#include <numeric>
+#include <unordered_map>
 #include "mcrl2/lts/detail/liblts_scc.h"
 #include "mcrl2/lts/detail/liblts_tau_star_reduce.h"
 #include "mcrl2/lts/detail/liblts_merge.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/lts_dot.h"
+#include "mcrl2/utilities/hash_utility.h"
 
 namespace mcrl2::lts::detail
 {
 
+/** \brief Calculates weak bisimulation without saturating the transition system.
+ *  \details A state s has a weak signature consisting of the pairs (tau, B) such that s -tau*-> t for some t in
+ *           block B, and the pairs (a, B) for visible actions a such that s -tau*-> -a-> -tau*-> t for some t in B.
+ *           The signature of a state is calculated on the fly by a search along the tau transitions, and is only
+ *           stored when it is the first signature of a new block. Hence the required memory is linear in the size
+ *           of the transition system and the number of distinct signatures, instead of the size of its transitive tau
+ *           closure. The coarsest partition in which all states in a block have the same signature is weak
+ *           bisimulation, as it is strong bisimulation on the saturated transition system.
+ *
+ *           It is advisable to first apply branching bisimulation, as the number of states that is visited to
+ *           calculate a signature is determined by the length of tau paths. */
+template <class LTS_TYPE>
+class weak_bisim_partitioner
+{
+  public:
+    /** \brief Creates a weak bisimulation partitioner for an LTS.
+     *  \details The partition is calculated in the constructor. */
+    explicit weak_bisim_partitioner(LTS_TYPE& l);
+
+    /** \brief Replaces the transition system by its quotient.
+     *  \details The result is the quotient of the saturated transition system modulo weak bisimulation, without tau
+     *           loops and without the transitions s -a-> s' for which also s -a-> -tau-> s' or s -tau-> -a-> s' is
+     *           present. This is the result of applying strong bisimulation to the transitive tau closure, followed
+     *           by scc_reduce and remove_redundant_transitions. */
+    void replace_transition_system();
+
+    /** \brief Gives the number of weak bisimulation equivalence classes of the LTS. */
+    std::size_t num_eq_classes() const;
+
+    /** \brief Gives the equivalence class number of a state. */
+    std::size_t get_eq_class(std::size_t s) const;
+
+    /** \brief Returns whether two states are in the same weak bisimulation equivalence class. */
+    bool in_same_class(std::size_t s, std::size_t t) const;
+
+  private:
+    using state_type = std::size_t;
+    using label_type = std::size_t;
+
+    /// \brief An element (label, block, redundant) of a signature. The flag redundant is only used for the quotient.
+    using signature_element = std::tuple<label_type, std::size_t, bool>;
+
+    struct signature_hash
+    {
+      std::size_t operator()(const std::vector<std::size_t>& key) const
+      {
+        std::size_t hash = key.size();
+        for (std::size_t x: key)
+        {
+          hash = utilities::detail::hash_combine(hash, x);
+        }
+        return hash;
+      }
+    };
+
+    LTS_TYPE& m_lts;
+    outgoing_transitions_per_state_t m_outgoing_transitions;
+    outgoing_transitions_per_state_t m_incoming_transitions;
+    std::vector<std::size_t> m_block;
+    std::size_t m_number_of_blocks = 1;
+
+    // The signature of the states in a block, without the block itself, and the number of states in a block.
+    std::vector<std::vector<std::size_t>> m_block_signature;
+    std::vector<std::size_t> m_block_size;
+
+    // Scratch space for the searches. A pair (s, flag) is visited iff m_visited[2*s+flag]==m_stamp, which avoids
+    // clearing m_visited for every search.
+    std::vector<std::size_t> m_visited;
+    std::size_t m_stamp = 0;
+    std::vector<std::pair<state_type, bool>> m_todo;
+    std::vector<std::tuple<label_type, state_type, bool>> m_visible_steps;
+
+    bool is_tau(label_type l) const
+    {
+      return m_lts.is_tau(m_lts.apply_hidden_label_map(l));
+    }
+
+    void visit(state_type s, bool flag)
+    {
+      // A state with a true flag does not need to be visited with a false flag.
+      if (m_visited[2*s+1] == m_stamp || (!flag && m_visited[2*s] == m_stamp))
+      {
+        return;
+      }
+      m_visited[2*s+flag] = m_stamp;
+      m_todo.emplace_back(s, flag);
+    }
+
+    // Calls found(t, flag) for all states t that are reachable by tau transitions from m_todo. The flag of a state y
+    // that is reached by x -tau-> y is the flag of x or set_flag(x, y).
+    template <typename SetFlag, typename Found>
+    void tau_search(SetFlag set_flag, Found found)
+    {
+      while (!m_todo.empty())
+      {
+        const auto [x, flag] = m_todo.back();
+        m_todo.pop_back();
+        found(x, flag);
+        for (std::size_t i = m_outgoing_transitions.lowerbound(x); i < m_outgoing_transitions.upperbound(x); ++i)
+        {
+          const outgoing_pair_t& t = m_outgoing_transitions.get_transitions()[i];
+          if (is_tau(label(t)))
+          {
+            visit(to(t), flag || set_flag(x, to(t)));
+          }
+        }
+      }
+    }
+
+    // Calculates the weak signature of s in result, sorted and without duplicates. If mark_redundant is true, the
+    // flag of (tau, C) indicates that it is also reached by s -tau*-> u -tau*-> t with u in a third block D, i.e.,
+    // B -tau-> D -tau-> C in the saturated quotient, where B is the block of s. The flag of (a, C) indicates that
+    // B -tau-> D -a-> C or B -a-> D -tau-> C for some block D different from B respectively C.
+    void weak_signature(state_type s, bool mark_redundant, std::vector<signature_element>& result)
+    {
+      const std::size_t B = m_block[s];
+      result.clear();
+      m_visible_steps.clear();
+
+      ++m_stamp;
+      visit(s, false);
+      tau_search(
+        [&](state_type x, state_type y) { return mark_redundant && m_block[x] != m_block[y] && m_block[x] != B; },
+        [&](state_type u, bool flag)
+        {
+          result.emplace_back(m_lts.tau_label_index(), m_block[u], flag);
+          if (flag && m_visited[2*u] == m_stamp)
+          {
+            return; // The visible steps of u have already been gathered.
+          }
+          for (std::size_t i = m_outgoing_transitions.lowerbound(u); i < m_outgoing_transitions.upperbound(u); ++i)
+          {
+            const outgoing_pair_t& t = m_outgoing_transitions.get_transitions()[i];
+            if (!is_tau(label(t)))
+            {
+              m_visible_steps.emplace_back(m_lts.apply_hidden_label_map(label(t)), to(t), mark_redundant && m_block[u] != B);
+            }
+          }
+        });
+
+      // Search from the targets of all visible steps with the same label at once.
+      std::sort(m_visible_steps.begin(), m_visible_steps.end());
+      for (std::size_t i = 0; i < m_visible_steps.size(); )
+      {
+        const label_type a = std::get<0>(m_visible_steps[i]);
+        ++m_stamp;
+        for (; i < m_visible_steps.size() && std::get<0>(m_visible_steps[i]) == a; ++i)
+        {
+          visit(std::get<1>(m_visible_steps[i]), std::get<2>(m_visible_steps[i]));
+        }
+        tau_search(
+          [&](state_type x, state_type y) { return mark_redundant && m_block[x] != m_block[y]; },
+          [&](state_type t, bool flag) { result.emplace_back(a, m_block[t], flag); });
+      }
+
+      std::sort(result.begin(), result.end());
+      result.erase(std::unique(result.begin(), result.end()), result.end());
+    }
+
+    // Adds all states from which a state in m_todo is reached by tau* or by tau* a tau* to dirty, where the flag of a
+    // pair in m_todo indicates that the visible step has been taken.
+    void backward_search(std::vector<bool>& is_dirty, std::vector<state_type>& dirty)
+    {
+      const auto visit_backward = [&](state_type s, bool flag)
+        {
+          // A state with a false flag does not need to be visited with a true flag.
+          if (m_visited[2*s] == m_stamp || (flag && m_visited[2*s+1] == m_stamp))
+          {
+            return;
+          }
+          m_visited[2*s+flag] = m_stamp;
+          m_todo.emplace_back(s, flag);
+        };
+
+      while (!m_todo.empty())
+      {
+        const auto [x, flag] = m_todo.back();
+        m_todo.pop_back();
+        if (!is_dirty[x])
+        {
+          is_dirty[x] = true;
+          dirty.push_back(x);
+        }
+        for (std::size_t i = m_incoming_transitions.lowerbound(x); i < m_incoming_transitions.upperbound(x); ++i)
+        {
+          // For incoming transitions to(t) is the source of the transition.
+          const outgoing_pair_t& t = m_incoming_transitions.get_transitions()[i];
+          if (is_tau(label(t)))
+          {
+            visit_backward(to(t), flag);
+          }
+          else if (!flag)
+          {
+            visit_backward(to(t), true);
+          }
+        }
+      }
+    }
+
+    // Refines the partition until all states in a block have the same weak signature. Only the signatures of dirty
+    // states are calculated, which are the states that reach a state that moved to another block in the previous
+    // round. The other states of a block keep the signature that is stored for the block, as the blocks of the
+    // states that they reach have not changed. The states with a signature that differs from the stored signature
+    // move to new blocks, such that the numbers of the blocks that do not split remain the same.
+    void refine()
+    {
+      std::vector<signature_element> signature;
+      std::vector<state_type> dirty(m_lts.num_states());
+      std::iota(dirty.begin(), dirty.end(), 0);
+      std::vector<bool> is_dirty(m_lts.num_states(), true);
+      std::vector<std::pair<state_type, std::size_t>> moves;
+      m_block_signature.assign(1, std::vector<std::size_t>());
+      m_block_size.assign(1, m_lts.num_states());
+
+      while (!dirty.empty())
+      {
+        std::sort(dirty.begin(), dirty.end(),
+          [&](state_type s, state_type t) { return std::make_pair(m_block[s], s) < std::make_pair(m_block[t], t); });
+
+        moves.clear();
+        for (std::size_t i = 0; i < dirty.size(); )
+        {
+          // Group the dirty states of block B by their signature.
+          const std::size_t B = m_block[dirty[i]];
+          std::unordered_map<std::vector<std::size_t>, std::size_t, signature_hash> group_index;
+          std::vector<std::vector<state_type>> groups;
+          std::vector<const std::vector<std::size_t>*> keys;
+          std::size_t count = 0;
+          for (; i < dirty.size() && m_block[dirty[i]] == B; ++i, ++count)
+          {
+            weak_signature(dirty[i], false, signature);
+            std::vector<std::size_t> key;
+            key.reserve(2 * signature.size());
+            for (const signature_element& e: signature)
+            {
+              key.push_back(std::get<0>(e));
+              key.push_back(std::get<1>(e));
+            }
+            const auto [g, inserted] = group_index.try_emplace(std::move(key), groups.size());
+            if (inserted)
+            {
+              groups.emplace_back();
+              keys.push_back(&g->first);
+            }
+            groups[g->second].push_back(dirty[i]);
+          }
+
+          // The group that stays in B is the one with the signature of the states that are not dirty, or the
+          // largest group if all states of B are dirty.
+          std::size_t stays = groups.size();
+          if (count < m_block_size[B])
+          {
+            const auto g = group_index.find(m_block_signature[B]);
+            if (g != group_index.end())
+            {
+              stays = g->second;
+            }
+          }
+          else
+          {
+            stays = 0;
+            for (std::size_t g = 1; g < groups.size(); ++g)
+            {
+              if (groups[g].size() > groups[stays].size())
+              {
+                stays = g;
+              }
+            }
+            m_block_signature[B] = *keys[stays];
+          }
+
+          for (std::size_t g = 0; g < groups.size(); ++g)
+          {
+            if (g != stays)
+            {
+              const std::size_t new_block = m_block_signature.size();
+              m_block_signature.push_back(*keys[g]);
+              m_block_size.push_back(groups[g].size());
+              m_block_size[B] -= groups[g].size();
+              for (state_type s: groups[g])
+              {
+                moves.emplace_back(s, new_block);
+              }
+            }
+          }
+        }
+
+        for (state_type s: dirty)
+        {
+          is_dirty[s] = false;
+        }
+        dirty.clear();
+
+        // The states that moved change the signatures of the states that reach them.
+        ++m_stamp;
+        for (const auto& [s, new_block]: moves)
+        {
+          m_block[s] = new_block;
+          if (m_visited[2*s] != m_stamp)
+          {
+            m_visited[2*s] = m_stamp;
+            m_todo.emplace_back(s, false);
+          }
+        }
+        backward_search(is_dirty, dirty);
+
+        m_number_of_blocks = m_block_signature.size();
+        mCRL2log(log::debug) << "Weak bisimulation partition refined to " << m_number_of_blocks << " blocks, "
+                             << dirty.size() << " states must be reconsidered.\n";
+      }
+
+      // The signatures are only needed during the refinement.
+      m_block_signature = std::vector<std::vector<std::size_t>>();
+      m_block_size = std::vector<std::size_t>();
+    }
+};
+
+
+template <class LTS_TYPE>
+weak_bisim_partitioner<LTS_TYPE>::weak_bisim_partitioner(LTS_TYPE& l)
+ : m_lts(l),
+   m_outgoing_transitions(l.get_transitions(), l.num_states(), true),
+   m_incoming_transitions(l.get_transitions(), l.num_states(), false),
+   m_block(l.num_states(), 0),
+   m_visited(2 * l.num_states(), 0)
+{
+  refine();
+}
+
+template <class LTS_TYPE>
+void weak_bisim_partitioner<LTS_TYPE>::replace_transition_system()
+{
+  // Every block is represented by its first state, as all its states have the same signature.
+  constexpr std::size_t undefined = -1;
+  std::vector<state_type> representative(m_number_of_blocks, undefined);
+  for (state_type s = 0; s < m_lts.num_states(); ++s)
+  {
+    if (representative[m_block[s]] == undefined)
+    {
+      representative[m_block[s]] = s;
+    }
+  }
+
+  std::vector<transition> new_transitions;
+  std::vector<signature_element> signature;
+  for (std::size_t B = 0; B < m_number_of_blocks; ++B)
+  {
+    weak_signature(representative[B], true, signature);
+
+    // A pair (a, C) is only kept when it is not redundant for any of the states in C that are reached.
+    for (std::size_t i = 0; i < signature.size(); )
+    {
+      const auto [a, C, redundant] = signature[i];
+      bool keep = true;
+      for (; i < signature.size() && std::get<0>(signature[i]) == a && std::get<1>(signature[i]) == C; ++i)
+      {
+        keep = keep && !std::get<2>(signature[i]);
+      }
+      if (keep && !(m_lts.is_tau(a) && B == C))
+      {
+        new_transitions.emplace_back(B, a, C);
+      }
+    }
+  }
+
+  m_lts.clear_transitions();
+  for (const transition& t: new_transitions)
+  {
+    m_lts.add_transition(t);
+  }
+
+  // Merge the states, by setting the state labels of each state to the concatenation of the state labels of its
+  // equivalence class.
+  if (m_lts.has_state_info())
+  {
+    std::vector<typename LTS_TYPE::state_label_t> new_labels(m_number_of_blocks);
+    for (std::size_t i = m_lts.num_states(); i > 0; )
+    {
+      --i;
+      new_labels[m_block[i]] = new_labels[m_block[i]] + m_lts.state_label(i);
+    }
+    for (std::size_t i = 0; i < m_number_of_blocks; ++i)
+    {
+      m_lts.set_state_label(i, new_labels[i]);
+    }
+  }
+
+  m_lts.set_num_states(m_number_of_blocks);
+  m_lts.set_initial_state(m_block[m_lts.initial_state()]);
+}
+
+template <class LTS_TYPE>
+std::size_t weak_bisim_partitioner<LTS_TYPE>::num_eq_classes() const
+{
+  return m_number_of_blocks;
+}
+
+template <class LTS_TYPE>
+std::size_t weak_bisim_partitioner<LTS_TYPE>::get_eq_class(std::size_t s) const
+{
+  return m_block[s];
+}
+
+template <class LTS_TYPE>
+bool weak_bisim_partitioner<LTS_TYPE>::in_same_class(std::size_t s, std::size_t t) const
+{
+  return m_block[s] == m_block[t];
+}
+
+
 /** \brief Reduce LTS l with respect to (divergence-preserving) weak bisimulation.
  * \param[in/out] l The transition system that is reduced.
  * \param[in] preserve_divergences Indicates whether loops of internal actions on states must be preserved. If false
@@ -45,13 +458,19 @@ void weak_bisimulation_reduce(
   }
   if (1 < l.num_states())
   {
-    reflexive_transitive_tau_closure(l);                      // Apply transitive tau closure to l.
-    bisimulation_reduce_dnj(l, false, false);                 // Apply strong bisimulation to l.
+    // Without tau transitions the branching bisimulation quotient is already minimal modulo weak bisimulation.
+    if (std::any_of(l.get_transitions().begin(), l.get_transitions().end(),
+          [&](const transition& t) { return l.is_tau(l.apply_hidden_label_map(t.label())); }))
+    {
+      weak_bisim_partitioner<LTS_TYPE> partitioner(l);        // Calculate weak bisimulation without a transitive tau closure.
+      partitioner.replace_transition_system();                // Replace l by its quotient, without tau loops and redundant transitions.
+    }
+  }
+  else
+  {
+    scc_reduce(l);                                            // Remove tau loops.
+    remove_redundant_transitions(l);                          // Remove transitions s -a-> s' if also s-a->-tau->s' or s-tau->-a->s' is present.
   }
-  scc_reduce(l);                                              // Remove tau loops.
-  remove_redundant_transitions(l);                            // Remove transitions s -a-> s' if also s-a->-tau->s' or s-tau->-a->s' is present.
-                                                              // Note that this is correct, because l is reduced modulo strong bisimulation and
-                                                              // does not contain tau loops.
   if (preserve_divergences)
   {
     unmark_explicit_divergence_transitions(l,divergence_label);
@@ -62,7 +481,7 @@ void weak_bisimulation_reduce(
 /** \brief Checks whether the initial states of two LTSs are weakly bisimilar.
  * \details The LTSs l1 and l2 are not usable anymore after this call.
  *          The space consumption is O(n) and running time is dominated by the
- *          transitive closure (after branching bisimulation).
+ *          searches along tau paths (after branching bisimulation).
  * \param[in/out] l1 A first transition system.
  * \param[in/out] l2 A second transistion system.
  * \param[preserve_divergences] If true and branching is true, preserve tau loops on states.
@@ -83,7 +502,7 @@ bool destructive_weak_bisimulation_compare(
  *  \details The LTSs l1 and l2 are first duplicated and subsequently
  *           reduced modulo bisimulation. If memory space is a concern, one could consider to
  *           use destructive_weak_bisimulation_compare.  The running time
- *           of this routine is dominated by the transitive closure
+ *           of this routine is dominated by the searches along tau paths
  *           (after branching bisimulation).  It uses O(m+n) memory
  *           in addition to the copies of l1 and l2, where n is the
  *           number of states and m is the number of transitions.
@@ -30,8 +30,8 @@
 #include "mcrl2/lts/detail/liblts_ready_sim.h"
 #include "mcrl2/lts/detail/liblts_failures_refinement.h"
 #include "mcrl2/lts/detail/liblts_coupledsim.h"
+#include "mcrl2/lts/detail/liblts_determinise.h"
 #include "mcrl2/lts/detail/liblts_impossible_futures.h"
-#include "mcrl2/lts/detail/tree_set.h"
 #include "mcrl2/lts/lts_equivalence.h"
 #include "mcrl2/lts/lts_preorder.h"
 #include "mcrl2/lts/sigref.h"
@@ -44,9 +44,13 @@ namespace mcrl2::lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  *            reduced.
+ * \param[in] number_of_threads The number of threads that may be used. Currently
+ *            only the signature refinement algorithms use multiple threads. With
+ *            more than one thread, strong, branching and divergence-preserving
+ *            branching bisimulation are reduced with signature refinement.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -214,50 +218,13 @@ bool destructive_compare(LTS_TYPE& l1,
     }
     case lts_eq_trace:
     {
-      // Determinise first LTS
-      detail::bisimulation_reduce_gj(l1, false);
-      determinise(l1);
-
-      // Determinise second LTS
-      detail::bisimulation_reduce_gj(l2, false);
-      determinise(l2);
-
-      // Trace equivalence now corresponds to bisimilarity
-      if (generate_counter_examples) 
-      {
-        return detail::destructive_bisimulation_compare_minimal_depth(l1, l2, counter_example_file);
-      }
-      return detail::destructive_bisimulation_compare(l1, l2, false, false, generate_counter_examples, counter_example_file, structured_output);
+      return destructive_trace_equivalence_checker(l1, l2, false, generate_counter_examples, counter_example_file,
+          structured_output);
     }
     case lts_eq_weak_trace:
     {
-      if (generate_counter_examples)
-      {
-        detail::bisimulation_reduce_gj(l1,true,false); // Branching bisimulation reduction.
-        detail::tau_star_reduce(l1);
-        detail::bisimulation_reduce_gj(l1,false);
-        determinise(l1); 
-        detail::bisimulation_reduce_gj(l2,true,false);
-        detail::tau_star_reduce(l2);
-        detail::bisimulation_reduce_gj(l2,false);
-        determinise(l2);
-        return detail::destructive_branching_bisimulation_compare_minimal_depth(l1, l2, counter_example_file);
-      }
-
-      // Eliminate silent steps and determinise first LTS
-      detail::bisimulation_reduce_gj(l1,true,false);
-      detail::tau_star_reduce(l1);
-      detail::bisimulation_reduce_gj(l1,false);
-      determinise(l1);
-
-      // Eliminate silent steps and determinise second LTS
-      detail::bisimulation_reduce_gj(l2,true,false);
-      detail::tau_star_reduce(l2);
-      detail::bisimulation_reduce_gj(l2,false);
-      determinise(l2);
-
-      // Weak trace equivalence now corresponds to bisimilarity
-      return detail::destructive_bisimulation_compare(l1,l2,false,false,false,counter_example_file,structured_output);
+      return destructive_trace_equivalence_checker(l1, l2, true, generate_counter_examples, counter_example_file,
+          structured_output);
     }
     case lts_eq_coupled_sim:
     {
@@ -301,6 +268,8 @@ bool compare(const LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads used by the breadth-first
+ *            antichain algorithms for trace and failures refinement.
  * \retval true if LTS \a l1 is smaller than LTS \a l2 according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -319,7 +288,8 @@ bool destructive_compare(LTS_TYPE& l1,
   const std::string& counter_example_file = "",
   bool structured_output = false,
   lps::exploration_strategy strategy = lps::es_breadth,
-  bool preprocess = true);
+  bool preprocess = true,
+  std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -331,6 +301,8 @@ bool destructive_compare(LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads used by the breadth-first
+ *            antichain algorithms for trace and failures refinement.
  * \retval true if this LTS is smaller than LTS \a l according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -343,11 +315,18 @@ bool compare(const LTS_TYPE& l1,
   const std::string& counter_example_file = "",
   bool structured_output = false,
   lps::exploration_strategy strategy = lps::es_breadth,
-  bool preprocess = true);
-
-/** \brief Determinises this LTS. */
+  bool preprocess = true,
+  std::size_t number_of_threads = 1);
+
+/** \brief Determinises this LTS.
+ * \param[in] l The LTS that is determinised.
+ * \param[in] number_of_threads The number of threads that calculate the successors of the
+ *            sets of states. The result does not depend on the number of threads.
+ * \param[in] minimise If set, bisimilar states are merged while the LTS is determinised, which
+ *            keeps the intermediate LTS small. The result is deterministic, but not necessarily minimal.
+ */
 template <class LTS_TYPE>
-void determinise(LTS_TYPE& l);
+void determinise(LTS_TYPE& l, std::size_t number_of_threads = 1, bool minimise = false);
 
 
 /** \brief Checks whether all states in this LTS are reachable
@@ -647,7 +626,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l,lts_equivalence eq, std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -656,6 +635,12 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       return;
     case lts_eq_bisim:
     {
+      if (number_of_threads > 1)
+      {
+        // Signature refinement is the only algorithm that uses multiple threads.
+        reduce(l, lts_eq_bisim_sigref, number_of_threads);
+        return;
+      }
       detail::bisimulation_reduce_gj(l,false,false);
       return;
     }
@@ -686,12 +671,17 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
     case lts_eq_branching_bisim:
     {
+      if (number_of_threads > 1)
+      {
+        reduce(l, lts_eq_branching_bisim_sigref, number_of_threads);
+        return;
+      }
       detail::bisimulation_reduce_gj(l,true,false);
       return;
     }
@@ -722,12 +712,22 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l);
+      if (number_of_threads > 1)
+      {
+        // Without tau-cycles the branching signatures can be computed in parallel.
+        scc_reduce(l, false);
+      }
+      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
     case lts_eq_divergence_preserving_branching_bisim:
     {
+      if (number_of_threads > 1)
+      {
+        reduce(l, lts_eq_divergence_preserving_branching_bisim_sigref, number_of_threads);
+        return;
+      }
       detail::bisimulation_reduce_gj(l,true,true);
       return;
     }
@@ -758,7 +758,11 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_divergence_preserving_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l);
+      if (number_of_threads > 1)
+      {
+        scc_reduce(l, true);
+      }
+      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
@@ -844,7 +848,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_trace:
       detail::bisimulation_reduce_gj(l,false);
-      determinise(l);
+      determinise(l, number_of_threads, true);
       detail::bisimulation_reduce_gj(l,false);
       return;
     case lts_eq_weak_trace:
@@ -852,7 +856,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
       detail::bisimulation_reduce_gj(l,true,false);
       detail::tau_star_reduce(l);
       detail::bisimulation_reduce_gj(l,false);
-      determinise(l);
+      determinise(l, number_of_threads, true);
       detail::bisimulation_reduce_gj(l,false);
       return;
     }
@@ -865,7 +869,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_red_determinisation:
     {
-      determinise(l);
+      determinise(l, number_of_threads);
       return;
     }
     case lts_red_tau_scc:
@@ -894,15 +898,15 @@ bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, c
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   LTS_TYPE l1_copy(l1);
   LTS_TYPE l2_copy(l2);
-  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess);
+  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
 }
 
 template <class LTS_TYPE>
-bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   switch (pre)
   {
@@ -944,82 +948,57 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
     }
     case lts_preorder::lts_pre_trace:
     {
-      // Preprocessing: reduce modulo strong bisimulation equivalence.
-      // This is not strictly necessary, but may reduce time/memory
-      // needed for determinisation.
-      detail::bisimulation_reduce_gj(l1,false);
-      detail::bisimulation_reduce_gj(l2,false);
-
-      // Determinise both LTSes. As postprocessing, reduce modulo
-      // strong bisimulation equivalence. This is not strictly
-      // necessary, but may reduce time/memory needed for simulation
-      // preorder checking.
-      determinise(l1);
-      detail::bisimulation_reduce_gj(l1,false);
-
-      determinise(l2);
-      detail::bisimulation_reduce_gj(l2,false);
-
-      // Trace preorder now corresponds to simulation preorder
-      return destructive_compare(l1, l2, lts_preorder::lts_pre_sim, generate_counter_example, counter_example_file, structured_output, strategy);
+      // The antichain algorithm explores the subset construction on the fly, instead of determinising both LTSs.
+      return destructive_compare(l1, l2, lts_preorder::lts_pre_trace_anti_chain, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
     }
     case lts_preorder::lts_pre_weak_trace:
     {
-      // Eliminate silent steps of first LTS
-      detail::bisimulation_reduce_gj(l1,true,false);
-      detail::tau_star_reduce(l1);
-
-      // Eliminate silent steps of second LTS
-      detail::bisimulation_reduce_gj(l2,true,false);
-      detail::tau_star_reduce(l2);
-
-      // Weak trace preorder now corresponds to strong trace preorder
-      return destructive_compare(l1, l2, lts_preorder::lts_pre_trace, generate_counter_example, counter_example_file, structured_output, strategy);
+      return destructive_compare(l1, l2, lts_preorder::lts_pre_weak_trace_anti_chain, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
     }
     case lts_preorder::lts_pre_trace_anti_chain:
     {
       if (generate_counter_example)
       {
         detail::counter_example_constructor cec("counter_example_trace_preorder", counter_example_file, structured_output);
-        return destructive_refinement_checker(l1, l2, refinement_type::trace, false, strategy, preprocess, cec);
+        return destructive_refinement_checker(l1, l2, refinement_type::trace, false, strategy, preprocess, cec, number_of_threads);
       }
-      return destructive_refinement_checker(l1, l2, refinement_type::trace, false, strategy, preprocess);
+      return destructive_refinement_checker(l1, l2, refinement_type::trace, false, strategy, preprocess, detail::dummy_counter_example_constructor(), number_of_threads);
     }
     case lts_preorder::lts_pre_weak_trace_anti_chain:
     {
       if (generate_counter_example)
       {
         detail::counter_example_constructor cec("counter_example_weak_trace_preorder", counter_example_file, structured_output);
-        return destructive_refinement_checker(l1, l2, refinement_type::trace, true, strategy, preprocess, cec);
+        return destructive_refinement_checker(l1, l2, refinement_type::trace, true, strategy, preprocess, cec, number_of_threads);
       }
-      return destructive_refinement_checker(l1, l2, refinement_type::trace, true, strategy, preprocess);
+      return destructive_refinement_checker(l1, l2, refinement_type::trace, true, strategy, preprocess, detail::dummy_counter_example_constructor(), number_of_threads);
     }
     case lts_preorder::lts_pre_failures_refinement:
     {
       if (generate_counter_example)
       {
         detail::counter_example_constructor cec("counter_example_failures_refinement", counter_example_file, structured_output);
-        return destructive_refinement_checker(l1, l2, refinement_type::failures, false, strategy, preprocess, cec);
+        return destructive_refinement_checker(l1, l2, refinement_type::failures, false, strategy, preprocess, cec, number_of_threads);
       }
-      return destructive_refinement_checker(l1, l2, refinement_type::failures, false, strategy, preprocess);
+      return destructive_refinement_checker(l1, l2, refinement_type::failures, false, strategy, preprocess, detail::dummy_counter_example_constructor(), number_of_threads);
     }
     case lts_preorder::lts_pre_weak_failures_refinement:
     {
       if (generate_counter_example)
       {
         detail::counter_example_constructor cec("counter_example_weak_failures_refinement", counter_example_file, structured_output);
-        return destructive_refinement_checker(l1, l2, refinement_type::failures, true, strategy, preprocess, cec);
+        return destructive_refinement_checker(l1, l2, refinement_type::failures, true, strategy, preprocess, cec, number_of_threads);
       }
-      return destructive_refinement_checker(l1, l2, refinement_type::failures, true, strategy, preprocess);
+      return destructive_refinement_checker(l1, l2, refinement_type::failures, true, strategy, preprocess, detail::dummy_counter_example_constructor(), number_of_threads);
     }
     case lts_preorder::lts_pre_failures_divergence_refinement:
     {
       if (generate_counter_example)
       {
         detail::counter_example_constructor cec("counter_example_failures_divergence_refinement", counter_example_file, structured_output);
-        return destructive_refinement_checker(l1, l2, refinement_type::failures_divergence, true, strategy, preprocess, cec);
+        return destructive_refinement_checker(l1, l2, refinement_type::failures_divergence, true, strategy, preprocess, cec, number_of_threads);
       }
-      return destructive_refinement_checker(l1, l2, refinement_type::failures_divergence, true, strategy, preprocess);
+      return destructive_refinement_checker(l1, l2, refinement_type::failures_divergence, true, strategy, preprocess, detail::dummy_counter_example_constructor(), number_of_threads);
     }
     case lts_preorder::lts_pre_impossible_futures:
     {
@@ -1074,120 +1053,11 @@ bool is_deterministic(const LTS_TYPE& l)
 }
 
 
-namespace detail
-{
-
 template <class LTS_TYPE>
-void get_trans(const outgoing_transitions_per_state_t& begin,
-               tree_set_store& tss,
-               std::ptrdiff_t d,
-               std::vector<transition>& d_trans,
-               LTS_TYPE& aut)
+void determinise(LTS_TYPE& l, std::size_t number_of_threads, bool minimise)
 {
-  if (!tss.is_set_empty(d))
-  {
-    if (tss.is_set_empty(tss.get_set_child_right(d)))
-    {
-      const state_type from=tss.get_set_child_left(d);
-      for (detail::state_type i=begin.lowerbound(from); i<begin.upperbound(from); ++i)
-      {
-        const outgoing_pair_t& p=begin.get_transitions()[i];
-        d_trans.push_back(transition(from, aut.apply_hidden_label_map(label(p)), to(p)));
-      }
-    }
-    else
-    {
-      get_trans(begin,tss,tss.get_set_child_left(d),d_trans,aut);
-      get_trans(begin,tss,tss.get_set_child_right(d),d_trans,aut);
-    }
-  }
-}
-} // namespace detail
-
-
-template <class LTS_TYPE>
-void determinise(LTS_TYPE& l)
-{
-  tree_set_store tss;
-
-  std::vector<transition> d_transs;
-  std::vector<std::ptrdiff_t> d_states;
-
-  // create the initial state of the DLTS
-  d_states.push_back(l.initial_state());
-  std::ptrdiff_t d_id = tss.set_set_tag(tss.create_set(d_states));
-  d_states.clear();
-
-  const outgoing_transitions_per_state_t begin(l.get_transitions(),l.num_states(),true);
-
-  l.clear_transitions();
-  l.clear_state_labels();
-  std::size_t d_ntransitions = 0;
-  std::vector < transition > d_transitions;
-
-  std::ptrdiff_t s;
-  std::size_t i;
-  std::size_t to;
-  std::size_t lbl;
-  std::size_t n_t;
-
-  while (d_id < tss.get_next_tag())
-  {
-    // collect the outgoing transitions of every state of DLTS state d_id in
-    // the vector d_transs
-    detail::get_trans(begin,tss,tss.get_set(d_id),d_transs,l);
-
-    // sort d_transs by label and (if labels are equal) by destination
-    const detail::compare_transitions_lts compare(l.hidden_label_set());
-    sort(d_transs.begin(),d_transs.end(),compare);
-
-    n_t = d_transs.size();
-    i = 0;
-    for (lbl = 0; lbl < l.num_action_labels(); ++lbl)
-    {
-      // compute the destination of the transition with label lbl
-      while (i < n_t && l.apply_hidden_label_map(d_transs[i].label()) < lbl)
-      {
-        ++i;
-      }
-      while (i < n_t && l.apply_hidden_label_map(d_transs[i].label()) == lbl)
-      {
-        to = d_transs[i].to();
-        d_states.push_back(static_cast<std::ptrdiff_t>(to));
-        while (i < n_t && l.apply_hidden_label_map(d_transs[i].label()) == lbl &&
-               d_transs[i].to() == to)
-        {
-          ++i;
-        }
-      }
-      s = tss.create_set(d_states);
-
-      // generate the transitions to each of the next states
-      if (!tss.is_set_empty(s))
-      {
-        d_transitions.emplace_back(d_id, lbl, tss.set_set_tag(s));
-
-        if (d_ntransitions%10000 == 0)
-        {
-          mCRL2log(log::debug) <<
-            "generated " << tss.get_next_tag() << " states and " << d_ntransitions
-                         << " transitions; explored " << d_id << " states" << std::endl;
-        }
-      }
-      d_states.clear();
-    }
-    d_transs.clear();
-    ++d_id;
-  }
-
-
-  l.set_num_states(d_id,false); // remove the state values, and reset the number of states.
-  l.set_initial_state(0);
-
-  for (const transition& t: d_transitions)
-  {
-    l.add_transition(t);
-  }
+  detail::subset_construction(l, number_of_threads,
+      minimise ? detail::subset_construction_minimisation_threshold : 0);
   assert(is_deterministic(l));
 }
 
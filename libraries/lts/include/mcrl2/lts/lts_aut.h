@@ -71,20 +71,28 @@ class lts_aut_t : public lts< state_label_empty, action_label_string, detail::lt
      *  \details If the filename is empty, the result is read from stdin.
                  The input file must be in .aut format.
      *  \param[in] filename Name of the file from which this lts is read.
+     *  \param[in] number_of_threads The number of threads that parse the transitions.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Load the labelled transition system from an input stream.
      *  \details The input stream must be in .aut format.
      *  \param[in] is The input stream.
+     *  \param[in] number_of_threads The number of threads that parse the transitions.
      */
-    void load(std::istream& is);
+    void load(std::istream& is, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is written to stdout.
      *  \param[in] filename Name of the file to which this lts is written.
      */
     void save(const std::string& filename) const;
+
+    /** \brief Save the labelled transition system to an output stream.
+     *  \details The output is in .aut format.
+     *  \param[in] os The output stream.
+     */
+    void save(std::ostream& os) const;
 };
 
 /** \brief A simple labelled transition format with only strings as action labels.
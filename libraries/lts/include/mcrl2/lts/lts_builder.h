@@ -27,15 +27,26 @@ lps::state remove_time_stamp(const lps::state& s)
 
 struct lts_builder
 {
-  using indexed_set_for_states_type = atermpp::indexed_set<lps::state, mcrl2::utilities::detail::GlobalThreadSafe>;
+  using indexed_set_for_states_type = atermpp::concurrent_indexed_set<lps::state>;
   // All LTS classes use integers to represent actions in transitions. A mapping from actions to integers
   // is needed to avoid duplicates.
   utilities::unordered_map_large<lps::multi_action, std::size_t> m_actions;
 
-  lts_builder()
+  /// \brief The number of transitions that a thread buffers before it is flushed.
+  static constexpr std::size_t transition_buffer_size = 1 << 14;
+
+  /// \brief Constructor.
+  /// \param number_of_threads The number of threads that add transitions. If it is larger than one,
+  ///        every thread buffers its transitions and action labels locally, such that threads only
+  ///        synchronise once per chunk of transitions.
+  explicit lts_builder(std::size_t number_of_threads = 1)
   {
     lps::multi_action tau(process::action_list(), data::undefined_real());
     m_actions.emplace(std::make_pair(tau, m_actions.size()));
+    if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
+    {
+      m_thread_buffers.resize(number_of_threads + 1); // Thread indices start at 1.
+    }
   }
 
   std::size_t add_action(const lps::multi_action& a)
@@ -49,9 +60,12 @@ struct lts_builder
     return i->second;
   }
 
-  // Add a transition to the LTS
-  virtual void
-  add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, std::size_t number_of_threads = 0)
+  // Add a transition to the LTS. The thread index identifies the calling thread when number_of_threads > 1.
+  virtual void add_transition(std::size_t from,
+    const lps::multi_action& a,
+    std::size_t to,
+    std::size_t number_of_threads = 0,
+    std::size_t thread_index = 0)
     = 0;
 
   // Add actions and states to the LTS
@@ -61,12 +75,79 @@ struct lts_builder
   virtual void save(const std::string& filename) = 0;
 
   virtual ~lts_builder() = default;
+
+  protected:
+    /// \brief The transitions of a single thread that have not been flushed yet, together with a cache
+    ///        that maps the addresses of the multi actions seen by this thread to their labels.
+    struct alignas(64) thread_buffer
+    {
+      std::vector<transition> transitions;
+      std::unordered_map<const atermpp::detail::_aterm*, std::size_t> labels;
+    };
+
+    std::vector<thread_buffer> m_thread_buffers;
+    std::mutex m_exclusive_action_access;
+
+    // The multi actions that occur as key in one of the label caches. They are kept alive here, such that
+    // their addresses cannot be reused for other terms. These vectors are filled by the explorer threads, so
+    // they must be atermpp containers: a protected term has to be released by the thread that created it.
+    atermpp::vector<lps::multi_action> m_cached_actions;
+
+    // For each label a multi action with that label.
+    atermpp::vector<lps::multi_action> m_label_actions;
+
+    /// \brief Returns true iff the calling thread must use its thread buffer.
+    bool use_thread_buffer(std::size_t number_of_threads, std::size_t thread_index) const
+    {
+      return number_of_threads > 1 && thread_index < m_thread_buffers.size();
+    }
+
+    /// \brief Returns the label of a, which is only looked up in the global action table when the
+    ///        thread with the given index has not seen the term a before.
+    std::size_t add_action(const lps::multi_action& a, std::size_t thread_index)
+    {
+      thread_buffer& buffer = m_thread_buffers[thread_index];
+      auto i = buffer.labels.find(atermpp::detail::address(a));
+      if (i != buffer.labels.end())
+      {
+        return i->second;
+      }
+
+      std::lock_guard<std::mutex> guard(m_exclusive_action_access);
+      std::size_t label = add_action(a);
+      if (label >= m_label_actions.size())
+      {
+        m_label_actions.resize(label + 1);
+      }
+      m_label_actions[label] = a;
+      m_cached_actions.push_back(a);
+      buffer.labels.emplace(atermpp::detail::address(a), label);
+      return label;
+    }
+
+    /// \brief Moves the buffered transitions of all threads to flush, which is not done concurrently.
+    template <typename Flush>
+    void flush_thread_buffers(Flush flush)
+    {
+      for (thread_buffer& buffer: m_thread_buffers)
+      {
+        if (!buffer.transitions.empty())
+        {
+          flush(buffer.transitions);
+          buffer.transitions.clear();
+        }
+      }
+    }
 };
 
 class lts_none_builder: public lts_builder
 {
   public:
-    void add_transition(std::size_t /* from */, const lps::multi_action& /* a */, std::size_t /* to */, const std::size_t /* number_of_threads */) override
+    void add_transition(std::size_t /* from */,
+      const lps::multi_action& /* a */,
+      std::size_t /* to */,
+      const std::size_t /* number_of_threads */,
+      const std::size_t /* thread_index */) override
     {}
 
     void finalize(const indexed_set_for_states_type& /* state_map */, bool /* timed */) override
@@ -82,8 +163,16 @@ class lts_aut_builder: public lts_builder
     lts_aut_t m_lts;
     std::mutex m_exclusive_transition_access;
 
+    void flush(std::vector<transition>& transitions)
+    {
+      std::vector<transition>& lts_transitions = m_lts.get_transitions();
+      lts_transitions.insert(lts_transitions.end(), transitions.begin(), transitions.end());
+    }
+
   public:
-    lts_aut_builder() = default;
+    explicit lts_aut_builder(std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads)
+    {}
 
     const lts_aut_t& lts() const
     {
@@ -95,8 +184,25 @@ class lts_aut_builder: public lts_builder
       return m_lts;
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from,
+      const lps::multi_action& a,
+      std::size_t to,
+      const std::size_t number_of_threads,
+      const std::size_t thread_index) override
     {
+      if (use_thread_buffer(number_of_threads, thread_index))
+      {
+        std::vector<transition>& transitions = m_thread_buffers[thread_index].transitions;
+        transitions.emplace_back(from, add_action(a, thread_index), to);
+        if (transitions.size() >= transition_buffer_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          flush(transitions);
+          transitions.clear();
+        }
+        return;
+      }
+
       if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
       {
         m_exclusive_transition_access.lock();
@@ -112,6 +218,8 @@ class lts_aut_builder: public lts_builder
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
     {
+      flush_thread_buffers([&](std::vector<transition>& transitions) { flush(transitions); });
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -141,9 +249,44 @@ class lts_aut_disk_builder: public lts_builder
     std::size_t m_transition_count = 0;
     std::mutex m_exclusive_transition_access;
 
+    /// \brief The textual transitions of a single thread that have not been written yet, and the
+    ///        pretty printed multi actions that this thread has encountered.
+    struct alignas(64) text_buffer
+    {
+      std::string text;
+      std::size_t transition_count = 0;
+      std::unordered_map<const atermpp::detail::_aterm*, std::string> action_strings;
+    };
+
+    std::vector<text_buffer> m_text_buffers;
+
+    /// \brief The number of characters that a thread buffers before it is written to disk.
+    static constexpr std::size_t text_buffer_size = 1 << 20;
+
+    void flush(text_buffer& buffer)
+    {
+      out << buffer.text;
+      m_transition_count += buffer.transition_count;
+      buffer.text.clear();
+      buffer.transition_count = 0;
+    }
+
+    const std::string& action_string(text_buffer& buffer, const lps::multi_action& a, std::size_t thread_index)
+    {
+      auto i = buffer.action_strings.find(atermpp::detail::address(a));
+      if (i == buffer.action_strings.end())
+      {
+        add_action(a, thread_index); // Guarantees that the address of a is not reused.
+        i = buffer.action_strings.emplace(atermpp::detail::address(a), lps::pp(a)).first;
+      }
+      return i->second;
+    }
+
   public:
-    explicit lts_aut_disk_builder(const std::string& filename)
+    explicit lts_aut_disk_builder(const std::string& filename, std::size_t number_of_threads = 1)
+      : lts_builder(number_of_threads)
     {
+      m_text_buffers.resize(m_thread_buffers.size());
       mCRL2log(log::verbose) << "writing state space in AUT format to '" << filename << "'." << std::endl;
       out.open(filename.c_str());
       if (!out.is_open())
@@ -153,8 +296,27 @@ class lts_aut_disk_builder: public lts_builder
       out << "des                                                \n"; // write a dummy header that will be overwritten
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from,
+      const lps::multi_action& a,
+      std::size_t to,
+      const std::size_t number_of_threads,
+      const std::size_t thread_index) override
     {
+      if (use_thread_buffer(number_of_threads, thread_index))
+      {
+        text_buffer& buffer = m_text_buffers[thread_index];
+        buffer.text.append("(").append(std::to_string(from)).append(",\"");
+        buffer.text.append(action_string(buffer, a, thread_index));
+        buffer.text.append("\",").append(std::to_string(to)).append(")\n");
+        buffer.transition_count++;
+        if (buffer.text.size() >= text_buffer_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          flush(buffer);
+        }
+        return;
+      }
+
       if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
       {
         m_exclusive_transition_access.lock();
@@ -170,6 +332,11 @@ class lts_aut_disk_builder: public lts_builder
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool /* timed */) override
     {
+      for (text_buffer& buffer: m_text_buffers)
+      {
+        flush(buffer);
+      }
+
       assert(!out.fail());
       out.flush();
       out.seekp(0);
@@ -192,22 +359,47 @@ class lts_lts_builder: public lts_builder
     bool m_discard_state_labels = false;
     std::mutex m_exclusive_transition_access;
 
+    void flush(std::vector<transition>& transitions)
+    {
+      std::vector<transition>& lts_transitions = m_lts.get_transitions();
+      lts_transitions.insert(lts_transitions.end(), transitions.begin(), transitions.end());
+    }
+
   public:
     lts_lts_builder(
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels)
     {
       m_lts.set_data(dataspec);
       m_lts.set_process_parameters(process_parameters);
       m_lts.set_action_label_declarations(action_labels);
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from,
+      const lps::multi_action& a,
+      std::size_t to,
+      const std::size_t number_of_threads,
+      const std::size_t thread_index) override
     {
+      if (use_thread_buffer(number_of_threads, thread_index))
+      {
+        std::vector<transition>& transitions = m_thread_buffers[thread_index].transitions;
+        transitions.emplace_back(from, add_action(a, thread_index), to);
+        if (transitions.size() >= transition_buffer_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          flush(transitions);
+          transitions.clear();
+        }
+        return;
+      }
+
       if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
       {
         m_exclusive_transition_access.lock();
@@ -223,6 +415,8 @@ class lts_lts_builder: public lts_builder
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool timed) override
     {
+      flush_thread_buffers([&](std::vector<transition>& transitions) { flush(transitions); });
+
       // add actions
       m_lts.set_num_action_labels(m_actions.size());
       for (const auto& p: m_actions)
@@ -267,15 +461,37 @@ class lts_lts_disk_builder: public lts_builder
     bool m_discard_state_labels = false;
     std::mutex m_exclusive_transition_access;
 
+    void flush(std::vector<transition>& transitions)
+    {
+      // Other threads may resize m_label_actions while adding actions, so the actions are looked up
+      // under the action lock before they are written.
+      std::vector<lps::multi_action> actions;
+      actions.reserve(transitions.size());
+      {
+        std::lock_guard<std::mutex> guard(m_exclusive_action_access);
+        for (const transition& t: transitions)
+        {
+          actions.push_back(m_label_actions[t.label()]);
+        }
+      }
+
+      for (std::size_t i = 0; i < transitions.size(); ++i)
+      {
+        write_transition(*stream, transitions[i].from(), actions[i], transitions[i].to());
+      }
+    }
+
   public:
     lts_lts_disk_builder(
       const std::string& filename,
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      std::size_t number_of_threads = 1
     )
-     : m_discard_state_labels(discard_state_labels)
+     : lts_builder(number_of_threads),
+       m_discard_state_labels(discard_state_labels)
     {
       bool to_stdout = filename.empty() || filename == "-";
       if (!to_stdout)
@@ -293,8 +509,25 @@ class lts_lts_disk_builder: public lts_builder
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
     }
 
-    void add_transition(std::size_t from, const lps::multi_action& a, std::size_t to, const std::size_t number_of_threads) override
+    void add_transition(std::size_t from,
+      const lps::multi_action& a,
+      std::size_t to,
+      const std::size_t number_of_threads,
+      const std::size_t thread_index) override
     {
+      if (use_thread_buffer(number_of_threads, thread_index))
+      {
+        std::vector<transition>& transitions = m_thread_buffers[thread_index].transitions;
+        transitions.emplace_back(from, add_action(a, thread_index), to);
+        if (transitions.size() >= transition_buffer_size)
+        {
+          std::lock_guard<std::mutex> guard(m_exclusive_transition_access);
+          flush(transitions);
+          transitions.clear();
+        }
+        return;
+      }
+
       if (mcrl2::utilities::detail::GlobalThreadSafe && number_of_threads > 1)
       {
         m_exclusive_transition_access.lock();
@@ -309,6 +542,8 @@ class lts_lts_disk_builder: public lts_builder
     // Add actions and states to the LTS
     void finalize(const indexed_set_for_states_type& state_map, bool timed) override
     {
+      flush_thread_buffers([&](std::vector<transition>& transitions) { flush(transitions); });
+
       if (!m_discard_state_labels)
       {
         // Write the state labels in the order of their indices.
@@ -339,8 +574,8 @@ class lts_dot_builder: public lts_lts_builder
 {
   public:
     using super = lts_lts_builder;
-    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_dot_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -355,8 +590,8 @@ class lts_fsm_builder: public lts_lts_builder
 {
   public:
     using super = lts_lts_builder;
-    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
-      : super(dataspec, action_labels, process_parameters)
+    lts_fsm_builder(const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters, std::size_t number_of_threads = 1)
+      : super(dataspec, action_labels, process_parameters, false, number_of_threads)
     { }
 
     void save(const std::string& filename) override
@@ -376,24 +611,24 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_aut_builder>();
+        return std::make_unique<lts_aut_builder>(options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_aut_disk_builder>(output_filename);
+        return std::make_unique<lts_aut_disk_builder>(output_filename, options.number_of_threads);
       }
     }
-    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
-    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
+    case lts_dot: return std::make_unique<lts_dot_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
+    case lts_fsm: return std::make_unique<lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.number_of_threads);
     case lts_lts:
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
       else
       {
-        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.number_of_threads);
       }
     }
     default: return std::make_unique<lts_none_builder>();
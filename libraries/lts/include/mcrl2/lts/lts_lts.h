@@ -384,16 +384,28 @@ class lts_lts_t : public lts< state_label_lts, action_label_lts, detail::lts_lts
     lts_lts_t() = default;
 
     /** \brief Load the labelled transition system from file.
-     *  \details If the filename is empty, the result is read from stdout.
+     *  \details If the filename is empty, the result is read from stdout. Both the streaming and
+     *           the indexed .lts format are accepted. The chunks of an indexed .lts file are read from
+     *           the file one at a time; only decoding them is done in parallel.
      *  \param[in] filename Name of the file to which this lts is written.
+     *  \param[in] number_of_threads The number of threads that decode the chunks of an indexed .lts file.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
      *  \param[in] filename Name of the file from which this lts is read.
      */
     void save(const std::string& filename) const;
+
+    /** \brief Save the labelled transition system to file in the indexed .lts format.
+     *  \details In this format the transitions and state labels are stored in chunks that can be
+     *           encoded and decoded independently. The file does not depend on the number of threads,
+     *           but it cannot be read by tools that only support the streaming .lts format.
+     *  \param[in] filename Name of the file to which this lts is written.
+     *  \param[in] number_of_threads The number of threads that encode the chunks.
+     */
+    void save_indexed(const std::string& filename, std::size_t number_of_threads = 1) const;
 };
 
 /** \brief This class contains probabilistic labelled transition systems in .lts format.
@@ -412,16 +424,28 @@ class probabilistic_lts_lts_t :
     probabilistic_lts_lts_t() = default;
 
     /** \brief Load the labelled transition system from file.
-     *  \details If the filename is empty, the result is read from stdout.
+     *  \details If the filename is empty, the result is read from stdout. Both the streaming and
+     *           the indexed .lts format are accepted. The chunks of an indexed .lts file are read from
+     *           the file one at a time; only decoding them is done in parallel.
      *  \param[in] filename Name of the file to which this lts is written.
+     *  \param[in] number_of_threads The number of threads that decode the chunks of an indexed .lts file.
      */
-    void load(const std::string& filename);
+    void load(const std::string& filename, std::size_t number_of_threads = 1);
 
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
      *  \param[in] filename Name of the file from which this lts is read.
      */
     void save(const std::string& filename) const;
+
+    /** \brief Save the labelled transition system to file in the indexed .lts format.
+     *  \details In this format the transitions and state labels are stored in chunks that can be
+     *           encoded and decoded independently. The file does not depend on the number of threads,
+     *           but it cannot be read by tools that only support the streaming .lts format.
+     *  \param[in] filename Name of the file to which this lts is written.
+     *  \param[in] number_of_threads The number of threads that encode the chunks.
+     */
+    void save_indexed(const std::string& filename, std::size_t number_of_threads = 1) const;
 };
 } // namespace mcrl2::lts
 
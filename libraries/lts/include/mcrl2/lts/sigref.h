@@ -15,6 +15,12 @@
 #define MCRL2_LTS_SIGREF_H
 
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+#include <numeric>
+#include <optional>
+#include <unordered_set>
 
 namespace mcrl2::lts
 {
@@ -33,14 +39,29 @@ protected:
   /** \brief Signature stored per state */
   std::vector<signature_t> m_sig;
 
+  /** \brief The number of threads that may be used to compute the signatures */
+  std::size_t m_number_of_threads;
+
+  /** \brief The threads that compute the signatures, which are kept for all iterations */
+  utilities::detail::parallel_for_pool m_thread_pool;
+
 public:
   /** \brief Constructor
     */
-  signature(const LTS_T& lts_)
-    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t())
+  signature(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t()), m_number_of_threads(number_of_threads),
+      m_thread_pool(number_of_threads)
   {}
   virtual ~signature() = default;
 
+  /** \brief The threads that compute the signatures, which can also be used for other parallel loops
+    *        that are executed for every signature computation.
+    */
+  utilities::detail::parallel_for_pool& thread_pool()
+  {
+    return m_thread_pool;
+  }
+
   /** \brief Compute a new signature based on \a partition.
     * \param[in] partition The current partition
     */
@@ -75,19 +96,53 @@ class signature_bisim: public signature<LTS_T>
 protected:
   using signature<LTS_T>::m_lts;
   using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_thread_pool;
+
+  /** \brief The outgoing transitions per state, only constructed when multiple threads are used */
+  std::optional<outgoing_transitions_per_state_t> m_succ_transitions;
 
 public:
   virtual ~signature_bisim() = default;
   /** \brief Constructor */
-  signature_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_)
+  signature_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose) << "initialising signature computation for strong bisimulation" << std::endl;
   }
 
-  /** \overload */
+  /** \overload
+    *
+    * With multiple threads every thread computes the signatures of a range of
+    * states from their outgoing transitions, such that each signature is
+    * only written by a single thread.
+    */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
+    if (m_number_of_threads > 1)
+    {
+      if (!m_succ_transitions)
+      {
+        m_succ_transitions.emplace(m_lts.get_transitions(), m_lts.num_states(), true);
+      }
+
+      const outgoing_transitions_per_state_t& succ = *m_succ_transitions;
+      m_thread_pool.parallel_for(m_lts.num_states(),
+        [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t s = begin; s < end; ++s)
+          {
+            m_sig[s].clear();
+            for (std::size_t i = succ.lowerbound(s); i < succ.upperbound(s); ++i)
+            {
+              const outgoing_pair_t& t = succ.get_transitions()[i];
+              m_sig[s].insert(std::make_pair(m_lts.apply_hidden_label_map(label(t)), partition[to(t)]));
+            }
+          }
+        });
+      return;
+    }
+
     // compute signatures
     m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
@@ -105,10 +160,21 @@ class signature_branching_bisim: public signature<LTS_T>
 protected:
   using signature<LTS_T>::m_lts;
   using signature<LTS_T>::m_sig;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_thread_pool;
 
   /** \brief Store the incoming transitions per state */
   outgoing_transitions_per_state_t m_prev_transitions;
 
+  /** \brief The outgoing transitions per state, only constructed when multiple threads are used */
+  std::optional<outgoing_transitions_per_state_t> m_succ_transitions;
+
+  /** \brief The states ordered by level, where the level of a state is the length of the longest
+             tau-path to a state without outgoing tau-transitions, ignoring tau-loops. The states
+             of level i are in the range [m_tau_levels[i], m_tau_levels[i+1]). */
+  std::vector<std::size_t> m_tau_ordered_states;
+  std::vector<std::size_t> m_tau_levels;
+
   /** \brief Insert function
     * \param[in] partition The current partition
     * \param[in] t source state
@@ -140,19 +206,156 @@ protected:
     }
   }
 
+  /** \brief Whether a transition to state t that is inert in the current partition contributes
+    *        its label and block to the signature of its source state.
+    */
+  virtual bool inert_transition_in_signature(const std::size_t /* t */) const
+  {
+    return false;
+  }
+
+  /** \brief Order the states by their level in the graph of tau-transitions.
+    * \return False iff there is a tau-cycle other than a tau-loop, in which case there are no levels.
+    */
+  bool compute_tau_levels()
+  {
+    const outgoing_transitions_per_state_t& succ = *m_succ_transitions;
+    auto is_tau_step = [&](std::size_t from, const outgoing_pair_t& t)
+    {
+      return from != to(t) && m_lts.is_tau(m_lts.apply_hidden_label_map(label(t)));
+    };
+
+    // The number of outgoing tau-transitions of each state whose target has no level yet.
+    std::vector<std::size_t> remaining(m_lts.num_states(), 0);
+    for (std::size_t s = 0; s < m_lts.num_states(); ++s)
+    {
+      for (std::size_t i = succ.lowerbound(s); i < succ.upperbound(s); ++i)
+      {
+        if (is_tau_step(s, succ.get_transitions()[i]))
+        {
+          ++remaining[s];
+        }
+      }
+      if (remaining[s] == 0)
+      {
+        m_tau_ordered_states.push_back(s);
+      }
+    }
+
+    m_tau_levels.push_back(0);
+    while (m_tau_levels.back() < m_tau_ordered_states.size())
+    {
+      const std::size_t begin = m_tau_levels.back();
+      const std::size_t end = m_tau_ordered_states.size();
+      m_tau_levels.push_back(end);
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        const std::size_t t = m_tau_ordered_states[i];
+        for (std::size_t j = m_prev_transitions.lowerbound(t); j < m_prev_transitions.upperbound(t); ++j)
+        {
+          const outgoing_pair_t& p = m_prev_transitions.get_transitions()[j];
+          if (is_tau_step(t, p) && --remaining[to(p)] == 0)
+          {
+            m_tau_ordered_states.push_back(to(p));
+          }
+        }
+      }
+    }
+
+    if (m_tau_ordered_states.size() != m_lts.num_states())
+    {
+      m_tau_ordered_states.clear();
+      m_tau_levels.clear();
+      return false;
+    }
+    return true;
+  }
+
+  /** \brief Whether the signatures are computed in parallel, which requires more than one thread
+    *        and an LTS without tau-cycles other than tau-loops.
+    */
+  bool parallel_signatures()
+  {
+    if (m_number_of_threads <= 1)
+    {
+      return false;
+    }
+    if (!m_succ_transitions)
+    {
+      m_succ_transitions.emplace(m_lts.get_transitions(), m_lts.num_states(), true);
+      if (!compute_tau_levels())
+      {
+        mCRL2log(log::verbose) << "the signatures are computed on one thread as the LTS contains tau-cycles" << std::endl;
+      }
+    }
+    return !m_tau_levels.empty();
+  }
+
+  /** \brief Compute the signatures level by level. The signature of a state consists of the pairs
+    *        of its non-inert transitions and the signatures of the targets of its inert
+    *        tau-transitions, which have a lower level. So the states within a level can be handled
+    *        by different threads.
+    */
+  void compute_signature_in_parallel(const std::vector<std::size_t>& partition)
+  {
+    const outgoing_transitions_per_state_t& succ = *m_succ_transitions;
+    for (std::size_t level = 0; level + 1 < m_tau_levels.size(); ++level)
+    {
+      const std::size_t first = m_tau_levels[level];
+      const std::size_t size = m_tau_levels[level + 1] - first;
+
+      // Starting threads does not pay off for levels with few states.
+      m_thread_pool.parallel_for(size, 1 + size / 1024,
+        [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t i = first + begin; i < first + end; ++i)
+          {
+            const std::size_t s = m_tau_ordered_states[i];
+            m_sig[s].clear();
+            for (std::size_t j = succ.lowerbound(s); j < succ.upperbound(s); ++j)
+            {
+              const outgoing_pair_t& t = succ.get_transitions()[j];
+              const std::size_t a = m_lts.apply_hidden_label_map(label(t));
+              const bool inert = m_lts.is_tau(a) && partition[s] == partition[to(t)];
+              if (!inert || inert_transition_in_signature(to(t)))
+              {
+                m_sig[s].insert(std::make_pair(a, partition[to(t)]));
+              }
+              if (inert && s != to(t))
+              {
+                m_sig[s].insert(m_sig[to(t)].begin(), m_sig[to(t)].end());
+              }
+            }
+          }
+        });
+    }
+  }
+
 public:
   virtual ~signature_branching_bisim() = default;
   /** \brief Constructor  */
-  signature_branching_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_),
+  signature_branching_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads),
       m_prev_transitions(lts_.get_transitions(),lts_.num_states(),false)  // transitions stored backward. 
   {
     mCRL2log(log::verbose) << "initialising signature computation for branching bisimulation" << std::endl;
   }
 
-  /** \overload */
+  /** \overload
+    *
+    * With multiple threads and without tau-cycles the signatures are
+    * computed in parallel per level. Otherwise they are computed
+    * sequentially, as inserting a pair also updates the signatures of the
+    * inert tau-predecessors.
+    */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
+    if (parallel_signatures())
+    {
+      compute_signature_in_parallel(partition);
+      return;
+    }
+
     // compute signatures
     m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
@@ -185,6 +388,8 @@ protected:
   using signature_branching_bisim<LTS_T>::m_lts;
   using signature_branching_bisim<LTS_T>::m_sig;
   using signature_branching_bisim<LTS_T>::insert;
+  using signature_branching_bisim<LTS_T>::parallel_signatures;
+  using signature_branching_bisim<LTS_T>::compute_signature_in_parallel;
 
   /** \brief Record for each vertex whether it is in a tau-scc */
   std::vector<bool> m_divergent;
@@ -294,14 +499,20 @@ public:
     * This initialises \a m_divergent to record for each vertex whether it is
     * in a tau-scc.
     */
-  signature_divergence_preserving_branching_bisim(const LTS_T& lts_)
-    : signature_branching_bisim<LTS_T>(lts_),
+  signature_divergence_preserving_branching_bisim(const LTS_T& lts_, std::size_t number_of_threads = 1)
+    : signature_branching_bisim<LTS_T>(lts_, number_of_threads),
       m_divergent(lts_.num_states(), false)
   {
     mCRL2log(log::verbose) << "initialising signature computation for divergence preserving branching bisimulation" << std::endl;
     compute_tau_sccs();
   }
 
+  /** \overload */
+  bool inert_transition_in_signature(const std::size_t t) const override
+  {
+    return m_divergent[t];
+  }
+
   /** \overload
     *
     * Compute the signature as in branching bisimulation. In addition, add the
@@ -309,6 +520,12 @@ public:
     */
   void compute_signature(const std::vector<std::size_t>& partition) override
   {
+    if (parallel_signatures())
+    {
+      compute_signature_in_parallel(partition);
+      return;
+    }
+
     // compute signatures
     m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
     for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
@@ -343,6 +560,10 @@ public:
   * Spaces", in Proc. PDMC 2003.
   *
   * The specific signature is a parameter of the algorithm.
+  *
+  * With multiple threads the signatures are hashed and grouped in parallel. The
+  * signatures are distributed over the threads by their hash value, such that
+  * every thread owns a separate hash table and no locking is required.
   */
 template < class LTS_T, typename Signature >
 class sigref
@@ -359,6 +580,9 @@ protected:
   /** \brief The LTS that we are reducing */
   LTS_T& m_lts;
 
+  /** \brief The number of threads used to refine the partition */
+  std::size_t m_number_of_threads;
+
   /** \brief Instance of a class performing the signature computation for the
              current equivalence */
   Signature m_signature;
@@ -376,6 +600,99 @@ protected:
     return os.str();
   }
 
+  /** \brief Compute the hash of a signature */
+  static std::size_t hash_signature(const signature_t& sig)
+  {
+    std::size_t hash = 0;
+    for (const auto& [label, block]: sig)
+    {
+      hash = utilities::detail::hash_combine(hash, utilities::detail::hash_combine(label, block));
+    }
+    return hash;
+  }
+
+  /** \brief Assign a block to every state such that states are in the same
+             block iff they have the same signature.
+      \details Every state is first mapped to the first state with the same
+               signature. These representatives are numbered in the order of
+               the states, which yields the same partition regardless of the
+               number of threads.
+      \return The number of blocks */
+  std::size_t number_blocks()
+  {
+    const std::size_t num_states = m_lts.num_states();
+
+    utilities::detail::parallel_for_pool& thread_pool = m_signature.thread_pool();
+
+    std::vector<std::size_t> hashes(num_states);
+    thread_pool.parallel_for(num_states,
+      [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          hashes[i] = hash_signature(m_signature.get_signature(i));
+        }
+      });
+
+    // Group the states by the shard of their hash, keeping them in increasing order within each shard.
+    // The states of shard k are in the range [shard_begin[k], shard_begin[k+1]) of shard_states.
+    const std::size_t number_of_shards = std::min(thread_pool.number_of_threads(), std::max<std::size_t>(num_states, 1));
+    std::vector<std::size_t> shard_begin(number_of_shards + 1, 0);
+    for (std::size_t i = 0; i < num_states; ++i)
+    {
+      ++shard_begin[hashes[i] % number_of_shards + 1];
+    }
+    std::partial_sum(shard_begin.begin(), shard_begin.end(), shard_begin.begin());
+    std::vector<std::size_t> shard_states(num_states);
+    {
+      std::vector<std::size_t> position(shard_begin.begin(), shard_begin.end() - 1);
+      for (std::size_t i = 0; i < num_states; ++i)
+      {
+        shard_states[position[hashes[i] % number_of_shards]++] = i;
+      }
+    }
+
+    // Every thread only considers the states of its own shards.
+    std::vector<std::size_t> representative(num_states);
+    thread_pool.parallel_for(number_of_shards,
+      [&](std::size_t begin, std::size_t end)
+      {
+        auto hash = [&](std::size_t i) { return hashes[i]; };
+        auto equal = [&](std::size_t i, std::size_t j) { return m_signature.get_signature(i) == m_signature.get_signature(j); };
+
+        for (std::size_t shard = begin; shard < end; ++shard)
+        {
+          std::unordered_set<std::size_t, decltype(hash), decltype(equal)> hashtable(0, hash, equal);
+          for (std::size_t k = shard_begin[shard]; k < shard_begin[shard + 1]; ++k)
+          {
+            const std::size_t i = shard_states[k];
+            representative[i] = *hashtable.insert(i).first;
+          }
+        }
+      });
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < num_states; ++i)
+    {
+      if (representative[i] == i)
+      {
+        mCRL2log(log::debug) << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
+        m_partition[i] = count++;
+      }
+    }
+
+    thread_pool.parallel_for(num_states,
+      [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          m_partition[i] = m_partition[representative[i]];
+        }
+      });
+
+    return count;
+  }
+
   /** \brief Compute the partition. Repeatedly updates the signatures, and
              the partition, until the partition stabilises */
   void compute_partition()
@@ -395,22 +712,7 @@ protected:
       count_prev = m_count;
 
       // Map signatures to block numbers
-      std::map<signature_t, std::size_t> hashtable;
-      m_count = 0;
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        if(hashtable.find(m_signature.get_signature(i)) == hashtable.end())
-        {
-          mCRL2log(log::debug) << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
-          hashtable[m_signature.get_signature(i)] = m_count++;
-        }
-      }
-
-      // Map states to block numbers
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        m_partition[i] = hashtable[m_signature.get_signature(i)];
-      }
+      m_count = number_blocks();
 
       ++iterations;
 
@@ -423,8 +725,22 @@ protected:
              been computed */
   void quotient()
   {
-    // Assign the reduced LTS
-    m_lts.set_num_states(m_count);
+    // Assign the reduced LTS. The state label of a block is the concatenation
+    // of the state labels of its states, as in the other bisimulation reductions.
+    if (m_lts.has_state_info())
+    {
+      std::remove_reference_t<decltype(m_lts.state_labels())> new_labels(m_count);
+      for (std::size_t i = 0; i < m_lts.num_states(); ++i)
+      {
+        new_labels[m_partition[i]] = new_labels[m_partition[i]] + m_lts.state_label(i);
+      }
+      m_lts.set_num_states(m_count, false);
+      m_lts.state_labels() = std::move(new_labels);
+    }
+    else
+    {
+      m_lts.set_num_states(m_count, false);
+    }
     m_lts.set_initial_state(m_partition[m_lts.initial_state()]);
 
     // Compute quotient transitions
@@ -443,12 +759,15 @@ protected:
 public:
   /** \brief Constructor
     * \param[in] lts_ The LTS that is being reduced
+    * \param[in] number_of_threads The number of threads used to compute and
+    *            group the signatures
     */
-  sigref(LTS_T& lts_)
+  sigref(LTS_T& lts_, std::size_t number_of_threads = 1)
       : m_partition(std::vector<std::size_t>(lts_.num_states(), 0)),
 
         m_lts(lts_),
-        m_signature(lts_)
+        m_number_of_threads(number_of_threads),
+        m_signature(lts_, number_of_threads)
   {}
 
   /** \brief Perform the reduction, modulo the equivalence for which the
@@ -456,8 +775,6 @@ public:
     */
   void run()
   {
-    // No need for state labels in the reduced LTS.
-    m_lts.clear_state_labels();
     compute_partition();
     quotient();
   }
@@ -131,6 +131,26 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     return false;
   }
   l=l_in;
+  reduce(l,lts::lts_eq_bisim_sigref,4);
+  if (!test_lts(test_description + " (bisimulation signature [Blom/Orzan 2003] with 4 threads)",
+          l,
+          expected.labels_bisimulation,
+          expected.states_bisimulation,
+          expected.transitions_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
+  reduce(l,lts::lts_eq_bisim,4);
+  if (!test_lts(test_description + " (bisimulation with 4 threads)",
+          l,
+          expected.labels_bisimulation,
+          expected.states_bisimulation,
+          expected.transitions_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
   reduce(l,lts::lts_eq_branching_bisim_jgkw);
   if (!test_lts(test_description + " (branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l, expected.labels_branching_bisimulation,expected.states_branching_bisimulation, expected.transitions_branching_bisimulation)) return false;
   l=l_in;
@@ -170,6 +190,26 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     return false;
   }
   l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim_sigref,4);
+  if (!test_lts(test_description + " (branching bisimulation signature [Blom/Orzan 2003] with 4 threads)",
+          l,
+          expected.labels_branching_bisimulation,
+          expected.states_branching_bisimulation,
+          expected.transitions_branching_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
+  reduce(l,lts::lts_eq_branching_bisim,4);
+  if (!test_lts(test_description + " (branching bisimulation with 4 threads)",
+          l,
+          expected.labels_branching_bisimulation,
+          expected.states_branching_bisimulation,
+          expected.transitions_branching_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
   reduce(l,lts::lts_eq_divergence_preserving_branching_bisim_jgkw);
   if (!test_lts(test_description + " (divergence-preserving branching bisimulation [Jansen/Groote/Keiren/Wijs 2019])",l,
                                       expected.labels_divergence_preserving_branching_bisimulation,
@@ -218,6 +258,26 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     return false;
   }
   l=l_in;
+  reduce(l,lts::lts_eq_divergence_preserving_branching_bisim_sigref,4);
+  if (!test_lts(test_description + " (divergence-preserving branching bisimulation signature [Blom/Orzan 2003] with 4 threads)",
+          l,
+          expected.labels_divergence_preserving_branching_bisimulation,
+          expected.states_divergence_preserving_branching_bisimulation,
+          expected.transitions_divergence_preserving_branching_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
+  reduce(l,lts::lts_eq_divergence_preserving_branching_bisim,4);
+  if (!test_lts(test_description + " (divergence-preserving branching bisimulation with 4 threads)",
+          l,
+          expected.labels_divergence_preserving_branching_bisimulation,
+          expected.states_divergence_preserving_branching_bisimulation,
+          expected.transitions_divergence_preserving_branching_bisimulation))
+  {
+    return false;
+  }
+  l=l_in;
   reduce(l,lts::lts_eq_weak_bisim);
   if (!test_lts(test_description + " (weak bisimulation)",
           l,
@@ -299,6 +359,16 @@ static bool reduce_lts_in_various_ways(const std::string& test_description,
     std::cerr << "LTS is non deterministic after deterministation: " << test_description << "\n";
     return false;
   }
+  l=l_in;
+  reduce(l,lts::lts_red_determinisation,4);
+  if (!test_lts(test_description + " (determinisation with 4 threads)",
+          l,
+          expected.labels_determinisation,
+          expected.states_determinisation,
+          expected.transitions_determinisation))
+  {
+    return false;
+  }
   return true;
 }
 
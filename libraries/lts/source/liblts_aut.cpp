@@ -8,7 +8,15 @@
 //
 /// \file liblts_aut.cpp
 
+#include <algorithm>
+#include <charconv>
+#include <deque>
 #include <fstream>
+#include <limits>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include "mcrl2/utilities/detail/parallel_for.h"
 #include "mcrl2/utilities/unordered_map.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
@@ -322,31 +330,6 @@ static bool read_aut_transition(
   return true;
 }
 
-static bool read_aut_transition(
-  std::istream& is,
-  std::size_t& from,
-  std::string& label,
-  std::size_t& to,
-  const std::size_t line_no)
-{
-  if (!read_initial_part_of_an_aut_transition(is,from,label,line_no))
-  {
-    return false;
-  }
-
-  is >> std::skipws >> to;
-
-  char ch;
-  is >> ch;
-  if (ch != ')')
-  {
-    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
-  }
-
-  read_newline(is,line_no);
-  return true;
-}
-
 static size_t add_probablistic_state(
                     mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& probabilistic_state,
                     probabilistic_lts_aut_t& l,
@@ -440,21 +423,338 @@ static void read_from_aut(probabilistic_lts_aut_t& l, std::istream& is)
   }
 }
 
-static void read_from_aut(lts_aut_t& l, std::istream& is)
+// A scanner for the transitions of an .aut file without probabilities that is stored in memory.
+// It avoids the overhead of reading the file character by character from a stream.
+class aut_transition_scanner
 {
-  std::size_t line_no = 1;
+  protected:
+    const char* m_current;
+    const char* m_end;
+    std::size_t m_line_no;
+
+    [[noreturn]] void error(const std::string& message) const
+    {
+      throw mcrl2::runtime_error(message + " at line " + std::to_string(m_line_no) + ".");
+    }
+
+    static bool is_space(const char ch)
+    {
+      return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\v' || ch == '\f';
+    }
+
+    void skip_whitespace()
+    {
+      while (m_current != m_end && is_space(*m_current))
+      {
+        ++m_current;
+      }
+    }
+
+    std::size_t read_number()
+    {
+      skip_whitespace();
+      if (m_current == m_end || !isdigit(static_cast<unsigned char>(*m_current)))
+      {
+        error("Expect a state number");
+      }
+
+      std::size_t result = 0;
+      for ( ; m_current != m_end && isdigit(static_cast<unsigned char>(*m_current)); ++m_current)
+      {
+        const std::size_t digit = static_cast<std::size_t>(*m_current - '0');
+        if (result > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+        {
+          error("The state number is too large");
+        }
+        result = 10 * result + digit;
+      }
+      return result;
+    }
+
+    void read_character(const char expected, const std::string& message)
+    {
+      skip_whitespace();
+      if (m_current == m_end || *m_current != expected)
+      {
+        error(message);
+      }
+      ++m_current;
+    }
+
+    // A label between quotes is taken literally. Whitespace is removed from other labels, and in the
+    // rare case that a label contains whitespace the stripped label is stored in owned_labels.
+    std::string_view read_label(std::deque<std::string>& owned_labels)
+    {
+      skip_whitespace();
+      if (m_current != m_end && *m_current == '"')
+      {
+        const char* begin = ++m_current;
+        while (m_current != m_end && *m_current != '"')
+        {
+          ++m_current;
+        }
+        if (m_current == m_end)
+        {
+          error("Expect that the second item is a quoted label (using \")");
+        }
+        std::string_view label(begin, static_cast<std::size_t>(m_current - begin));
+        ++m_current;
+        read_character(',', "Expect a comma after the quoted label");
+        return label;
+      }
+
+      const char* begin = m_current;
+      bool contains_whitespace = false;
+      while (m_current != m_end && *m_current != ',')
+      {
+        contains_whitespace = contains_whitespace || is_space(*m_current);
+        ++m_current;
+      }
+      if (m_current == m_end)
+      {
+        error("Expect a comma after the quoted label");
+      }
+      std::string_view label(begin, static_cast<std::size_t>(m_current - begin));
+      ++m_current;
+
+      if (contains_whitespace)
+      {
+        std::string& stripped = owned_labels.emplace_back();
+        for (const char ch: label)
+        {
+          if (!is_space(ch))
+          {
+            stripped.push_back(ch);
+          }
+        }
+        return stripped;
+      }
+      return label;
+    }
+
+    void read_newline()
+    {
+      while (m_current != m_end && *m_current == ' ')
+      {
+        ++m_current;
+      }
+      if (m_current != m_end && *m_current == '\r')
+      {
+        ++m_current;
+      }
+      if (m_current != m_end) // Last line does not need to be terminated with an eoln.
+      {
+        if (*m_current != '\n')
+        {
+          error("Expect a newline after the transition");
+        }
+        ++m_current;
+      }
+    }
+
+    void check_state(const std::size_t state, const std::size_t number_of_states) const
+    {
+      if (state >= number_of_states)
+      {
+        throw mcrl2::runtime_error("The state number " + std::to_string(state) + " is not below the number of states (" +
+                                   std::to_string(number_of_states) + ").  Found at line " + std::to_string(m_line_no) + ".");
+      }
+    }
+
+  public:
+    aut_transition_scanner(const char* begin, const char* end, const std::size_t line_no)
+      : m_current(begin), m_end(end), m_line_no(line_no)
+    {}
+
+    // Reads all transitions until the end of the input. The labels of the transitions are indices
+    // in labels, which contains the labels in the order in which they are encountered first. If
+    // incomplete_end holds, a transition that is cut off by the end of the input is not read, and
+    // the position where it starts is returned. Otherwise the end of the input is returned.
+    const char* read_transitions(const std::size_t number_of_states,
+                                 std::vector<transition>& transitions,
+                                 std::vector<std::string_view>& labels,
+                                 std::deque<std::string>& owned_labels,
+                                 const bool incomplete_end)
+    {
+      std::unordered_map<std::string_view, std::size_t> label_indices;
+      while (true)
+      {
+        skip_whitespace();
+        if (m_current == m_end)
+        {
+          return m_end;
+        }
+        const char* start = m_current;
+        ++m_current; // Skip the opening bracket.
+        ++m_line_no;
+
+        std::size_t from;
+        std::string_view label;
+        std::size_t to;
+        try
+        {
+          from = read_number();
+          read_character(',', "Expect that the first number is followed by a comma");
+          label = read_label(owned_labels);
+          to = read_number();
+          read_character(')', "Expect a closing bracket at the end of the transition");
+          read_newline();
+        }
+        catch (const mcrl2::runtime_error&)
+        {
+          if (incomplete_end && m_current == m_end)
+          {
+            --m_line_no;
+            return start;
+          }
+          throw;
+        }
+
+        check_state(from, number_of_states);
+        check_state(to, number_of_states);
+        auto [i, inserted] = label_indices.try_emplace(label, labels.size());
+        if (inserted)
+        {
+          labels.push_back(label);
+        }
+        transitions.emplace_back(from, i->second, to);
+      }
+    }
+};
+
+// The transitions of a consecutive part of an .aut file, together with their labels.
+struct aut_chunk
+{
+  std::vector<transition> transitions;
+  std::vector<std::string_view> labels;
+  std::deque<std::string> owned_labels;
+};
+
+// Parts of a file that are smaller than this are not worth a separate thread.
+static constexpr std::size_t minimal_aut_chunk_size = static_cast<std::size_t>(1) << 22;
+
+// Reads the transitions in [begin, end) using at most the given number of threads, where the first
+// transition is at line first_line + 1. The input is split into chunks at line boundaries that are
+// parsed independently. Such a boundary can also be located within a transition or a quoted label. In
+// that case the chunk before it cannot be parsed, and the input is read again by a single thread, which
+// also yields the proper line number in an error message. If incomplete_end holds, a transition that
+// is cut off by end is left for the next block, and rest is set to its start.
+static std::vector<aut_chunk> read_aut_transitions(const char* begin,
+                                                   const char* end,
+                                                   const std::size_t number_of_states,
+                                                   std::size_t number_of_threads,
+                                                   const std::size_t first_line,
+                                                   const bool incomplete_end,
+                                                   const char*& rest)
+{
+  const std::size_t size = static_cast<std::size_t>(end - begin);
+  number_of_threads = std::max<std::size_t>(1, std::min(number_of_threads, size / minimal_aut_chunk_size));
+
+  if (number_of_threads > 1)
+  {
+    std::vector<const char*> bounds{begin};
+    for (std::size_t i = 1; i < number_of_threads; ++i)
+    {
+      const char* bound = std::find(std::max(bounds.back(), begin + i * size / number_of_threads), end, '\n');
+      bounds.push_back(bound == end ? end : bound + 1);
+    }
+    bounds.push_back(end);
+
+    std::vector<aut_chunk> chunks(number_of_threads);
+    std::vector<char> failed(number_of_threads, false);
+    mcrl2::utilities::detail::parallel_for(number_of_threads, number_of_threads,
+      [&](const std::size_t first, const std::size_t last)
+      {
+        for (std::size_t i = first; i < last; ++i)
+        {
+          aut_chunk& chunk = chunks[i];
+          chunk.transitions.reserve(static_cast<std::size_t>(bounds[i + 1] - bounds[i]) / 16);
+          try
+          {
+            const bool is_last = i + 1 == number_of_threads;
+            const char* chunk_rest = aut_transition_scanner(bounds[i], bounds[i + 1], first_line)
+                .read_transitions(number_of_states, chunk.transitions, chunk.labels, chunk.owned_labels, is_last && incomplete_end);
+            if (is_last)
+            {
+              rest = chunk_rest;
+            }
+          }
+          catch (const mcrl2::runtime_error&)
+          {
+            failed[i] = true;
+          }
+        }
+      });
+
+    if (std::find(failed.begin(), failed.end(), true) == failed.end())
+    {
+      return chunks;
+    }
+  }
+
+  std::vector<aut_chunk> chunks(1);
+  chunks[0].transitions.reserve(size / 16);
+  rest = aut_transition_scanner(begin, end, first_line)
+      .read_transitions(number_of_states, chunks[0].transitions, chunks[0].labels, chunks[0].owned_labels, incomplete_end);
+  return chunks;
+}
+
+// Appends at most block_size characters of an .aut file to buffer, and returns whether the file
+// continues. A file ends at the end of the stream, or at the EOT character that separates two
+// files, which is removed from the stream.
+static bool read_aut_block(std::istream& is, std::string& buffer, const std::size_t block_size)
+{
+  const std::size_t size = buffer.size();
+  buffer.resize(size + block_size + 1);
+  is.getline(buffer.data() + size, static_cast<std::streamsize>(block_size + 1), '\x04');
+  const std::size_t count = static_cast<std::size_t>(is.gcount());
+
+  if (is.eof())
+  {
+    buffer.resize(size + count);
+    return false;
+  }
+  if (is.fail())
+  {
+    // The block is full.
+    is.clear();
+    buffer.resize(size + count);
+    return true;
+  }
+  buffer.resize(size + count - 1); // The EOT character is counted, but not stored.
+  return false;
+}
+
+// Reads an .aut file without probabilities from a stream, up to the end of the stream or up to the EOT
+// character that separates two files. The file is read in blocks of which the transitions are parsed by
+// number_of_threads threads, such that only one block is kept in memory.
+static void read_from_aut(lts_aut_t& l, std::istream& is, const std::size_t number_of_threads)
+{
+  const std::size_t block_size = 4 * std::max<std::size_t>(1, number_of_threads) * minimal_aut_chunk_size;
+  std::string buffer;
+  bool more = read_aut_block(is, buffer, block_size);
+
+  // The header is read from a stream, as it is short and contains a (probabilistic) state.
+  std::size_t header_end = buffer.find('\n', buffer.find(')'));
+  while (header_end == std::string::npos && more)
+  {
+    more = read_aut_block(is, buffer, block_size);
+    header_end = buffer.find('\n', buffer.find(')'));
+  }
+  const std::size_t header_size = header_end == std::string::npos ? buffer.size() : header_end + 1;
+  std::istringstream header(buffer.substr(0, header_size));
+
   std::size_t ntrans = 0;
   std::size_t nstate = 0;
-
   mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t initial_probabilistic_state;
-  read_aut_header(is,initial_probabilistic_state,ntrans,nstate);
-  
+  read_aut_header(header,initial_probabilistic_state,ntrans,nstate);
+
   if (initial_probabilistic_state.size()>1)
   {
     throw mcrl2::runtime_error("Encountered an initial probability distribution while reading an non probabilistic .aut file.");
   }
 
-  check_states(initial_probabilistic_state, nstate, line_no);
+  check_states(initial_probabilistic_state, nstate, 1);
 
   if (nstate==0)
   {
@@ -463,26 +763,50 @@ static void read_from_aut(lts_aut_t& l, std::istream& is)
 
   l.set_num_states(nstate,false);
   l.clear_transitions(ntrans); // Reserve enough space for the transitions.
-  
+  l.set_initial_state(initial_probabilistic_state.get());
+
+  // The labels of the chunks are visited in the order in which they occur in the file. Therefore,
+  // they get the same indices as when the file is read sequentially.
   mcrl2::utilities::unordered_map < action_label_string, std::size_t > action_labels;
   action_labels[action_label_string::tau_action()]=0; // A tau action is always stored at position 0.
-  l.set_initial_state(initial_probabilistic_state.get());
+  std::vector<std::size_t> label_indices;
 
-  std::size_t from;
-  std::size_t to;
-  std::string s;
-  while (!is.eof())
+  std::size_t position = header_size;
+  while (true)
   {
-    line_no++;
+    // Only complete lines are parsed when the file continues, and a transition that is cut off at the
+    // end of the block is parsed together with the next block.
+    const char* begin = buffer.data() + position;
+    const char* end = buffer.data() + buffer.size();
+    if (more)
+    {
+      const std::size_t last_newline = buffer.rfind('\n');
+      end = last_newline == std::string::npos || last_newline < position ? begin : buffer.data() + last_newline + 1;
+    }
 
-    if (!read_aut_transition(is,from,s,to,line_no))
+    const char* rest = end;
+    const std::vector<aut_chunk> chunks = read_aut_transitions(begin, end, nstate, number_of_threads, 1 + l.num_transitions(), more, rest);
+    for (const aut_chunk& chunk: chunks)
     {
-      break; // eof encountered
+      label_indices.clear();
+      for (const std::string_view& label: chunk.labels)
+      {
+        label_indices.push_back(find_label_index(std::string(label),action_labels,l));
+      }
+
+      for (const transition& t: chunk.transitions)
+      {
+        l.add_transition(transition(t.from(),label_indices[t.label()],t.to()));
+      }
     }
 
-    check_state(from, nstate, line_no);
-    check_state(to, nstate, line_no);
-    l.add_transition(transition(from,find_label_index(s,action_labels,l),to));
+    if (!more)
+    {
+      break;
+    }
+    buffer.erase(0, static_cast<std::size_t>(rest - buffer.data()));
+    position = 0;
+    more = read_aut_block(is, buffer, block_size);
   }
 
   if (ntrans != l.num_transitions())
@@ -492,6 +816,19 @@ static void read_from_aut(lts_aut_t& l, std::istream& is)
   }
 }
 
+// Reads an .aut file in blocks. As for streams, an EOT character ends the file.
+static void read_from_aut_file(lts_aut_t& l, const std::string& filename, const std::size_t number_of_threads)
+{
+  std::ifstream is(filename, std::ios::binary);
+
+  if (!is.is_open())
+  {
+    throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
+  }
+
+  read_from_aut(l, is, number_of_threads);
+}
+
 
 static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, std::ostream& os)
 {
@@ -536,17 +873,52 @@ static void write_to_aut(const probabilistic_lts_aut_t& l, std::ostream& os)
   }
 }
 
+// Appends the decimal representation of n to out.
+static void append_number(std::string& out, const std::size_t n)
+{
+  char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+  const std::to_chars_result result = std::to_chars(std::begin(digits), std::end(digits), n);
+  out.append(digits, result.ptr);
+}
+
 static void write_to_aut(const lts_aut_t& l, std::ostream& os)
 {
-  // Do not use "endl" below to avoid flushing. Use "\n" instead.
-  os << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
+  // The labels are printed only once, and the transitions are written in large blocks.
+  constexpr std::size_t block_size = static_cast<std::size_t>(1) << 16;
+  std::vector<std::string> labels;
+  labels.reserve(l.num_action_labels());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    labels.push_back(pp(l.action_label(l.apply_hidden_label_map(i))));
+  }
+
+  std::string buffer;
+  buffer.reserve(2 * block_size);
+  buffer += "des (";
+  append_number(buffer, l.initial_state());
+  buffer += ',';
+  append_number(buffer, l.num_transitions());
+  buffer += ',';
+  append_number(buffer, l.num_states());
+  buffer += ")\n";
 
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" 
-       << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\"," 
-       << t.to() << ")" << "\n";
+    buffer += '(';
+    append_number(buffer, t.from());
+    buffer += ",\"";
+    buffer += labels[t.label()];
+    buffer += "\",";
+    append_number(buffer, t.to());
+    buffer += ")\n";
+
+    if (buffer.size() >= block_size)
+    {
+      os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
   }
+  os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 }
 
 
@@ -597,29 +969,21 @@ void probabilistic_lts_aut_t::save(std::string const& filename) const
   }
 }
 
-void lts_aut_t::load(const std::string& filename)
+void lts_aut_t::load(const std::string& filename, const std::size_t number_of_threads)
 {
   if (filename.empty() || filename=="-")
   {
-    read_from_aut(*this, std::cin);
+    read_from_aut(*this, std::cin, number_of_threads);
   }
   else
   {
-    std::ifstream is(filename.c_str());
-
-    if (!is.is_open())
-    {
-      throw mcrl2::runtime_error("cannot open .aut file '" + filename + ".");
-    }
-
-    read_from_aut(*this,is);
-    is.close();
+    read_from_aut_file(*this, filename, number_of_threads);
   }
 }
 
-void lts_aut_t::load(std::istream& is)
+void lts_aut_t::load(std::istream& is, const std::size_t number_of_threads)
 {
-  read_from_aut(*this,is);
+  read_from_aut(*this, is, number_of_threads);
 }
 
 void lts_aut_t::save(std::string const& filename) const
@@ -641,6 +1005,11 @@ void lts_aut_t::save(std::string const& filename) const
   }
 }
 
+void lts_aut_t::save(std::ostream& os) const
+{
+  write_to_aut(*this,os);
+}
+
 
 }
 
@@ -9,10 +9,15 @@
 /// \file liblts_lts.cpp
 
 #include <algorithm>
+#include <array>
 #include <fstream>
+#include <mutex>
 #include <optional>
+#include <sstream>
 
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
+#include "mcrl2/utilities/bitstream.h"
+#include "mcrl2/utilities/detail/parallel_ordered_for.h"
 
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/lts_io.h"
@@ -296,8 +301,402 @@ static void read_lts(atermpp::aterm_istream& stream, LTS& lts)
   }
 }
 
+// The indexed .lts format.
+//
+// An indexed .lts file starts with indexed_lts_magic and a version number, followed by the chunks, a chunk directory
+// and the number of chunks. The directory consists of the kind, the size in bytes and the number of elements of every
+// chunk, in the order in which the chunks are stored, so the offset of a chunk is the sum of the sizes of the chunks
+// before it. All these numbers are stored as 64 bit little endian integers. Every chunk is a self contained stream,
+// such that the chunks can be encoded and decoded independently by different threads. As the directory is at the end,
+// a chunk can be written as soon as it has been encoded.
+//
+// The first chunk is the header, a binary aterm stream containing the header of the streaming format, the number of
+// states, the action labels and the initial state. It is followed by the chunks with the probabilistic states (only
+// for probabilistic transition systems), the chunks with transitions and the chunks with state labels. The
+// transitions are stored as triples (from, label, to) of integers in a bit stream, where 'label' is an index in the
+// action labels and 'to' an index in the probabilistic states for a probabilistic transition system. The other
+// chunks are binary aterm streams of which the elements are numbered consecutively over the chunks.
+//
+// As a streaming .lts file starts with a zero byte, both formats are distinguished by the first byte.
+
+static constexpr std::array<char, 8> indexed_lts_magic = { 'm', 'C', 'R', 'L', '2', 'L', 'T', 'S' };
+static constexpr std::uint64_t indexed_lts_version = 2;
+
+enum class indexed_lts_chunk : std::uint64_t
+{
+  header = 0,
+  probabilistic_states = 1,
+  transitions = 2,
+  state_labels = 3
+};
+
+/// \brief The number of elements in a chunk. These are independent of the number of threads, such that the
+///        resulting file does not depend on it.
+static constexpr std::size_t indexed_lts_transitions_per_chunk = 1 << 16;
+static constexpr std::size_t indexed_lts_terms_per_chunk = 1 << 12;
+
+/// \brief The number of chunks per thread that are encoded or decoded ahead of the chunk that is written or added
+///        to the transition system, which bounds the number of chunks in memory.
+static constexpr std::size_t indexed_lts_chunks_per_thread = 4;
+
+struct indexed_lts_chunk_info
+{
+  indexed_lts_chunk kind;
+  std::size_t first = 0;  ///< The index of the first element of the chunk, only used when writing.
+  std::size_t offset = 0; ///< The position of the chunk in the stream, only used when reading.
+  std::size_t size = 0;   ///< The number of bytes of the chunk, only used when reading.
+  std::size_t count = 0;  ///< The number of elements in the chunk.
+};
+
+static void write_uint64(std::ostream& stream, std::uint64_t value)
+{
+  std::array<char, 8> bytes;
+  for (std::size_t i = 0; i < bytes.size(); ++i)
+  {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  stream.write(bytes.data(), bytes.size());
+}
+
+static std::uint64_t read_uint64(std::istream& stream)
+{
+  std::array<char, 8> bytes;
+  if (!stream.read(bytes.data(), bytes.size()))
+  {
+    throw mcrl2::runtime_error("Unexpected end of an indexed labelled transition system (LTS) stream.");
+  }
+
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < bytes.size(); ++i)
+  {
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+  }
+  return value;
+}
+
+/// \brief The decoded contents of a chunk of an indexed .lts file.
+struct indexed_lts_chunk_contents
+{
+  std::vector<transition> transitions;
+  std::vector<state_label_lts> state_labels;
+  std::vector<probabilistic_lts_lts_t::probabilistic_state_t> probabilistic_states;
+};
+
+static void decode_chunk(const indexed_lts_chunk_info& info, std::string& bytes, indexed_lts_chunk_contents& result)
+{
+  std::istringstream buffer(std::move(bytes));
+  if (info.kind == indexed_lts_chunk::transitions)
+  {
+    mcrl2::utilities::ibitstream stream(buffer);
+    result.transitions.reserve(info.count);
+    for (std::size_t i = 0; i < info.count; ++i)
+    {
+      const std::size_t from = stream.read_integer();
+      const std::size_t label = stream.read_integer();
+      const std::size_t to = stream.read_integer();
+      result.transitions.emplace_back(from, label, to);
+    }
+    return;
+  }
+
+  atermpp::binary_aterm_istream stream(buffer);
+  stream >> data::detail::add_index_impl;
+  if (info.kind == indexed_lts_chunk::state_labels)
+  {
+    result.state_labels.resize(info.count);
+    for (state_label_lts& label: result.state_labels)
+    {
+      stream >> label;
+    }
+  }
+  else if (info.kind == indexed_lts_chunk::probabilistic_states)
+  {
+    result.probabilistic_states.resize(info.count);
+    for (probabilistic_lts_lts_t::probabilistic_state_t& state: result.probabilistic_states)
+    {
+      stream >> state;
+    }
+  }
+  else
+  {
+    throw mcrl2::runtime_error("Unknown chunk in indexed labelled transition system (LTS) stream.");
+  }
+}
+
+/// \brief Reads the chunk directory at the end of an indexed .lts file, of which the chunks start at offset first
+///        and the file ends at offset last, and checks that it describes the chunks in between.
+static std::vector<indexed_lts_chunk_info> read_indexed_lts_directory(std::istream& input, std::size_t first, std::size_t last)
+{
+  auto corrupt = []()
+  {
+    return mcrl2::runtime_error("The chunk directory of the indexed labelled transition system (LTS) stream is corrupt.");
+  };
+
+  constexpr std::size_t entry_size = 3 * sizeof(std::uint64_t);
+  if (last < first + sizeof(std::uint64_t))
+  {
+    throw corrupt();
+  }
+  input.seekg(last - sizeof(std::uint64_t));
+  const std::uint64_t number_of_chunks = read_uint64(input);
+  const std::size_t available = last - first - sizeof(std::uint64_t);
+  if (number_of_chunks == 0 || number_of_chunks > available / entry_size)
+  {
+    throw corrupt();
+  }
+
+  std::vector<indexed_lts_chunk_info> directory(number_of_chunks);
+  std::size_t offset = first;
+  const std::size_t end_of_chunks = last - sizeof(std::uint64_t) - number_of_chunks * entry_size;
+  input.seekg(end_of_chunks);
+  for (std::size_t i = 0; i < directory.size(); ++i)
+  {
+    indexed_lts_chunk_info& info = directory[i];
+    const std::uint64_t kind = read_uint64(input);
+    info.size = read_uint64(input);
+    info.count = read_uint64(input);
+
+    // The chunks are ordered by their kind, and every element takes at least one bit.
+    if (kind > static_cast<std::uint64_t>(indexed_lts_chunk::state_labels)
+        || (i == 0) != (kind == static_cast<std::uint64_t>(indexed_lts_chunk::header))
+        || (i > 0 && kind < static_cast<std::uint64_t>(directory[i - 1].kind))
+        || info.size > end_of_chunks - offset
+        || info.count / 8 > info.size)
+    {
+      throw corrupt();
+    }
+    info.kind = static_cast<indexed_lts_chunk>(kind);
+    info.offset = offset;
+    offset += info.size;
+  }
+
+  if (offset != end_of_chunks)
+  {
+    throw corrupt();
+  }
+  return directory;
+}
+
+/// \brief Checks that all states of a probabilistic state are smaller than number_of_states.
+static void check_probabilistic_state(const probabilistic_lts_lts_t::probabilistic_state_t& state, std::size_t number_of_states)
+{
+  bool valid = true;
+  if (state.size() == 0)
+  {
+    valid = state.get() < number_of_states;
+  }
+  for (const auto& p: state)
+  {
+    valid = valid && p.state() < number_of_states;
+  }
+  if (!valid)
+  {
+    throw mcrl2::runtime_error("Probabilistic state with an unknown state in labelled transition system (LTS) stream.");
+  }
+}
+
+/// \brief Reads an indexed .lts file. The chunks are read when they are decoded, using number_of_threads threads,
+///        and at most indexed_lts_chunks_per_thread chunks per thread are kept in memory.
+/// \details The chunks are read at the offsets in the directory, so a stream that cannot be positioned, such as
+///          standard input, is read into memory first.
+template <class LTS>
+static void read_indexed_lts(std::istream& original_input, LTS& lts, std::size_t number_of_threads)
+{
+  std::stringstream buffered_input;
+  std::istream* input = &original_input;
+  std::streamoff start = original_input.tellg();
+  if (start < 0 || !original_input.seekg(0, std::ios_base::end))
+  {
+    original_input.clear();
+    buffered_input << original_input.rdbuf();
+    input = &buffered_input;
+    start = 0;
+    input->seekg(0, std::ios_base::end);
+  }
+  const std::streamoff length = static_cast<std::streamoff>(input->tellg()) - start;
+  input->seekg(start);
+
+  std::array<char, indexed_lts_magic.size()> magic;
+  if (!input->read(magic.data(), magic.size()) || magic != indexed_lts_magic)
+  {
+    throw mcrl2::runtime_error("Stream does not contain an indexed labelled transition system (LTS).");
+  }
+  const std::uint64_t version = read_uint64(*input);
+  if (version != indexed_lts_version)
+  {
+    throw mcrl2::runtime_error("The version (" + std::to_string(version) + ") of the indexed labelled transition system (LTS) is incompatible with the version (" + std::to_string(indexed_lts_version) + ") of this tool.");
+  }
+
+  const std::vector<indexed_lts_chunk_info> directory =
+    read_indexed_lts_directory(*input, start + indexed_lts_magic.size() + sizeof(std::uint64_t), start + length);
+
+  // Reads the bytes of a chunk. The threads take turns reading from the stream, as it has a single position.
+  std::mutex input_mutex;
+  auto read_chunk = [&](const indexed_lts_chunk_info& info)
+  {
+    std::string bytes(info.size, '\0');
+    std::lock_guard<std::mutex> guard(input_mutex);
+    input->seekg(info.offset);
+    if (!input->read(bytes.data(), bytes.size()))
+    {
+      throw mcrl2::runtime_error("Unexpected end of an indexed labelled transition system (LTS) stream.");
+    }
+    return bytes;
+  };
+
+  // Read the header.
+  std::size_t number_of_states;
+  probabilistic_lts_lts_t::probabilistic_state_t initial_state;
+  {
+    std::istringstream buffer(read_chunk(directory[0]));
+    atermpp::binary_aterm_istream stream(buffer);
+    stream >> data::detail::add_index_impl;
+
+    atermpp::aterm marker;
+    stream >> marker;
+    if (marker != labelled_transition_system_mark())
+    {
+      throw mcrl2::runtime_error("Stream does not contain a labelled transition system (LTS).");
+    }
+
+    data::data_specification spec;
+    data::variable_list parameters;
+    process::action_label_list action_labels;
+    stream >> spec;
+    stream >> parameters;
+    stream >> action_labels;
+
+    lts.set_data(spec);
+    lts.set_process_parameters(parameters);
+    lts.set_action_label_declarations(action_labels);
+
+    atermpp::aterm_int value;
+    stream >> value;
+    number_of_states = value.value();
+
+    // The actions are stored in the order of their indices, where the first one is tau.
+    stream >> value;
+    action_label_lts action;
+    for (std::size_t i = 0; i < value.value(); ++i)
+    {
+      stream >> action;
+      if (i > 0)
+      {
+        [[maybe_unused]]
+        std::size_t actual_index = lts.add_action(action);
+        assert(actual_index == i);
+      }
+    }
+
+    stream >> marker;
+    if (marker != initial_state_mark())
+    {
+      throw mcrl2::runtime_error("Missing initial state in labelled transition system (LTS) stream.");
+    }
+    stream >> initial_state;
+    check_probabilistic_state(initial_state, number_of_states);
+  }
+
+  bool has_state_labels = false;
+  bool is_probabilistic = false;
+  std::size_t number_of_transitions = 0;
+  std::size_t number_of_probabilistic_states = 0;
+  for (const indexed_lts_chunk_info& info: directory)
+  {
+    has_state_labels = has_state_labels || info.kind == indexed_lts_chunk::state_labels;
+    is_probabilistic = is_probabilistic || info.kind == indexed_lts_chunk::probabilistic_states;
+    number_of_transitions += info.kind == indexed_lts_chunk::transitions ? info.count : 0;
+    number_of_probabilistic_states += info.kind == indexed_lts_chunk::probabilistic_states ? info.count : 0;
+  }
+  lts.get_transitions().reserve(number_of_transitions);
+  if (has_state_labels)
+  {
+    lts.state_labels().reserve(std::min(number_of_states, static_cast<std::size_t>(length)));
+  }
+
+  // The targets of transitions are probabilistic states in a probabilistic stream, and states otherwise.
+  const std::size_t number_of_targets = is_probabilistic ? number_of_probabilistic_states : number_of_states;
+
+  // The probabilistic states of the stream, and the indices of the states of a non probabilistic stream that is read
+  // as a probabilistic transition system.
+  std::vector<probabilistic_lts_lts_t::probabilistic_state_t> probabilistic_states;
+  mcrl2::utilities::indexed_set<probabilistic_lts_lts_t::probabilistic_state_t> target_states;
+
+  utilities::detail::parallel_ordered_for<indexed_lts_chunk_contents>(directory.size() - 1, number_of_threads,
+    indexed_lts_chunks_per_thread * number_of_threads,
+    []() { return 0; },
+    [&](int, std::size_t i, indexed_lts_chunk_contents& result)
+    {
+      std::string bytes = read_chunk(directory[i + 1]);
+      decode_chunk(directory[i + 1], bytes, result);
+    },
+    [&](std::size_t, indexed_lts_chunk_contents& result)
+    {
+      for (const probabilistic_lts_lts_t::probabilistic_state_t& state: result.probabilistic_states)
+      {
+        check_probabilistic_state(state, number_of_states);
+        if constexpr (std::is_same_v<LTS, probabilistic_lts_lts_t>)
+        {
+          lts.add_probabilistic_state(state);
+        }
+        else
+        {
+          if (state.size() > 1)
+          {
+            throw mcrl2::runtime_error("Attempting to read a probabilistic LTS as a regular LTS.");
+          }
+          probabilistic_states.push_back(state);
+        }
+      }
+
+      for (const transition& trans: result.transitions)
+      {
+        if (trans.label() >= lts.num_action_labels())
+        {
+          throw mcrl2::runtime_error("Transition with an unknown action label in labelled transition system (LTS) stream.");
+        }
+        if (trans.from() >= number_of_states || trans.to() >= number_of_targets)
+        {
+          throw mcrl2::runtime_error("Transition with an unknown state in labelled transition system (LTS) stream.");
+        }
+
+        std::size_t to = trans.to();
+        if constexpr (std::is_same_v<LTS, probabilistic_lts_lts_t>)
+        {
+          if (!is_probabilistic)
+          {
+            // Every target state must become a probabilistic state.
+            bool inserted;
+            std::tie(to, inserted) = target_states.insert(probabilistic_lts_lts_t::probabilistic_state_t(trans.to()));
+            if (inserted)
+            {
+              lts.add_probabilistic_state(probabilistic_lts_lts_t::probabilistic_state_t(trans.to()));
+            }
+          }
+        }
+        else if (is_probabilistic)
+        {
+          to = probabilistic_states[to].get();
+        }
+        lts.add_transition(transition(trans.from(), trans.label(), to));
+      }
+
+      for (const state_label_lts& label: result.state_labels)
+      {
+        lts.state_labels().push_back(label);
+      }
+    });
+
+  if (has_state_labels && lts.state_labels().size() != number_of_states)
+  {
+    throw mcrl2::runtime_error("The number of state labels does not match the number of states in labelled transition system (LTS) stream.");
+  }
+  lts.set_num_states(number_of_states, has_state_labels);
+  set_initial_state(lts, initial_state);
+}
+
 template <class LTS_TRANSITION_SYSTEM>     
-static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filename, std::size_t number_of_threads)
 {
   static_assert(std::is_same_v<LTS_TRANSITION_SYSTEM, probabilistic_lts_lts_t>
                     || std::is_same_v<LTS_TRANSITION_SYSTEM, lts_lts_t>,
@@ -322,8 +721,16 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
 
   try
   {
-    atermpp::binary_aterm_istream stream(filename.empty() ? std::cin : fstream);
-    stream >> lts;
+    std::istream& input = filename.empty() ? std::cin : fstream;
+    if (input.peek() == indexed_lts_magic[0])
+    {
+      read_indexed_lts(input, lts, number_of_threads);
+    }
+    else
+    {
+      atermpp::binary_aterm_istream stream(input);
+      stream >> lts;
+    }
   }
   catch (const std::exception& ex)
   {
@@ -390,8 +797,109 @@ static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
   write_initial_state(stream, lts);
 }
 
+template <class LTS>
+static void encode_chunk(const LTS& lts, const indexed_lts_chunk_info& info, std::string& result)
+{
+  std::ostringstream buffer;
+  if (info.kind == indexed_lts_chunk::transitions)
+  {
+    mcrl2::utilities::obitstream stream(buffer);
+    for (std::size_t i = info.first; i < info.first + info.count; ++i)
+    {
+      const transition& trans = lts.get_transitions()[i];
+      stream.write_integer(trans.from());
+      stream.write_integer(lts.apply_hidden_label_map(trans.label()));
+      stream.write_integer(trans.to());
+    }
+  }
+  else
+  {
+    atermpp::binary_aterm_ostream stream(buffer);
+    if (info.kind == indexed_lts_chunk::header)
+    {
+      write_lts_header(stream, lts.data(), lts.process_parameters(), lts.action_label_declarations());
+      stream << atermpp::aterm_int(lts.num_states());
+      stream << atermpp::aterm_int(lts.num_action_labels());
+      for (std::size_t i = 0; i < lts.num_action_labels(); ++i)
+      {
+        stream << lts.action_label(i);
+      }
+      write_initial_state(stream, lts);
+    }
+    else
+    {
+      stream << data::detail::remove_index_impl;
+      for (std::size_t i = info.first; i < info.first + info.count; ++i)
+      {
+        if (info.kind == indexed_lts_chunk::state_labels)
+        {
+          stream << lts.state_label(i);
+        }
+        else if constexpr (std::is_same_v<LTS, probabilistic_lts_lts_t>)
+        {
+          stream << lts.probabilistic_state(i);
+        }
+      }
+    }
+  }
+  result = std::move(buffer).str();
+}
+
+template <class LTS>
+static void write_indexed_lts(std::ostream& output, const LTS& lts, std::size_t number_of_threads)
+{
+  std::vector<indexed_lts_chunk_info> directory;
+  auto add_chunks = [&directory](indexed_lts_chunk kind, std::size_t n, std::size_t chunk_size)
+  {
+    for (std::size_t first = 0; first < n; first += chunk_size)
+    {
+      directory.push_back(indexed_lts_chunk_info{kind, first, 0, 0, std::min(chunk_size, n - first)});
+    }
+  };
+
+  directory.push_back(indexed_lts_chunk_info{indexed_lts_chunk::header, 0, 0, 0, 1});
+  if constexpr (std::is_same_v<LTS, probabilistic_lts_lts_t>)
+  {
+    add_chunks(indexed_lts_chunk::probabilistic_states, lts.num_probabilistic_states(), indexed_lts_terms_per_chunk);
+  }
+  add_chunks(indexed_lts_chunk::transitions, lts.num_transitions(), indexed_lts_transitions_per_chunk);
+  if (lts.has_state_info())
+  {
+    add_chunks(indexed_lts_chunk::state_labels, lts.num_state_labels(), indexed_lts_terms_per_chunk);
+  }
+
+  // The chunks are written as soon as they are encoded, and their sizes are stored in the directory afterwards.
+  output.write(indexed_lts_magic.data(), indexed_lts_magic.size());
+  write_uint64(output, indexed_lts_version);
+  utilities::detail::parallel_ordered_for<std::string>(directory.size(), number_of_threads,
+    indexed_lts_chunks_per_thread * number_of_threads,
+    []() { return 0; },
+    [&](int, std::size_t i, std::string& result)
+    {
+      encode_chunk(lts, directory[i], result);
+    },
+    [&](std::size_t i, std::string& result)
+    {
+      output.write(result.data(), result.size());
+      directory[i].size = result.size();
+    });
+
+  for (const indexed_lts_chunk_info& info: directory)
+  {
+    write_uint64(output, static_cast<std::uint64_t>(info.kind));
+    write_uint64(output, info.size);
+    write_uint64(output, info.count);
+  }
+  write_uint64(output, directory.size());
+  output.flush();
+  if (!output)
+  {
+    throw mcrl2::runtime_error("Could not write the indexed labelled transition system (LTS).");
+  }
+}
+
 template <class LTS_TRANSITION_SYSTEM>
-static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& filename, std::optional<std::size_t> indexed_threads)
 {
   static_assert(std::is_same_v<LTS_TRANSITION_SYSTEM, probabilistic_lts_lts_t>
                     || std::is_same_v<LTS_TRANSITION_SYSTEM, lts_lts_t>,
@@ -410,8 +918,16 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
 
   try
   {
-    atermpp::binary_aterm_ostream stream(to_stdout ? std::cout : fstream);
-    stream << lts;
+    std::ostream& output = to_stdout ? std::cout : fstream;
+    if (indexed_threads)
+    {
+      write_indexed_lts(output, lts, *indexed_threads);
+    }
+    else
+    {
+      atermpp::binary_aterm_ostream stream(output);
+      stream << lts;
+    }
   }
   catch (const std::exception& ex)
   {
@@ -502,25 +1018,37 @@ void write_initial_state(atermpp::aterm_ostream& stream, std::size_t index)
 void probabilistic_lts_lts_t::save(const std::string& filename) const
 {
   mCRL2log(log::verbose) << "Starting to save a probabilistic lts to the file " << filename << ".\n";
-  detail::write_to_lts(*this, filename);
+  detail::write_to_lts(*this, filename, std::nullopt);
+}
+
+void probabilistic_lts_lts_t::save_indexed(const std::string& filename, std::size_t number_of_threads) const
+{
+  mCRL2log(log::verbose) << "Starting to save a probabilistic lts in the indexed format to the file " << filename << ".\n";
+  detail::write_to_lts(*this, filename, number_of_threads);
 }
 
 void lts_lts_t::save(std::string const& filename) const
 {
   mCRL2log(log::verbose) << "Starting to save an lts to the file " << filename << ".\n";
-  detail::write_to_lts(*this, filename);
+  detail::write_to_lts(*this, filename, std::nullopt);
+}
+
+void lts_lts_t::save_indexed(const std::string& filename, std::size_t number_of_threads) const
+{
+  mCRL2log(log::verbose) << "Starting to save an lts in the indexed format to the file " << filename << ".\n";
+  detail::write_to_lts(*this, filename, number_of_threads);
 }
 
-void probabilistic_lts_lts_t::load(const std::string& filename)
+void probabilistic_lts_lts_t::load(const std::string& filename, std::size_t number_of_threads)
 {
   mCRL2log(log::verbose) << "Starting to load a probabilistic lts from the file " << filename << ".\n";
-  detail::read_from_lts(*this, filename);
+  detail::read_from_lts(*this, filename, number_of_threads);
 }
 
-void lts_lts_t::load(const std::string& filename)
+void lts_lts_t::load(const std::string& filename, std::size_t number_of_threads)
 {
   mCRL2log(log::verbose) << "Starting to load an lts from the file " << filename << ".\n";
-  detail::read_from_lts(*this, filename);
+  detail::read_from_lts(*this, filename, number_of_threads);
 }
 
 } // namespace mcrl2::lts
@@ -239,6 +239,32 @@ BOOST_AUTO_TEST_CASE(test_bisim_a_b)
   BOOST_CHECK(!compare(a,b,lts_eq_bisim, true));
 }
 
+static std::string trace_counter_example(const std::string& s1, const std::string& s2, lts_equivalence eq)
+{
+  const std::string filename = "compare_trace_counter_example.mcf";
+  lts_aut_t t1=parse_aut(s1);
+  lts_aut_t t2=parse_aut(s2);
+  BOOST_CHECK(!compare(t1, t2, eq, true, filename));
+  std::ifstream file(filename);
+  std::stringstream formula;
+  formula << file.rdbuf();
+  return formula.str();
+}
+
+// The counter example is a shortest trace that distinguishes the LTSs, as a formula that holds in the first LTS.
+BOOST_AUTO_TEST_CASE(test_trace_counter_example)
+{
+  BOOST_CHECK_EQUAL(trace_counter_example(lts1,l4,lts_eq_trace), "<a><c>true");
+  BOOST_CHECK_EQUAL(trace_counter_example(l4,lts1,lts_eq_trace), "!(<a><c>true)");
+  BOOST_CHECK_EQUAL(trace_counter_example(l4,l3,lts_eq_weak_trace), "!(<tau*><a><tau*><c>true)");
+
+  // Only the second LTS can do c, which is shorter than the trace a.a.b that only the first LTS can do.
+  const std::string aab = "des(0,3,4)\n(0,\"a\",1)\n(1,\"a\",2)\n(2,\"b\",3)\n";
+  const std::string aa_c = "des(0,3,4)\n(0,\"a\",1)\n(1,\"a\",2)\n(0,\"c\",3)\n";
+  BOOST_CHECK_EQUAL(trace_counter_example(aab,aa_c,lts_eq_trace), "!(<c>true)");
+  BOOST_CHECK_EQUAL(trace_counter_example(aa_c,aab,lts_eq_trace), "<c>true");
+}
+
 // a.(b.c1+d1) + a.(b.c2+d2)
   const std::string failures_law_left_hand_side =
    "des(0,8,6)\n"
@@ -53,7 +53,9 @@ void run_generatelts(
   lps::exploration_strategy estrategy,
   lts::lts_type output_format,
   const std::string& outputfile,
-  const std::string& priority_action
+  const std::string& priority_action,
+  std::size_t number_of_threads = 1,
+  bool save_at_end = true
 )
 {
   lps::explorer_options options;
@@ -61,7 +63,8 @@ void run_generatelts(
   options.confluence_action = priority_action;
   options.rewrite_strategy = rstrategy;
   options.search_strategy = estrategy;
-  options.save_at_end = true;
+  options.save_at_end = save_at_end;
+  options.number_of_threads = number_of_threads;
 
   bool is_timed = stochastic_lpsspec.process().has_time();
 
@@ -80,7 +83,7 @@ void run_generatelts(
   else
   {
     lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
-    auto builder = create_lts_builder(lpsspec, options, output_format);
+    auto builder = create_lts_builder(lpsspec, options, output_format, outputfile);
     if (is_timed)
     {
       generate_state_space<false, true>(lpsspec, *builder, outputfile, options);
@@ -101,7 +104,9 @@ void check_lts(
   std::size_t expected_states,
   std::size_t expected_transitions,
   std::size_t expected_labels,
-  const std::string& priority_action = ""
+  const std::string& priority_action = "",
+  std::size_t number_of_threads = 1,
+  bool save_at_end = true
 )
 {
   std::cerr << "Translating LPS to LTS with exploration strategy " << estrategy << ", rewrite strategy " << rstrategy << "." << std::endl;
@@ -109,7 +114,7 @@ void check_lts(
   LTSType result;
   lts::lts_type output_format = result.type();
   std::string outputfile = static_cast<std::string>(boost::unit_test::framework::current_test_case().p_name) + ".generatelts" + file_extension(output_format);
-  run_generatelts(stochastic_lpsspec, rstrategy, estrategy, output_format, outputfile, priority_action);
+  run_generatelts(stochastic_lpsspec, rstrategy, estrategy, output_format, outputfile, priority_action, number_of_threads, save_at_end);
   result.load(outputfile);
 
   BOOST_CHECK_EQUAL(result.num_states(), expected_states);
@@ -659,4 +664,23 @@ BOOST_AUTO_TEST_CASE(test_whether_action_a_b_and_b_a_are_the_same)   // Related
   check_lps2lts_specification(spec, 1, 2, 2);
 }
 
+BOOST_AUTO_TEST_CASE(test_multiple_threads)
+{
+  std::string spec(
+    "act a: Nat;\n"
+    "    b;\n"
+    "proc P(n: Nat) = (n < 100) -> a(n mod 3) . P(n + 1)\n"
+    "               + (n < 100) -> b . P(n + 2)\n"
+    "               + delta;\n"
+    "init P(0);\n"
+  );
+  lps::stochastic_specification lpsspec;
+  parse_lps(spec, lpsspec);
 
+  // The transitions are buffered per thread, both when the LTS is kept in memory and when it is written to disk.
+  for (bool save_at_end: { true, false })
+  {
+    check_lts<lts::lts_aut_t>("AUT", lpsspec, data::jitty, lps::es_breadth, 102, 200, 5, "", 4, save_at_end);
+    check_lts<lts::lts_lts_t>("LTS", lpsspec, data::jitty, lps::es_breadth, 102, 200, 5, "", 4, save_at_end);
+  }
+}
@@ -12,6 +12,9 @@
 #define BOOST_TEST_MODULE lts_test
 #include <boost/test/included/unit_test.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 #include "mcrl2/lts/test/test_reductions.h"
 
 using namespace mcrl2;
@@ -290,6 +293,186 @@ BOOST_AUTO_TEST_CASE(reduce_peterson)
   BOOST_CHECK(reduce_lts_in_various_ways("Peterson protocol", PETERSON_AUT, expected));
 }
 
+// Generates random transition systems in the aut format for the tests below. A linear congruential generator is
+// used, such that the transition systems only depend on the seed.
+class random_lts_generator
+{
+  protected:
+    std::size_t m_seed;
+
+  public:
+    explicit random_lts_generator(const std::size_t seed)
+      : m_seed(seed)
+    {}
+
+    // Returns a random number in [0, n).
+    std::size_t operator()(const std::size_t n)
+    {
+      m_seed = m_seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      return static_cast<std::size_t>(m_seed >> 33) % n;
+    }
+
+    // Returns a transition system with the given number of states and transitions, where the label of every
+    // transition is drawn from labels. A label can occur several times in labels to make it more likely.
+    std::string automaton(const std::size_t states, const std::size_t transitions, const std::vector<std::string>& labels)
+    {
+      std::ostringstream result;
+      result << "des (0," << transitions << "," << states << ")\n";
+      for (std::size_t j = 0; j < transitions; ++j)
+      {
+        const std::string& label = labels[(*this)(labels.size())];
+        const std::size_t from = (*this)(states);
+        result << "(" << from << "," << label << "," << (*this)(states) << ")\n";
+      }
+      return result.str();
+    }
+};
+
+// Weak bisimulation used to be calculated as strong bisimulation on the transitive tau closure. This checks that the
+// on the fly signatures yield the same quotient for random transition systems with many tau transitions.
+BOOST_AUTO_TEST_CASE(weak_bisimulation_without_tau_closure)
+{
+  random_lts_generator random(12345);
+
+  // Random transition systems make the branching bisimulation algorithm warn about its complexity.
+  const log::log_level_t reporting_level = log::logger::get_reporting_level();
+  log::logger::set_reporting_level(log::error);
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    const std::size_t states = 2 + random(30);
+    const std::size_t transitions = random(3 * states);
+    const std::string automaton = random.automaton(states, transitions, {"tau", "tau", "a", "b"});
+
+    for (bool preserve_divergences: {false, true})
+    {
+      std::istringstream is(automaton);
+      lts::lts_aut_t l;
+      l.load(is);
+      lts::lts_aut_t closure(l);
+
+      lts::detail::weak_bisimulation_reduce(l, preserve_divergences);
+
+      lts::detail::bisimulation_reduce_dnj(closure, true, preserve_divergences);
+      std::size_t divergence_label = 0;
+      if (preserve_divergences)
+      {
+        divergence_label = lts::detail::mark_explicit_divergence_transitions(closure);
+      }
+      lts::detail::reflexive_transitive_tau_closure(closure);
+      lts::detail::bisimulation_reduce_dnj(closure, false, false);
+      lts::scc_reduce(closure);
+      lts::detail::remove_redundant_transitions(closure);
+      if (preserve_divergences)
+      {
+        lts::detail::unmark_explicit_divergence_transitions(closure, divergence_label);
+      }
+
+      // Both are minimal modulo strong bisimulation, so they are isomorphic iff they are strongly bisimilar.
+      BOOST_CHECK_EQUAL(l.num_states(), closure.num_states());
+      BOOST_CHECK_EQUAL(l.num_transitions(), closure.num_transitions());
+      BOOST_CHECK(lts::detail::destructive_bisimulation_compare_dnj(l, closure));
+    }
+  }
+  log::logger::set_reporting_level(reporting_level);
+}
+
+// The failures and failures-divergence refinement checks explore the pairs of a breadth-first layer with several
+// threads. This checks on random transition systems that the verdict and the counterexample do not depend on the
+// number of threads.
+BOOST_AUTO_TEST_CASE(failures_refinement_with_multiple_threads)
+{
+  random_lts_generator random(54321);
+  const auto random_automaton = [&](const std::size_t states)
+  {
+    return random.automaton(states, states + random(3 * states), {"tau", "a", "b", "c", "c"});
+  };
+
+  std::size_t violations = 0;
+  for (std::size_t i = 0; i < 40; ++i)
+  {
+    const std::string impl = random_automaton(20 + random(40));
+    const std::string spec = random_automaton(20 + random(40));
+    for (lts::refinement_type refinement: {lts::refinement_type::failures, lts::refinement_type::failures_divergence})
+    {
+      for (bool weak_reduction: {false, true})
+      {
+        std::vector<std::optional<std::vector<std::size_t>>> results;
+        for (std::size_t number_of_threads: {1, 4})
+        {
+          std::istringstream impl_stream(impl);
+          std::istringstream spec_stream(spec);
+          lts::lts_aut_t l1;
+          lts::lts_aut_t l2;
+          l1.load(impl_stream);
+          l2.load(spec_stream);
+          const std::size_t init_l2 = l2.initial_state() + l1.num_states();
+          lts::detail::merge(l1, l2);
+
+          const lts::detail::lts_cache<lts::lts_aut_t> weak_property_cache(l1, weak_reduction);
+          lts::detail::macro_state_store store;
+          lts::detail::counter_example_constructor counter_example("", "", false);
+          const std::optional<std::size_t> index = lts::detail::find_refinement_counter_example(l1,
+              weak_property_cache,
+              store,
+              l1.initial_state(),
+              init_l2,
+              refinement,
+              weak_reduction,
+              lps::exploration_strategy::es_breadth,
+              counter_example,
+              number_of_threads);
+          results.emplace_back();
+          if (index)
+          {
+            results.back() = counter_example.get_label_indices(*index);
+          }
+        }
+        BOOST_CHECK(results[0] == results[1]);
+        violations += results[0].has_value() ? 1 : 0;
+      }
+    }
+  }
+  // Both verdicts must occur for the comparison to be meaningful.
+  BOOST_CHECK(0 < violations && violations < 160);
+}
+
+// Merging bisimilar states during the subset construction must yield a deterministic LTS that is bisimilar to the
+// result of the plain subset construction. This is checked on random transition systems, where the explored states
+// are minimised after every batch.
+BOOST_AUTO_TEST_CASE(determinise_with_incremental_minimisation)
+{
+  random_lts_generator random(2718);
+
+  // Random transition systems make the branching bisimulation algorithm warn about its complexity.
+  const log::log_level_t reporting_level = log::logger::get_reporting_level();
+  log::logger::set_reporting_level(log::error);
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const std::size_t states = 2 + random(20);
+    const std::size_t transitions = random(3 * states);
+    const std::string automaton = random.automaton(states, transitions, {"a", "b", "c"});
+
+    std::istringstream is(automaton);
+    lts::lts_aut_t l;
+    l.load(is);
+    lts::determinise(l);
+
+    for (std::size_t number_of_threads: {1, 4})
+    {
+      std::istringstream is(automaton);
+      lts::lts_aut_t minimised;
+      minimised.load(is);
+      lts::detail::subset_construction(minimised, number_of_threads, 1);
+      BOOST_CHECK(is_deterministic(minimised));
+      BOOST_CHECK(minimised.num_states() <= l.num_states());
+
+      lts::lts_aut_t determinised(l);
+      BOOST_CHECK(lts::detail::destructive_bisimulation_compare_dnj(determinised, minimised));
+    }
+  }
+  log::logger::set_reporting_level(reporting_level);
+}
+
 BOOST_AUTO_TEST_CASE(test_reachability)
 {
   std::string REACH =
@@ -843,3 +1026,181 @@ BOOST_AUTO_TEST_CASE(hide_actions5)
 }
 
 
+
+// Checks the different ways in which transitions can be written in an .aut file, and that a
+// file ends at an EOT character when it is read from a stream.
+BOOST_AUTO_TEST_CASE(read_and_write_aut)
+{
+  std::string automaton =
+     "des (0,5,3)\n"
+     "(0,\"a\",1)\n"
+     "( 1 , b , 2 )  \r\n"
+     "(2,\"c(1, 2)\",0)\n"
+     "(1,\"b|a\",1)\n"
+     "(2, tau ,1)"
+     "\x04"
+     "des (0,0,1)\n";
+
+  std::istringstream is(automaton);
+  lts::lts_aut_t l;
+  l.load(is);
+  BOOST_CHECK_EQUAL(l.num_states(), 3u);
+  BOOST_CHECK_EQUAL(l.num_transitions(), 5u);
+  BOOST_CHECK_EQUAL(l.num_action_labels(), 5u);
+  BOOST_CHECK(l.get_transitions()[4].label() == 0);
+
+  std::ostringstream os;
+  l.save(os);
+  BOOST_CHECK_EQUAL(os.str(),
+     "des (0,5,3)\n"
+     "(0,\"a\",1)\n"
+     "(1,\"b\",2)\n"
+     "(2,\"c(1, 2)\",0)\n"
+     "(1,\"a|b\",1)\n"
+     "(2,\"tau\",1)\n");
+
+  lts::lts_aut_t l_next;
+  l_next.load(is);
+  BOOST_CHECK_EQUAL(l_next.num_states(), 1u);
+  BOOST_CHECK_EQUAL(l_next.num_transitions(), 0u);
+}
+
+// Reads an .aut file that is larger than the blocks in which it is read, and of which the transitions span several
+// lines, such that transitions are cut off at the end of a block. Also checks that a too large state number is rejected.
+BOOST_AUTO_TEST_CASE(read_aut_in_blocks)
+{
+  const std::size_t number_of_states = 100000;
+  const std::size_t number_of_transitions = 1500000;
+  std::string automaton = "des (0," + std::to_string(number_of_transitions) + "," + std::to_string(number_of_states) + ")\n";
+  for (std::size_t i = 0; i < number_of_transitions; ++i)
+  {
+    automaton += "(" + std::to_string(i % number_of_states) + ",\n\"a" + std::to_string(i % 7) + "\",\n"
+               + std::to_string((7 * i) % number_of_states) + ")\n";
+  }
+
+  for (std::size_t threads: {1, 2})
+  {
+    std::istringstream is(automaton);
+    lts::lts_aut_t l;
+    l.load(is, threads);
+    BOOST_REQUIRE_EQUAL(l.num_transitions(), number_of_transitions);
+    BOOST_CHECK_EQUAL(l.num_action_labels(), 8u);
+    bool correct = true;
+    for (std::size_t i = 0; i < number_of_transitions; ++i)
+    {
+      const lts::transition& t = l.get_transitions()[i];
+      correct = correct && t.from() == i % number_of_states && t.to() == (7 * i) % number_of_states
+                && l.action_label(t.label()) == lts::action_label_string("a" + std::to_string(i % 7));
+    }
+    BOOST_CHECK(correct);
+  }
+
+  std::istringstream is("des (0,1,2)\n(0,\"a\",123456789012345678901234567890)\n");
+  lts::lts_aut_t l;
+  BOOST_CHECK_THROW(l.load(is), mcrl2::runtime_error);
+}
+
+// Writes an lts with several chunks of transitions and state labels in the indexed .lts format, and checks that it is
+// read back identically, independent of the number of threads, and that the streaming format remains readable.
+BOOST_AUTO_TEST_CASE(read_and_write_indexed_lts)
+{
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::string indexed_file = (directory / "lts_test_indexed.lts").string();
+  const std::string streaming_file = (directory / "lts_test_streaming.lts").string();
+
+  lts::lts_lts_t l;
+  process::action_label a("a", data::sort_expression_list());
+  process::action_label b("b", data::sort_expression_list({data::sort_nat::nat()}));
+  l.set_action_label_declarations(process::action_label_list({a, b}));
+  l.set_process_parameters(data::variable_list({data::variable("n", data::sort_nat::nat())}));
+
+  const std::size_t number_of_actions = 10;
+  l.add_action(lts::action_label_lts(lps::multi_action(process::action(a, data::data_expression_list()))));
+  for (std::size_t i = 1; i < number_of_actions; ++i)
+  {
+    l.add_action(lts::action_label_lts(lps::multi_action(process::action(b, data::data_expression_list({data::sort_nat::nat(i)})))));
+  }
+
+  const std::size_t number_of_states = 50000;
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    l.add_state(lts::state_label_lts::number_to_label(i));
+    l.add_transition(lts::transition(i, i % number_of_actions, (i + 1) % number_of_states));
+    l.add_transition(lts::transition(i, (i + 3) % number_of_actions, (7 * i) % number_of_states));
+  }
+  l.set_initial_state(3);
+
+  for (std::size_t threads: {1, 4})
+  {
+    l.save_indexed(indexed_file, threads);
+    for (std::size_t read_threads: {1, 3})
+    {
+      lts::lts_lts_t l_indexed;
+      l_indexed.load(indexed_file, read_threads);
+      BOOST_CHECK(l_indexed == l);
+    }
+  }
+
+  // A truncated file, or a file of which the directory is corrupt, is rejected.
+  std::string contents;
+  {
+    std::ifstream file(indexed_file, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  auto load_modified = [&](const std::string& modified_contents)
+  {
+    {
+      std::ofstream file(indexed_file, std::ios::binary);
+      file << modified_contents;
+    }
+    lts::lts_lts_t l_modified;
+    l_modified.load(indexed_file, 3);
+  };
+  BOOST_CHECK_THROW(load_modified(contents.substr(0, contents.size() / 2)), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(load_modified(contents.substr(0, contents.size() - 1)), mcrl2::runtime_error);
+  std::string corrupt_directory = contents;
+  corrupt_directory[corrupt_directory.size() - 2] = '\x7f';
+  BOOST_CHECK_THROW(load_modified(corrupt_directory), mcrl2::runtime_error);
+
+  // A transition to a state that does not exist is rejected.
+  lts::lts_lts_t l_invalid;
+  l_invalid.set_num_states(2);
+  l_invalid.add_transition(lts::transition(0, 0, 5));
+  l_invalid.save_indexed(indexed_file, 1);
+  lts::lts_lts_t l_invalid_indexed;
+  BOOST_CHECK_THROW(l_invalid_indexed.load(indexed_file), mcrl2::runtime_error);
+
+  l.save(streaming_file);
+  lts::lts_lts_t l_streaming;
+  l_streaming.load(streaming_file, 3);
+  BOOST_CHECK_EQUAL(l_streaming.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(l_streaming.num_transitions(), l.num_transitions());
+  BOOST_CHECK(l_streaming.state_labels() == l.state_labels());
+
+  // An indexed probabilistic lts can only be read as a probabilistic lts.
+  lts::probabilistic_lts_lts_t pl;
+  pl.set_action_label_declarations(l.action_label_declarations());
+  pl.add_action(l.action_label(1));
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    pl.add_state(lts::state_label_lts::number_to_label(i));
+    pl.add_probabilistic_state(lts::probabilistic_lts_lts_t::probabilistic_state_t(i));
+  }
+  lts::probabilistic_lts_lts_t::probabilistic_state_t split;
+  split.add(1, lps::probabilistic_data_expression(1, 3));
+  split.add(2, lps::probabilistic_data_expression(2, 3));
+  pl.add_transition(lts::transition(0, 1, pl.add_probabilistic_state(split)));
+  pl.add_transition(lts::transition(1, 0, 2));
+  pl.set_initial_probabilistic_state(split);
+  pl.save_indexed(indexed_file, 2);
+
+  lts::probabilistic_lts_lts_t pl_indexed;
+  pl_indexed.load(indexed_file, 2);
+  BOOST_CHECK(pl_indexed == pl);
+
+  lts::lts_lts_t l_probabilistic;
+  BOOST_CHECK_THROW(l_probabilistic.load(indexed_file), mcrl2::runtime_error);
+
+  std::filesystem::remove(indexed_file);
+  std::filesystem::remove(streaming_file);
+}
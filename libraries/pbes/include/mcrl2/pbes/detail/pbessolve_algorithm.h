@@ -57,7 +57,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
     lps::specification evidence;
     timer.start("solving");
     std::tie(result, evidence) = solve_structure_graph_with_counter_example(
-        G, lpsspec, pbesspec, equation_index);
+        G, lpsspec, pbesspec, equation_index, options.number_of_threads);
     timer.finish("solving");
 
     std::cout << (result ? "true" : "false") << std::endl;
@@ -77,7 +77,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
 
     lts::lts_lts_t evidence;
     timer.start("solving");
-    result = solve_structure_graph_with_counter_example(G, ltsspec);
+    result = solve_structure_graph_with_counter_example(G, ltsspec, options.number_of_threads);
     timer.finish("solving");
     std::cout << (result ? "true" : "false") << std::endl;
     if (evidence_file.empty())
@@ -92,7 +92,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
   else
   {
     timer.start("solving");
-    result = solve_structure_graph(G, options.check_strategy);
+    result = solve_structure_graph(G, options.check_strategy, options.number_of_threads);
     timer.finish("solving");
     std::cout << (result ? "true" : "false") << std::endl;
   }
@@ -393,7 +393,7 @@ class pbessolve_tool
 
       // Solve the initial pbes and obtain the strategies in G.
       timer().start("first-solving");
-      auto [result, mapping] = solve_structure_graph_winning_mapping(initial_G, true);
+      auto [result, mapping] = solve_structure_graph_winning_mapping(initial_G, true, options.number_of_threads);
       timer().finish("first-solving");
       mCRL2log(log::log_level_t::verbose) << (result ? "true" : "false") << std::endl;
 
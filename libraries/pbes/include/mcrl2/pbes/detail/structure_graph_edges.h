@@ -0,0 +1,319 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/detail/structure_graph_edges.h
+/// \brief Storage for the edges of a structure graph in one direction.
+
+#ifndef MCRL2_PBES_DETAIL_STRUCTURE_GRAPH_EDGES_H
+#define MCRL2_PBES_DETAIL_STRUCTURE_GRAPH_EDGES_H
+
+#include <cassert>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <boost/range/iterator_range.hpp>
+#include "mcrl2/utilities/exception.h"
+
+namespace mcrl2::pbes_system::detail {
+
+/// \brief Stores for every vertex a list of adjacent vertices (either its successors or its predecessors).
+/// \details While a structure graph is being built, the lists are linked lists of which the nodes are stored in
+///          a chunked array, so that no memory is allocated per vertex. After freeze() the lists are stored in
+///          compressed sparse row format, i.e. in a single array of 32-bit vertex indices and an array of offsets.
+///          Inserting or removing an edge in a frozen list converts it back to linked lists. The nodes of removed
+///          edges are reused by later insertions.
+class structure_graph_edges
+{
+  public:
+    using index_type = unsigned int;
+
+  protected:
+    static constexpr index_type undefined = std::numeric_limits<index_type>::max();
+
+    struct node
+    {
+      index_type target;
+      index_type next;
+    };
+
+    bool m_frozen = false;
+
+    // The linked lists, with the first and the last node of the list of every vertex.
+    std::vector<index_type> m_first;
+    std::vector<index_type> m_last;
+    std::deque<node> m_nodes;
+
+    // The nodes of removed edges, linked through their next field.
+    index_type m_free = undefined;
+
+    // The number of edges, i.e., the nodes in use.
+    std::size_t m_number_of_edges = 0;
+
+    // The compressed sparse row format. The vertices adjacent to u are m_targets[m_offsets[u] .. m_offsets[u + 1]).
+    std::vector<std::size_t> m_offsets;
+    std::vector<index_type> m_targets;
+
+    void resize(std::size_t n)
+    {
+      if (m_first.size() < n)
+      {
+        m_first.resize(n, undefined);
+        m_last.resize(n, undefined);
+      }
+    }
+
+  public:
+    class const_iterator
+    {
+      protected:
+        const structure_graph_edges* m_edges = nullptr;
+        std::size_t m_position = 0;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = index_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const index_type*;
+        using reference = const index_type&;
+
+        const_iterator() = default;
+
+        const_iterator(const structure_graph_edges* edges, std::size_t position)
+          : m_edges(edges), m_position(position)
+        {}
+
+        reference operator*() const
+        {
+          return m_edges->m_frozen ? m_edges->m_targets[m_position] : m_edges->m_nodes[m_position].target;
+        }
+
+        const_iterator& operator++()
+        {
+          if (m_edges->m_frozen)
+          {
+            ++m_position;
+          }
+          else
+          {
+            index_type next = m_edges->m_nodes[m_position].next;
+            m_position = next == undefined ? std::numeric_limits<std::size_t>::max() : next;
+          }
+          return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+          const_iterator result = *this;
+          ++(*this);
+          return result;
+        }
+
+        bool operator==(const const_iterator& other) const
+        {
+          return m_position == other.m_position;
+        }
+
+        bool operator!=(const const_iterator& other) const
+        {
+          return m_position != other.m_position;
+        }
+    };
+
+    using edge_range = boost::iterator_range<const_iterator>;
+
+    /// \brief Returns the vertices adjacent to u.
+    edge_range edges(index_type u) const
+    {
+      if (m_frozen)
+      {
+        if (u + 1 >= m_offsets.size())
+        {
+          return edge_range(const_iterator(this, 0), const_iterator(this, 0));
+        }
+        return edge_range(const_iterator(this, m_offsets[u]), const_iterator(this, m_offsets[u + 1]));
+      }
+      const_iterator end(this, std::numeric_limits<std::size_t>::max());
+      if (u >= m_first.size() || m_first[u] == undefined)
+      {
+        return edge_range(end, end);
+      }
+      return edge_range(const_iterator(this, m_first[u]), end);
+    }
+
+    bool contains(index_type u, index_type v) const
+    {
+      for (index_type w: edges(u))
+      {
+        if (w == v)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// \brief Appends v to the list of u. Does not check whether v is already present.
+    void insert(index_type u, index_type v)
+    {
+      thaw();
+      resize(u + 1);
+      index_type n = m_free;
+      if (n != undefined)
+      {
+        m_free = m_nodes[n].next;
+        m_nodes[n] = node{v, undefined};
+      }
+      else
+      {
+        if (m_nodes.size() >= undefined)
+        {
+          throw mcrl2::runtime_error("The number of edges of the structure graph exceeds the maximum of " + std::to_string(undefined) + ".");
+        }
+        n = static_cast<index_type>(m_nodes.size());
+        m_nodes.push_back(node{v, undefined});
+      }
+      m_number_of_edges++;
+      if (m_first[u] == undefined)
+      {
+        m_first[u] = n;
+      }
+      else
+      {
+        m_nodes[m_last[u]].next = n;
+      }
+      m_last[u] = n;
+    }
+
+    /// \brief Removes all occurrences of v from the list of u. The nodes are reused by later insertions.
+    void remove(index_type u, index_type v)
+    {
+      thaw();
+      if (u >= m_first.size())
+      {
+        return;
+      }
+      index_type previous = undefined;
+      index_type next;
+      for (index_type n = m_first[u]; n != undefined; n = next)
+      {
+        next = m_nodes[n].next;
+        if (m_nodes[n].target == v)
+        {
+          (previous == undefined ? m_first[u] : m_nodes[previous].next) = next;
+          if (m_last[u] == n)
+          {
+            m_last[u] = previous;
+          }
+          m_nodes[n].next = m_free;
+          m_free = n;
+          m_number_of_edges--;
+        }
+        else
+        {
+          previous = n;
+        }
+      }
+    }
+
+    /// \brief Converts the lists to compressed sparse row format and releases the linked lists.
+    void freeze()
+    {
+      if (m_frozen)
+      {
+        return;
+      }
+      std::size_t n = m_first.size();
+      m_offsets.assign(n + 1, 0);
+      std::vector<index_type>(m_number_of_edges).swap(m_targets);
+      std::size_t i = 0;
+      for (std::size_t u = 0; u < n; u++)
+      {
+        for (index_type w = m_first[u]; w != undefined; w = m_nodes[w].next)
+        {
+          m_targets[i++] = m_nodes[w].target;
+        }
+        m_offsets[u + 1] = i;
+      }
+      assert(i == m_number_of_edges);
+      std::vector<index_type>().swap(m_first);
+      std::vector<index_type>().swap(m_last);
+      std::deque<node>().swap(m_nodes);
+      m_free = undefined;
+      m_frozen = true;
+    }
+
+    /// \brief Converts the compressed sparse row format back to linked lists.
+    void thaw()
+    {
+      if (!m_frozen)
+      {
+        return;
+      }
+      std::vector<std::size_t> offsets;
+      std::vector<index_type> targets;
+      std::swap(offsets, m_offsets);
+      std::swap(targets, m_targets);
+      m_frozen = false;
+      m_number_of_edges = 0;
+      for (std::size_t u = 0; u + 1 < offsets.size(); u++)
+      {
+        resize(u + 1);
+        for (std::size_t i = offsets[u]; i < offsets[u + 1]; i++)
+        {
+          insert(u, targets[i]);
+        }
+      }
+    }
+
+    bool is_frozen() const
+    {
+      return m_frozen;
+    }
+
+    /// \brief Returns the number of edges.
+    std::size_t number_of_edges() const
+    {
+      return m_frozen ? m_targets.size() : m_number_of_edges;
+    }
+
+    /// \brief Renumbers the vertices, and removes the vertices u with index[u] == undefined, including the edges to them.
+    void renumber(const std::vector<index_type>& index)
+    {
+      bool frozen = m_frozen;
+      structure_graph_edges result;
+      for (std::size_t u = 0; u < index.size(); u++)
+      {
+        if (index[u] == undefined)
+        {
+          continue;
+        }
+        for (index_type v: edges(u))
+        {
+          if (index[v] != undefined)
+          {
+            result.insert(index[u], index[v]);
+          }
+        }
+      }
+      std::swap(*this, result);
+      if (frozen)
+      {
+        freeze();
+      }
+    }
+
+    void clear()
+    {
+      *this = structure_graph_edges();
+    }
+};
+
+} // namespace mcrl2::pbes_system::detail
+
+#endif // MCRL2_PBES_DETAIL_STRUCTURE_GRAPH_EDGES_H
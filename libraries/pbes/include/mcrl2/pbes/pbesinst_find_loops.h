@@ -52,7 +52,7 @@ bool find_loop(const simple_structure_graph& G,
     visited[w] = false;
     if (w_.decoration == structure_graph::d_none || w_.decoration == p % 2)
     {
-      for (structure_graph::index_type u: w_.successors)
+      for (structure_graph::index_type u: G.successors(w))
       {
         if (u == v || find_loop(G, U, v, u, p, visited))
         {
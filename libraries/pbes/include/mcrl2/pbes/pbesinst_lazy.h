@@ -12,6 +12,7 @@
 #ifndef MCRL2_PBES_PBESINST_LAZY_H
 #define MCRL2_PBES_PBESINST_LAZY_H
 
+#include <condition_variable>
 #include <optional>
 #include <string>
 #include <thread>
@@ -96,10 +97,10 @@ class pbesinst_lazy_todo
       todo.push_back(x);
     }
 
-    template <typename FwdIter, bool ThreadSafe>
+    template <typename FwdIter, typename IndexedSet>
     void insert(FwdIter first,
                 FwdIter last,
-                const atermpp::indexed_set<propositional_variable_instantiation, ThreadSafe>& discovered,
+                const IndexedSet& discovered,
                 const std::size_t thread_index)
     {
       using utilities::detail::contains;
@@ -147,7 +148,7 @@ class pbesinst_lazy_algorithm
     pbesinst_lazy_todo todo;
 
     /// \brief The propositional variable instantiations that have been discovered (not necessarily handled).
-    atermpp::indexed_set<propositional_variable_instantiation, true> discovered;
+    atermpp::concurrent_indexed_set<propositional_variable_instantiation> discovered;
 
     /// \brief The initial value (after rewriting).
     propositional_variable_instantiation init;
@@ -162,6 +163,12 @@ class pbesinst_lazy_algorithm
     // Mutexes
     utilities::mutex m_todo_access;
 
+    /// \brief Signals that elements were added to the todo buffer, or that all threads are finished.
+    std::condition_variable_any m_todo_filled;
+
+    /// \brief Set when no thread can find new work anymore, or when a solution was found. Protected by m_todo_access.
+    bool m_all_threads_finished = false;
+
     // Prune round counter
     std::size_t global_current_prune_round = 0;
 
@@ -342,10 +349,10 @@ class pbesinst_lazy_algorithm
       pbes_expression psi_e;
       pbes_expression tmp; // temporary storate for rewritten psi_e.
 
-      while (number_of_active_processes > 0)
+      m_todo_access.lock();
+      while (!m_must_abort)
       {
-        m_todo_access.lock();
-        while (!todo.elements().empty() && !m_must_abort)
+        while (!todo.elements().empty() && !m_all_threads_finished && !m_must_abort)
         {
           ++m_iteration_count;
           std::size_t local_current_prune_round = global_current_prune_round;
@@ -395,25 +402,39 @@ class pbesinst_lazy_algorithm
             }
             on_discovered_elements(occ);
 
+            // Wake up the threads that are waiting for work.
+            if (!todo.elements().empty() && number_of_active_processes < m_options.number_of_threads)
+            {
+              m_todo_filled.notify_all();
+            }
+
             if (solution_found(init))
             {
+              m_all_threads_finished = true;
+              m_todo_filled.notify_all();
               break;
             }
           }
         }
-        m_todo_access.unlock();
-
-        // Check whether all processes are ready. If so the
-        // number_of_active_processes becomes 0. Otherwise, this thread becomes
-        // active again, and tries to see whether the todo buffer is not empty,
-        // to take up more work.
-        number_of_active_processes--;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        if (number_of_active_processes > 0)
+
+        if (m_all_threads_finished)
+        {
+          break;
+        }
+
+        // The todo buffer is empty. If all other threads are waiting as well, no new work can appear
+        // and the exploration is finished. Otherwise, this thread waits until another thread has added
+        // elements to the todo buffer. The counter is only changed while holding m_todo_access.
+        if (--number_of_active_processes == 0)
         {
-          number_of_active_processes++;
+          m_all_threads_finished = true;
+          m_todo_filled.notify_all();
+          break;
         }
+        m_todo_filled.wait(m_todo_access, [&]() { return !todo.elements().empty() || m_all_threads_finished || m_must_abort; });
+        ++number_of_active_processes;
       }
+      m_todo_access.unlock();
 
       if (m_options.number_of_threads > 1)
       {
@@ -425,6 +446,7 @@ class pbesinst_lazy_algorithm
     virtual void run()
     {
       m_iteration_count = 0;
+      m_all_threads_finished = false;
 
       const std::size_t number_of_threads = m_options.number_of_threads;
       const std::size_t initialisation_thread_index = (number_of_threads==1?0:1);
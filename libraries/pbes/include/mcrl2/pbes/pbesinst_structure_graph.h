@@ -141,6 +141,7 @@ class pbesinst_structure_graph_algorithm: public pbesinst_lazy_algorithm
     {
       pbesinst_lazy_algorithm::run();
       m_graph_builder.finalize();
+      m_graph_builder.freeze();
     }
 };
 
@@ -397,8 +397,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       for (const propositional_variable_instantiation& X: todo.elements())
       {
         const structure_graph::index_type u = m_graph_builder.find_vertex(X);
-        const structure_graph::vertex& u_ = m_graph_builder.vertex(u);
-        if (u_.is_defined())
+        if (m_graph_builder.m_graph.is_defined(u))
         {
           return false;
         }
@@ -416,7 +415,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
 
       std::size_t old_todo_size = todo.elements().size();
 
-      simple_structure_graph G(m_graph_builder.vertices());
+      simple_structure_graph G(m_graph_builder.m_graph);
 
       atermpp::deque<pbes_expression> todo1{init};
       atermpp::indexed_set<pbes_expression> done1;
@@ -433,7 +432,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
         const structure_graph::index_type u = m_graph_builder.find_vertex(X);
         const structure_graph::vertex& u_ = m_graph_builder.vertex(u);
         calculation_steps++;
-        if (u_.decoration == structure_graph::d_none && u_.successors.empty())
+        if (u_.decoration == structure_graph::d_none && G.successors(u).empty())
         {
           assert(is_propositional_variable_instantiation(u_.formula()));
           new_todo.insert(atermpp::down_cast<propositional_variable_instantiation>(u_.formula()));
@@ -531,7 +530,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
 
     bool strategies_are_set_in_solved_nodes() const
     {
-      simple_structure_graph G(m_graph_builder.vertices());
+      simple_structure_graph G(m_graph_builder.m_graph);
       for (structure_graph::index_type u: S[0].vertices())
       {
         if (G.decoration(u) == structure_graph::d_disjunction && tau[0][u] == undefined_vertex())
@@ -632,12 +631,12 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
       {
         if (S_guard[0](S[0].size()))
         {
-          simple_structure_graph G(m_graph_builder.vertices());
+          simple_structure_graph G(m_graph_builder.m_graph);
           S[0] = attr_default_with_tau(G, S[0], 0, tau);
         }
         if (S_guard[1](S[1].size()))
         {
-          simple_structure_graph G(m_graph_builder.vertices());
+          simple_structure_graph G(m_graph_builder.m_graph);
           S[1] = attr_default_with_tau(G, S[1], 1, tau);
         }
         assert(strategies_are_set_in_solved_nodes());
@@ -648,7 +647,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
         mCRL2log(log::verbose) << "Start partial solving.\n"; 
 
         std::size_t calculation_steps=0;  // Count how many calculation steps it takes to find loops, and retry this after on_discovered_elements have been called that many times. 
-        simple_structure_graph G(m_graph_builder.vertices());
+        simple_structure_graph G(m_graph_builder.m_graph);
         detail::find_loops2(G, S, tau, calculation_steps, m_iteration_count); // modifies S[0] and S[1]
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
         assert(strategies_are_set_in_solved_nodes());
@@ -663,7 +662,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
 
         std::size_t calculation_steps=0;  // Count how many calculation steps it takes to find loops, and retry this after on_discovered_elements have been called that many times. 
 
-        simple_structure_graph G(m_graph_builder.vertices());
+        simple_structure_graph G(m_graph_builder.m_graph);
         if (m_options.optimization == partial_solve_strategy::solve_subgames_using_fatal_attractor_local)
         {
           detail::fatal_attractors(G, S, tau, calculation_steps, m_iteration_count); // modifies S[0] and S[1]
@@ -691,7 +690,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
 
         std::size_t calculation_steps=0;  // Count how many calculation steps it takes to find loops, and retry this after on_discovered_elements have been called that many times. 
 
-        simple_structure_graph G(m_graph_builder.vertices());
+        simple_structure_graph G(m_graph_builder.m_graph);
         detail::find_loops(G, discovered, todo, S, tau, m_iteration_count, m_graph_builder); // modifies S[0] and S[1]
         on_the_fly_solve_trigger.set_expiration_steps(m_options.prune_and_solve_frequently?calculation_steps/1000:calculation_steps/10);
         assert(strategies_are_set_in_solved_nodes());
@@ -706,7 +705,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
     {
       using  utilities::detail::contains;
 
-      simple_structure_graph G(m_graph_builder.vertices());
+      simple_structure_graph G(m_graph_builder.m_graph);
 
       const structure_graph::index_type u = m_graph_builder.find_vertex(init);
       assert(strategies_are_set_in_solved_nodes());
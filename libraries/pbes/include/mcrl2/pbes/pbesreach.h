@@ -228,6 +228,9 @@ class pbesreach_algorithm
     template <typename Context, bool ActionLabel>
     friend void symbolic::learn_successors_callback(WorkerP*, Task*, std::uint32_t* v, std::size_t n, void* context);
 
+    template <typename Context, bool ActionLabel>
+    friend void symbolic::learn_successors_parallel(Context& context, const sylvan::ldds::ldd& X, symbolic::learn_successors_workers& workers);
+
   protected:
     using ldd = sylvan::ldds::ldd;
     const symbolic_reachability_options& m_options;
@@ -251,6 +254,9 @@ class pbesreach_algorithm
     ldd m_deadlocks;
     ldd m_initial_vertex;
 
+    /// \brief The threads that learn transitions in parallel, which are created by the first call of learn_successors.
+    std::unique_ptr<symbolic::learn_successors_workers> m_learn_workers;
+
     /// \brief Updates R.L := R.L U {(x,y) in R | x in X}
     void learn_successors(std::size_t i, pbes_summand_group& R, const ldd& X)
     {
@@ -258,7 +264,18 @@ class pbesreach_algorithm
 
       using namespace sylvan::ldds;
       std::pair<pbesreach_algorithm&, pbes_summand_group&> context{*this, R};
-      sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<pbesreach_algorithm&, pbes_summand_group&>, false>, &context);
+      if (m_options.max_workers > 1)
+      {
+        if (!m_learn_workers)
+        {
+          m_learn_workers = std::make_unique<symbolic::learn_successors_workers>(m_options.max_workers, m_rewr, m_sigma, m_pbes.data());
+        }
+        symbolic::learn_successors_parallel<std::pair<pbesreach_algorithm&, pbes_summand_group&>, false>(context, X, *m_learn_workers);
+      }
+      else
+      {
+        sat_all_nopar(X, symbolic::learn_successors_callback<std::pair<pbesreach_algorithm&, pbes_summand_group&>, false>, &context);
+      }
     }
 
     /// Applies further preprocessing steps to the SRF pbes.
@@ -28,11 +28,13 @@ class simple_structure_graph
     using vertex = structure_graph::vertex;
 
   protected:
+    const structure_graph& m_graph;
     const structure_graph::vertex_vector& m_vertices;
 
   public:
-    explicit simple_structure_graph(const structure_graph::vertex_vector& vertices)
-      : m_vertices(vertices)
+    explicit simple_structure_graph(const structure_graph& G)
+      : m_graph(G),
+        m_vertices(G.all_vertices())
     {}
 
     decoration_type decoration(index_type u) const
@@ -60,14 +62,14 @@ class simple_structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& predecessors(index_type u) const
+    structure_graph::edge_range predecessors(index_type u) const
     {
-      return find_vertex(u).predecessors;
+      return m_graph.all_predecessors(u);
     }
 
-    const std::vector<index_type>& successors(index_type u) const
+    structure_graph::edge_range successors(index_type u) const
     {
-      return find_vertex(u).successors;
+      return m_graph.all_successors(u);
     }
 
     index_type strategy(index_type u) const
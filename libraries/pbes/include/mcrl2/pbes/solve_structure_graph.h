@@ -17,6 +17,7 @@
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/pbes/pbes_equation_index.h"
 #include "mcrl2/pbes/pbessolve_attractors.h"
+#include "mcrl2/pbes/solve_structure_graph_flat.h"
 #include "mcrl2/pbes/detail/pbes_remove_counterexample_info.h"
 
 namespace mcrl2::pbes_system {
@@ -61,6 +62,9 @@ class solve_structure_graph_algorithm
 
     bool use_toms_optimization = false;
 
+    // the number of threads used by the attractor computations of solve_flat
+    std::size_t number_of_threads = 1;
+
     // find a successor of u
     static structure_graph::index_type succ(const structure_graph& G, structure_graph::index_type u)
     {
@@ -234,16 +238,12 @@ class solve_structure_graph_algorithm
       }
     }
 
-    static void insert_edge(structure_graph::vertex_vector& V, structure_graph::index_type ui, structure_graph::index_type vi)
+    // Computes the same solution as solve_recursive_extended, but on a flat snapshot of G. This avoids the
+    // allocation of vertex sets in every recursive call. The recursive version is kept as an independent check.
+    std::pair<vertex_set, vertex_set> solve_flat(const structure_graph& G) const
     {
-      using utilities::detail::contains;
-      structure_graph::vertex& u = V[ui];
-      structure_graph::vertex& v = V[vi];
-      if (!contains(u.successors, vi))
-      {
-        u.successors.push_back(vi);
-        v.predecessors.push_back(ui);
-      }
+      mCRL2log(log::debug) << "\n  --- solve_flat input ---\n" << G << std::endl;
+      return flat_zielonka_solver(G, use_toms_optimization, number_of_threads).run();
     }
 
     void check_solve_recursive_solution(const structure_graph& G, bool is_disjunctive, const vertex_set& Wdisj, const vertex_set& Wconj)
@@ -254,16 +254,10 @@ class solve_structure_graph_algorithm
       log_vertex_set(G, Wconj, "Wconj");
       log_vertex_set(G, Wdisj, "Wdisj");
 
-      using vertex = structure_graph::vertex;
       structure_graph::index_type init = G.initial_vertex();
 
-      // V contains the vertices of G, but not the edges
-      structure_graph::vertex_vector V = G.all_vertices();
-      for (vertex& v: V)
-      {
-        v.successors.clear();
-        v.predecessors.clear();
-      }
+      // Gcopy contains the vertices of G, but not the edges
+      structure_graph Gcopy(G.all_vertices(), G.initial_vertex(), G.exclude());
 
       std::set<structure_graph::index_type> todo = { init };
       std::set<structure_graph::index_type> done;
@@ -277,10 +271,13 @@ class solve_structure_graph_algorithm
         {
           // explore only the strategy edge
           structure_graph::index_type v = G.strategy(u);
-          insert_edge(V, u, v);
-          if (v != undefined_vertex() && !contains(done, v))
+          if (v != undefined_vertex())
           {
-            todo.insert(v);
+            Gcopy.insert_edge(u, v);
+            if (!contains(done, v))
+            {
+              todo.insert(v);
+            }
           }
         }
         else
@@ -288,7 +285,7 @@ class solve_structure_graph_algorithm
           // explore all outgoing edges
           for (structure_graph::index_type v: G.successors(u))
           {
-            insert_edge(V, u, v);
+            Gcopy.insert_edge(u, v);
             if (!contains(done, v))
             {
               todo.insert(v);
@@ -300,7 +297,7 @@ class solve_structure_graph_algorithm
       vertex_set Wconj1;
       vertex_set Wdisj1;
 
-      structure_graph Gcopy(V, G.initial_vertex(), G.exclude());
+      Gcopy.freeze();
       std::tie(Wdisj1, Wconj1) = solve_recursive_extended(Gcopy);
       bool is_disjunctive1;
       if (Wdisj1.contains(G.initial_vertex()))
@@ -324,9 +321,10 @@ class solve_structure_graph_algorithm
     }
 
   public:
-    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false)
+    explicit solve_structure_graph_algorithm(bool check_strategy_ = false, bool use_toms_optimization_ = false, std::size_t number_of_threads_ = 1)
       : check_strategy(check_strategy_),
-        use_toms_optimization(use_toms_optimization_)
+        use_toms_optimization(use_toms_optimization_),
+        number_of_threads(number_of_threads_)
     {}
 
     /// Returns the winning player (alpha)
@@ -356,7 +354,7 @@ class solve_structure_graph_algorithm
       mCRL2log(log::debug) << G << std::endl;
       assert(G.extent() > 0);
       assert(G.is_defined());
-      auto W = solve_recursive_extended(G);
+      auto W = solve_flat(G);
       bool is_disjunctive;
       if (W.first.contains(G.initial_vertex()))
       {
@@ -471,7 +469,9 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lps_solve_structure_graph_algorithm() = default;
+    explicit lps_solve_structure_graph_algorithm(std::size_t number_of_threads_ = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads_)
+    {}
 
     /// \brief Solve a pbes for some equation, while constructing a counter example or wittness based on the accompanying linear process.
     /// \param G       A structure graph.
@@ -493,7 +493,7 @@ class lps_solve_structure_graph_algorithm: public solve_structure_graph_algorith
       mCRL2log(log::verbose) << "Solving parity game..." << std::endl;
       vertex_set Wconj;
       vertex_set Wdisj;
-      std::tie(Wdisj, Wconj) = solve_recursive_extended(G);
+      std::tie(Wdisj, Wconj) = solve_flat(G);
       structure_graph::index_type init = G.initial_vertex();
 
       mCRL2log(log::verbose) << "Extracting evidence..." << std::endl;
@@ -560,7 +560,9 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
     }
 
   public:
-    lts_solve_structure_graph_algorithm() = default;
+    explicit lts_solve_structure_graph_algorithm(std::size_t number_of_threads_ = 1)
+      : solve_structure_graph_algorithm(false, false, number_of_threads_)
+    {}
 
     /// \brief Solve a boolean equation system while generating a counter example.
     /// \param G       A structure graph.
@@ -571,7 +573,7 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
       mCRL2log(log::verbose) << "Solving parity game..." << std::endl;
       vertex_set Wconj;
       vertex_set Wdisj;
-      std::tie(Wdisj, Wconj) = solve_recursive_extended(G);
+      std::tie(Wdisj, Wconj) = solve_flat(G);
       structure_graph::index_type init = G.initial_vertex();
 
       mCRL2log(log::verbose) << "Extracting evidence..." << std::endl;
@@ -582,19 +584,19 @@ class lts_solve_structure_graph_algorithm: public solve_structure_graph_algorith
 };
 
 inline
-bool solve_structure_graph(structure_graph& G, bool check_strategy = false)
+bool solve_structure_graph(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads);
   return algorithm.solve(G);
 }
 
 /// Returns a mapping from PBES variable instantations to vertices in the structure graph for vertices won by player alpha.
 inline
-std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>> solve_structure_graph_winning_mapping(structure_graph& G, bool check_strategy = false)
+std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>> solve_structure_graph_winning_mapping(structure_graph& G, bool check_strategy = false, std::size_t number_of_threads = 1)
 {
   bool use_toms_optimization = !check_strategy;
-  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization);
+  solve_structure_graph_algorithm algorithm(check_strategy, use_toms_optimization, number_of_threads);
   auto W = algorithm.solve_partitions(G);
 
   bool is_disjunctive;
@@ -621,19 +623,20 @@ std::pair<bool, std::unordered_map<pbes_expression, structure_graph::index_type>
 }
 
 inline
-std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index)
+std::pair<bool, lps::specification> solve_structure_graph_with_counter_example(structure_graph& G, const lps::specification& lpsspec, const pbes& p, const pbes_equation_index& p_index, std::size_t number_of_threads = 1)
 {
-  lps_solve_structure_graph_algorithm algorithm;
+  lps_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, lpsspec, p, p_index);
 }
 
 /// \brief Solve this pbes_system using a structure graph generating a counter example.
 /// \param G       The structure graph.
 /// \param ltsspec The original LTS that was used to create the PBES.
+/// \param number_of_threads The number of threads used to compute attractors.
 inline
-bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec)
+bool solve_structure_graph_with_counter_example(structure_graph& G, lts::lts_lts_t& ltsspec, std::size_t number_of_threads = 1)
 {
-  lts_solve_structure_graph_algorithm algorithm;
+  lts_solve_structure_graph_algorithm algorithm(number_of_threads);
   return algorithm.solve_with_counter_example(G, ltsspec);
 }
 
@@ -0,0 +1,464 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/solve_structure_graph_flat.h
+/// \brief Zielonka's recursive algorithm on a flat snapshot of a structure graph.
+
+#ifndef MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_FLAT_H
+#define MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_FLAT_H
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include "mcrl2/pbes/pbessolve_vertex_set.h"
+#include "mcrl2/utilities/parallel_breadth_first_search.h"
+
+namespace mcrl2::pbes_system {
+
+/// \brief A read-only view of a structure graph, with the decorations and ranks stored in flat arrays.
+/// \details The successors and predecessors are those of the structure graph, which are stored in compressed
+///          sparse row format once the graph is frozen. Excluded vertices are not filtered from them.
+class flat_structure_graph
+{
+  public:
+    using index_type = structure_graph::index_type;
+    using edge_range = structure_graph::edge_range;
+
+  protected:
+    const structure_graph& m_graph;
+    std::vector<std::uint8_t> m_decoration;
+    std::vector<std::size_t> m_rank;
+
+  public:
+    explicit flat_structure_graph(const structure_graph& G)
+      : m_graph(G)
+    {
+      std::size_t N = G.extent();
+      m_decoration.reserve(N);
+      m_rank.reserve(N);
+      for (index_type u = 0; u < N; u++)
+      {
+        const structure_graph::vertex& v = G.find_vertex(u);
+        m_decoration.push_back(static_cast<std::uint8_t>(v.decoration));
+        m_rank.push_back(v.rank);
+      }
+    }
+
+    std::size_t extent() const
+    {
+      return m_decoration.size();
+    }
+
+    bool contains(index_type u) const
+    {
+      return m_graph.contains(u);
+    }
+
+    std::size_t decoration(index_type u) const
+    {
+      return m_decoration[u];
+    }
+
+    std::size_t rank(index_type u) const
+    {
+      return m_rank[u];
+    }
+
+    edge_range successors(index_type u) const
+    {
+      return m_graph.all_successors(u);
+    }
+
+    edge_range predecessors(index_type u) const
+    {
+      return m_graph.all_predecessors(u);
+    }
+};
+
+/// \brief Zielonka's recursive algorithm on a flat_structure_graph.
+/// \details Computes the same solution and strategy as solve_structure_graph_algorithm::solve_recursive_extended,
+///          but without allocating vertex sets of size N in every recursive call. Instead, the subgame at recursion
+///          depth d consists of the vertices u with level[u] == d. The vertex lists of the subgames are pooled per
+///          depth, and the attractor keeps for every vertex a counter of its successors that remain outside of the
+///          attractor. The work done in a recursive call is therefore proportional to the size of the subgame.
+///          With multiple threads, the large layers of the breadth first searches of the attractors are processed
+///          in parallel.
+class flat_zielonka_solver
+{
+  public:
+    using index_type = structure_graph::index_type;
+
+  protected:
+    const structure_graph& m_graph;
+    flat_structure_graph m_flat;
+    bool m_use_toms_optimization;
+
+    // The depth of the subgame that contains a vertex, or 0 if the vertex has been removed.
+    std::vector<std::uint32_t> m_level;
+
+    // The winner (0 = disjunctive, 1 = conjunctive) of a vertex.
+    std::vector<std::uint8_t> m_winner;
+
+    // A vertex u is in the attractor that is being computed iff m_attractor_stamp[u] == m_stamp. The upper half of
+    // m_count[u] is a stamp as well. If it is equal to m_stamp, then the lower half is the number of successors of u
+    // outside the attractor. Counters are initialised on first use.
+    std::vector<std::uint32_t> m_attractor_stamp;
+    std::vector<std::uint64_t> m_count;
+    std::uint32_t m_stamp = 0;
+
+    // The threads used for the attractor computations, which are reused for every attractor.
+    utilities::detail::parallel_for_pool m_pool;
+
+    // The vertices of the subgame and the attractor at each depth. A deque is used, such that references to the
+    // vectors of lower depths remain valid when a deeper recursive call extends it.
+    std::deque<std::vector<index_type>> m_vertices;
+    std::deque<std::vector<index_type>> m_attractor;
+
+    void set_strategy(index_type u, index_type v)
+    {
+      mCRL2log(log::debug) << "  set tau[" << u << "] = " << v << std::endl;
+      m_graph.find_vertex(u).strategy = v;
+    }
+
+    void next_stamp()
+    {
+      if (++m_stamp == 0)
+      {
+        std::fill(m_attractor_stamp.begin(), m_attractor_stamp.end(), 0);
+        std::fill(m_count.begin(), m_count.end(), 0);
+        m_stamp = 1;
+      }
+    }
+
+    bool in_attractor(index_type u) const
+    {
+      return m_attractor_stamp[u] == m_stamp;
+    }
+
+    // Adds u to the attractor A that is being computed.
+    void attractor_insert(std::vector<index_type>& A, index_type u)
+    {
+      m_attractor_stamp[u] = m_stamp;
+      A.push_back(u);
+    }
+
+    std::vector<index_type>& pool(std::deque<std::vector<index_type>>& vectors, std::uint32_t depth)
+    {
+      if (vectors.size() <= depth)
+      {
+        vectors.resize(depth + 1);
+      }
+      return vectors[depth];
+    }
+
+    std::uint64_t count_stamp() const
+    {
+      return static_cast<std::uint64_t>(m_stamp) << 32;
+    }
+
+    // Returns the number of successors of u in the subgame at the given depth.
+    std::uint64_t out_degree(index_type u, std::uint32_t depth) const
+    {
+      std::uint64_t result = 0;
+      for (index_type w: m_flat.successors(u))
+      {
+        if (m_level[w] == depth)
+        {
+          result++;
+        }
+      }
+      return result;
+    }
+
+    // Extends the vertices in A, that have been inserted using attractor_insert, to the alpha-attractor of A in the
+    // subgame at the given depth. Like attr_default, the vertices are visited in breadth first order.
+    void attractor(std::vector<index_type>& A, std::uint32_t depth, std::size_t alpha)
+    {
+      if (m_pool.number_of_threads() > 1)
+      {
+        parallel_attractor(A, depth, alpha);
+        return;
+      }
+
+      for (std::size_t i = 0; i < A.size(); i++)
+      {
+        index_type v = A[i];
+        for (index_type u: m_flat.predecessors(v))
+        {
+          if (m_level[u] != depth || in_attractor(u))
+          {
+            continue;
+          }
+          if (m_flat.decoration(u) != alpha)
+          {
+            if ((m_count[u] & ~0xffffffffULL) != count_stamp())
+            {
+              m_count[u] = count_stamp() | out_degree(u, depth);
+            }
+            if ((--m_count[u] & 0xffffffffULL) != 0)
+            {
+              continue;
+            }
+          }
+          set_strategy(u, v);
+          attractor_insert(A, u);
+        }
+      }
+    }
+
+    // Variant of attractor that processes the layers of the breadth first search with multiple threads. A vertex
+    // is added by the thread that sets its stamp (alpha vertices) or that decrements its counter to zero (other
+    // vertices). Which successor becomes the strategy of an alpha vertex depends on the scheduling of the threads.
+    void parallel_attractor(std::vector<index_type>& A, std::uint32_t depth, std::size_t alpha)
+    {
+      auto expand = [&](index_type v, std::vector<index_type>& next)
+      {
+        for (index_type u: m_flat.predecessors(v))
+        {
+          if (m_level[u] != depth)
+          {
+            continue;
+          }
+          std::atomic_ref<std::uint32_t> stamp(m_attractor_stamp[u]);
+          if (stamp.load(std::memory_order_relaxed) == m_stamp)
+          {
+            continue;
+          }
+          if (m_flat.decoration(u) == alpha)
+          {
+            if (stamp.exchange(m_stamp, std::memory_order_relaxed) == m_stamp)
+            {
+              continue;
+            }
+          }
+          else
+          {
+            std::atomic_ref<std::uint64_t> count(m_count[u]);
+            std::uint64_t c = count.load(std::memory_order_relaxed);
+            std::uint64_t d;
+            do
+            {
+              d = (c & ~0xffffffffULL) == count_stamp() ? c - 1 : (count_stamp() | out_degree(u, depth)) - 1;
+            }
+            while (!count.compare_exchange_weak(c, d, std::memory_order_relaxed));
+            if ((d & 0xffffffffULL) != 0)
+            {
+              continue;
+            }
+            stamp.store(m_stamp, std::memory_order_relaxed);
+          }
+          m_graph.find_vertex(u).strategy = v;
+          next.push_back(u);
+        }
+      };
+
+      utilities::parallel_breadth_first_search(A, m_pool, expand);
+    }
+
+    // Solves the subgame at the given depth, and stores the solution in m_winner.
+    void solve(std::uint32_t depth)
+    {
+      std::vector<index_type>& V = m_vertices[depth];
+      if (V.empty())
+      {
+        return;
+      }
+
+      std::size_t m = (std::numeric_limits<std::size_t>::max)();
+      for (index_type u: V)
+      {
+        m = std::min(m, m_flat.rank(u));
+      }
+      std::size_t alpha = m % 2;
+
+      // A = attr_alpha(U), with U the vertices of minimal rank
+      std::vector<index_type>& A = pool(m_attractor, depth);
+      A.clear();
+      next_stamp();
+      for (index_type u: V)
+      {
+        if (m_flat.rank(u) == m)
+        {
+          attractor_insert(A, u);
+        }
+      }
+      for (index_type u: A)
+      {
+        if (m_flat.decoration(u) == alpha)
+        {
+          auto v = undefined_vertex();
+          for (index_type w: m_flat.successors(u))
+          {
+            if (m_level[w] == depth)
+            {
+              v = w;
+              if (in_attractor(w))
+              {
+                break;
+              }
+            }
+          }
+          if (v != undefined_vertex())
+          {
+            set_strategy(u, v);
+          }
+        }
+      }
+      attractor(A, depth, alpha);
+
+      // solve V \ A
+      std::vector<index_type>& V1 = pool(m_vertices, depth + 1);
+      V1.clear();
+      for (index_type u: V)
+      {
+        if (!in_attractor(u))
+        {
+          m_level[u] = depth + 1;
+          V1.push_back(u);
+        }
+      }
+      solve(depth + 1);
+      for (index_type u: A)
+      {
+        m_winner[u] = static_cast<std::uint8_t>(alpha);
+      }
+
+      // B = attr_{1-alpha}(W_1[1 - alpha])
+      next_stamp();
+      A.clear();
+      std::vector<index_type>& B = A;
+      for (index_type u: V1)
+      {
+        m_level[u] = depth;
+        if (m_winner[u] != alpha)
+        {
+          attractor_insert(B, u);
+        }
+      }
+      std::size_t W1_size = B.size();
+      if (W1_size == 0)
+      {
+        return;
+      }
+      attractor(B, depth, 1 - alpha);
+      if (m_use_toms_optimization && B.size() == W1_size)
+      {
+        return;
+      }
+
+      // solve V \ B
+      V1.clear();
+      for (index_type u: V)
+      {
+        if (!in_attractor(u))
+        {
+          m_level[u] = depth + 1;
+          V1.push_back(u);
+        }
+      }
+      solve(depth + 1);
+      for (index_type u: V1)
+      {
+        m_level[u] = depth;
+      }
+      for (index_type u: B)
+      {
+        m_winner[u] = static_cast<std::uint8_t>(1 - alpha);
+      }
+    }
+
+  public:
+    /// \brief Constructor
+    /// \param G A structure graph. The strategy attributes of its vertices are updated by run.
+    /// \param use_toms_optimization If true, some recursive calls are skipped. The computed strategy may then be wrong.
+    /// \param number_of_threads The number of threads that is used to compute attractors.
+    explicit flat_zielonka_solver(const structure_graph& G, bool use_toms_optimization = false, std::size_t number_of_threads = 1)
+      : m_graph(G),
+        m_flat(G),
+        m_use_toms_optimization(use_toms_optimization),
+        m_pool(number_of_threads)
+    {}
+
+    /// \brief Computes the winning sets of the structure graph, including vertices with decoration true or false.
+    /// \return The pair (Wdisj, Wconj) of vertices won by the disjunctive and the conjunctive player.
+    std::pair<vertex_set, vertex_set> run()
+    {
+      std::size_t N = m_flat.extent();
+      m_level.assign(N, 0);
+      m_winner.assign(N, 0);
+      m_attractor_stamp.assign(N, 0);
+      m_count.assign(N, 0);
+      m_stamp = 0;
+
+      for (index_type u = 0; u < N; u++)
+      {
+        if (m_flat.contains(u))
+        {
+          m_level[u] = 1;
+        }
+      }
+
+      // Remove the vertices that are attracted to false and true respectively. Both attractors are computed
+      // in the complete graph, as in solve_recursive_extended.
+      std::vector<index_type>& Vconj = pool(m_attractor, 0);
+      std::vector<index_type>& Vdisj = pool(m_vertices, 0);
+      for (std::size_t alpha: { 1, 0 })
+      {
+        std::vector<index_type>& A = alpha == 1 ? Vconj : Vdisj;
+        auto decoration = alpha == 1 ? structure_graph::d_false : structure_graph::d_true;
+        A.clear();
+        next_stamp();
+        for (index_type u = 0; u < N; u++)
+        {
+          if (m_level[u] == 1 && m_flat.decoration(u) == decoration)
+          {
+            attractor_insert(A, u);
+          }
+        }
+        attractor(A, 1, alpha);
+        for (index_type u: A)
+        {
+          m_winner[u] = static_cast<std::uint8_t>(alpha);
+        }
+      }
+      for (index_type u: Vconj)
+      {
+        m_level[u] = 0;
+      }
+      for (index_type u: Vdisj)
+      {
+        m_level[u] = 0;
+      }
+
+      std::vector<index_type>& V = pool(m_vertices, 1);
+      V.clear();
+      for (index_type u = 0; u < N; u++)
+      {
+        if (m_level[u] == 1)
+        {
+          V.push_back(u);
+        }
+      }
+      solve(1);
+
+      vertex_set Wdisj(N);
+      vertex_set Wconj(N);
+      for (index_type u = 0; u < N; u++)
+      {
+        if (m_flat.contains(u))
+        {
+          (m_winner[u] == 0 ? Wdisj : Wconj).insert(u);
+        }
+      }
+      return { Wdisj, Wconj };
+    }
+};
+
+} // namespace mcrl2::pbes_system
+
+#endif // MCRL2_PBES_SOLVE_STRUCTURE_GRAPH_FLAT_H
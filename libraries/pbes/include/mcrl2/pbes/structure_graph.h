@@ -19,6 +19,7 @@
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/pbes/pbes.h"
+#include "mcrl2/pbes/detail/structure_graph_edges.h"
 
 namespace mcrl2::pbes_system {
 
@@ -37,6 +38,8 @@ unsigned int undefined_vertex()
 
 // A structure graph with a facility to exclude a subset of the vertices.
 // It has the same interface as simple_structure_graph.
+// The edges are stored outside of the vertices, see detail::structure_graph_edges. After the
+// graph has been built, freeze() compacts them into compressed sparse row format.
 class structure_graph
 {
   friend struct detail::structure_graph_builder;
@@ -60,46 +63,24 @@ class structure_graph
       atermpp::detail::reference_aterm<pbes_expression> m_formula;
       decoration_type decoration;
       std::size_t rank;
-      std::vector<index_type> predecessors;
-      std::vector<index_type> successors;
       mutable index_type strategy;
 
       explicit vertex(pbes_expression  formula_,
              decoration_type decoration_ = structure_graph::d_none,
              std::size_t rank_ = data::undefined_index(),
-             std::vector<index_type> pred_ = std::vector<index_type>(),
-             std::vector<index_type> succ_ = std::vector<index_type>(),
              index_type strategy_ = undefined_vertex()
             )
         : m_formula(std::move(formula_)),
           decoration(decoration_),
           rank(rank_),
-          predecessors(std::move(pred_)),
-          successors(std::move(succ_)),
           strategy(strategy_)
       {}
 
-      void remove_predecessor(index_type u)
-      {
-        predecessors.erase(std::remove(predecessors.begin(), predecessors.end(), u), predecessors.end());
-      }
-
       // Downcast reference aterm
       inline const pbes_expression& formula() const
       {
         return m_formula;
       }
-
-      void remove_successor(index_type u)
-      {
-        successors.erase(std::remove(successors.begin(), successors.end(), u), successors.end());
-      }
-
-      bool is_defined() const
-      {
-        return  ((decoration != structure_graph::d_none) || (rank != data::undefined_index()))
-             && (!successors.empty() || (decoration == d_true || decoration == d_false));
-      }
       
       void inline mark(atermpp::term_mark_stack& todo) const
       {
@@ -108,9 +89,12 @@ class structure_graph
     };
 
     using vertex_vector = atermpp::vector<vertex, std::allocator<atermpp::detail::reference_aterm<vertex>>, mcrl2::utilities::detail::GlobalThreadSafe>;
+    using edge_range = detail::structure_graph_edges::edge_range;
 
   protected:
     vertex_vector m_vertices;
+    detail::structure_graph_edges m_successors;
+    detail::structure_graph_edges m_predecessors;
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
@@ -179,14 +163,14 @@ class structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& all_predecessors(index_type u) const
+    edge_range all_predecessors(index_type u) const
     {
-      return find_vertex(u).predecessors;
+      return m_predecessors.edges(u);
     }
 
-    const std::vector<index_type>& all_successors(index_type u) const
+    edge_range all_successors(index_type u) const
     {
-      return find_vertex(u).successors;
+      return m_successors.edges(u);
     }
 
     boost::filtered_range<vertices_not_contained_in, const vertex_vector> vertices() const
@@ -194,16 +178,45 @@ class structure_graph
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> predecessors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const edge_range> predecessors(index_type u) const
     {
       return all_predecessors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> successors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const edge_range> successors(index_type u) const
     {
       return all_successors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
+    // Inserts the edge (u, v), if it is not present yet.
+    void insert_edge(index_type u, index_type v)
+    {
+      if (!m_successors.contains(u, v))
+      {
+        m_successors.insert(u, v);
+        m_predecessors.insert(v, u);
+      }
+    }
+
+    void remove_edge(index_type u, index_type v)
+    {
+      m_successors.remove(u, v);
+      m_predecessors.remove(v, u);
+    }
+
+    // Compacts the edges into compressed sparse row format. The graph can still be modified afterwards,
+    // but the first modification undoes the compaction.
+    void freeze()
+    {
+      m_successors.freeze();
+      m_predecessors.freeze();
+    }
+
+    bool is_frozen() const
+    {
+      return m_successors.is_frozen();
+    }
+
     index_type strategy(index_type u) const
     {
       return find_vertex(u).strategy;
@@ -240,10 +253,25 @@ class structure_graph
       return m_exclude.all();
     }
 
+    // Returns true if vertex u has a rank or a decoration, and it has successors unless it is true or false
+    bool is_defined(index_type u) const
+    {
+      const vertex& u_ = find_vertex(u);
+      return  ((u_.decoration != structure_graph::d_none) || (u_.rank != data::undefined_index()))
+           && (!all_successors(u).empty() || (u_.decoration == d_true || u_.decoration == d_false));
+    }
+
     // Returns true if all vertices have a rank and a decoration
     bool is_defined() const
     {
-      return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
+      for (index_type u = 0; u < m_vertices.size(); u++)
+      {
+        if (!is_defined(u))
+        {
+          return false;
+        }
+      }
+      return true;
     }
 };
 
@@ -289,8 +317,6 @@ std::ostream& operator<<(std::ostream& out, const structure_graph::vertex& u)
   out << "vertex(formula = " << u.formula()
       << ", decoration = " << u.decoration
       << ", rank = " << (u.rank == data::undefined_index() ? std::string("undefined") : std::to_string(u.rank))
-      << ", predecessors = " << core::detail::print_list(u.predecessors)
-      << ", successors = " << core::detail::print_list(u.successors)
       << ", strategy = " << (u.strategy == undefined_vertex() ? std::string("undefined") : std::to_string(u.strategy))
       << ")";
   return out;
@@ -136,14 +136,7 @@ struct structure_graph_builder
 
   void insert_edge(index_type ui, index_type vi)
   {
-    using utilities::detail::contains;
-    auto& u = vertex(ui);
-    auto& v = vertex(vi);
-    if (!contains(u.successors, vi))
-    {
-      u.successors.push_back(vi);
-      v.predecessors.push_back(ui);
-    }
+    m_graph.insert_edge(ui, vi);
   }
 
   void set_initial_state(const propositional_variable_instantiation& x)
@@ -165,6 +158,12 @@ struct structure_graph_builder
     m_graph.m_exclude = boost::dynamic_bitset<>(m_graph.extent());
   }
 
+  // call when no more edges will be added, to compact the edges of m_graph
+  void freeze()
+  {
+    m_graph.freeze();
+  }
+
   index_type find_vertex(const pbes_expression& x) const
   {
     auto i = m_vertex_map.find(x);
@@ -178,9 +177,6 @@ struct structure_graph_builder
   // Erases all vertices in the set U.
   void erase_vertices(const vertex_set& U)
   {
-
-    using utilities::detail::contains;
-
     // compute new index for the vertices
     std::vector<index_type> index;
     structure_graph::index_type count = 0;
@@ -190,25 +186,14 @@ struct structure_graph_builder
     }
 
     // computes new predecessors / successors
-    auto update = [&](const std::vector<index_type>& V) {
-      std::vector<index_type> result;
-      for (auto v: V)
-      {
-        if (index[v] != undefined_vertex())
-        {
-          result.push_back(index[v]);
-        }
-      }
-      return result;
-    };
+    m_graph.m_predecessors.renumber(index);
+    m_graph.m_successors.renumber(index);
 
     for (index_type u = 0; u != vertices().size(); u++)
     {
       if (index[u] != undefined_vertex())
       {
         structure_graph::vertex& u_ = vertex(u);
-        u_.predecessors = update(u_.predecessors);
-        u_.successors = update(u_.successors);
         if (u_.strategy != undefined_vertex())
         {
           u_.strategy = index[u_.strategy];
@@ -237,6 +222,8 @@ struct manual_structure_graph_builder
 
   structure_graph& m_graph;
   structure_graph::vertex_vector m_vertices;
+  detail::structure_graph_edges m_successors;
+  detail::structure_graph_edges m_predecessors;
   index_type m_initial_state = 0U; // The initial state.
 
   explicit manual_structure_graph_builder(structure_graph& G)
@@ -252,22 +239,17 @@ struct manual_structure_graph_builder
 
   void insert_edge(index_type ui, index_type vi)
   {
-    using utilities::detail::contains;
-    structure_graph::vertex& u = m_vertices[ui];
-    structure_graph::vertex& v = m_vertices[vi];
-    if (!contains(u.successors, vi))
+    if (!m_successors.contains(ui, vi))
     {
-      u.successors.push_back(vi);
-      v.predecessors.push_back(ui);
+      m_successors.insert(ui, vi);
+      m_predecessors.insert(vi, ui);
     }
   }
 
   void remove_edge(index_type ui, index_type vi)
   {
-    structure_graph::vertex& u = m_vertices[ui];
-    structure_graph::vertex& v = m_vertices[vi];
-    u.remove_successor(vi);
-    v.remove_predecessor(ui);
+    m_successors.remove(ui, vi);
+    m_predecessors.remove(vi, ui);
   }
 
   void set_initial_state(const index_type i)
@@ -280,6 +262,9 @@ struct manual_structure_graph_builder
   void finalize()
   {
     m_graph.m_vertices = m_vertices;
+    m_graph.m_successors = m_successors;
+    m_graph.m_predecessors = m_predecessors;
+    m_graph.freeze();
     m_graph.m_initial_vertex = m_initial_state;
 
     std::size_t N = m_vertices.size();
@@ -0,0 +1,101 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file solve_structure_graph_test.cpp
+/// \brief Compares the flat Zielonka solver with the recursive one.
+
+#define BOOST_TEST_MODULE solve_structure_graph_test
+
+#include <random>
+#include <boost/test/included/unit_test.hpp>
+#include "mcrl2/pbes/solve_structure_graph.h"
+#include "mcrl2/pbes/structure_graph_builder.h"
+
+using namespace mcrl2;
+using namespace mcrl2::pbes_system;
+
+// Exposes the recursive solver.
+struct recursive_solver: public solve_structure_graph_algorithm
+{
+  using solve_structure_graph_algorithm::solve_structure_graph_algorithm;
+  using solve_structure_graph_algorithm::solve_recursive_extended;
+};
+
+// Creates a random structure graph with N vertices. Some of the vertices without successors are decorated with true
+// or false.
+static void random_structure_graph(structure_graph& G, std::size_t N, std::size_t max_rank, std::mt19937& generator)
+{
+  detail::manual_structure_graph_builder builder(G);
+  std::uniform_int_distribution<std::size_t> vertex(0, N - 1);
+  std::uniform_int_distribution<std::size_t> rank(0, max_rank);
+  std::uniform_int_distribution<std::size_t> out_degree(0, 3);
+  std::bernoulli_distribution coin;
+
+  for (std::size_t i = 0; i < N; i++)
+  {
+    builder.insert_vertex(coin(generator), rank(generator));
+  }
+  std::vector<std::size_t> degree(N);
+  for (std::size_t i = 0; i < N; i++)
+  {
+    degree[i] = out_degree(generator);
+    for (std::size_t j = 0; j < degree[i]; j++)
+    {
+      builder.insert_edge(i, vertex(generator));
+    }
+  }
+  builder.set_initial_state(0);
+  builder.finalize();
+
+  for (std::size_t i = 0; i < N; i++)
+  {
+    if (degree[i] == 0)
+    {
+      G.find_vertex(i).decoration = coin(generator) ? structure_graph::d_true : structure_graph::d_false;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_zielonka_solver)
+{
+  std::mt19937 generator(12345);
+  for (std::size_t i = 0; i < 500; i++)
+  {
+    structure_graph G;
+    random_structure_graph(G, 1 + i % 40, 1 + i % 6, generator);
+
+    for (bool use_toms_optimization: { false, true })
+    {
+      recursive_solver algorithm(false, use_toms_optimization);
+      auto [Wdisj, Wconj] = algorithm.solve_recursive_extended(G);
+      auto [Wdisj_flat, Wconj_flat] = flat_zielonka_solver(G, use_toms_optimization).run();
+      BOOST_CHECK(Wdisj == Wdisj_flat);
+      BOOST_CHECK(Wconj == Wconj_flat);
+    }
+
+    // The strategy computed by the flat solver is checked against the recursive solver.
+    solve_structure_graph_algorithm algorithm(true, false);
+    BOOST_CHECK_NO_THROW(algorithm.solve_partitions(G));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_zielonka_solver_parallel)
+{
+  // The graph is large enough for the attractors to be computed by multiple threads.
+  std::mt19937 generator(54321);
+  structure_graph G;
+  random_structure_graph(G, 100000, 5, generator);
+
+  auto [Wdisj, Wconj] = flat_zielonka_solver(G, false, 1).run();
+  auto [Wdisj_parallel, Wconj_parallel] = flat_zielonka_solver(G, false, 4).run();
+  BOOST_CHECK(Wdisj == Wdisj_parallel);
+  BOOST_CHECK(Wconj == Wconj_parallel);
+
+  solve_structure_graph_algorithm algorithm(true, false, 4);
+  BOOST_CHECK_NO_THROW(algorithm.solve_partitions(G));
+}
@@ -0,0 +1,100 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file structure_graph_test.cpp
+/// \brief Tests for the edge storage of structure graphs.
+
+#define BOOST_TEST_MODULE structure_graph_test
+
+#include <boost/test/included/unit_test.hpp>
+#include "mcrl2/pbes/structure_graph_builder.h"
+
+using namespace mcrl2;
+using namespace mcrl2::pbes_system;
+
+static std::vector<unsigned int> to_vector(const detail::structure_graph_edges::edge_range& r)
+{
+  return std::vector<unsigned int>(r.begin(), r.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_structure_graph_edges)
+{
+  using V = std::vector<unsigned int>;
+  detail::structure_graph_edges E;
+  E.insert(0, 2);
+  E.insert(3, 1);
+  E.insert(0, 1);
+  E.insert(0, 3);
+  BOOST_CHECK(to_vector(E.edges(0)) == V({2, 1, 3}));
+  BOOST_CHECK(to_vector(E.edges(1)).empty());
+  BOOST_CHECK(to_vector(E.edges(3)) == V({1}));
+  BOOST_CHECK(to_vector(E.edges(7)).empty());
+  BOOST_CHECK(E.contains(0, 1));
+  BOOST_CHECK(!E.contains(1, 0));
+
+  E.remove(0, 1);
+  BOOST_CHECK(to_vector(E.edges(0)) == V({2, 3}));
+  E.remove(0, 3);
+  E.insert(0, 4);
+  BOOST_CHECK(to_vector(E.edges(0)) == V({2, 4}));
+  BOOST_CHECK_EQUAL(E.number_of_edges(), 3u);
+
+  // the nodes of removed edges are reused
+  for (unsigned int i = 0; i < 10; i++)
+  {
+    E.insert(5, i);
+    E.remove(5, i);
+  }
+  BOOST_CHECK(to_vector(E.edges(5)).empty());
+  BOOST_CHECK_EQUAL(E.number_of_edges(), 3u);
+
+  E.freeze();
+  BOOST_CHECK(E.is_frozen());
+  BOOST_CHECK_EQUAL(E.number_of_edges(), 3u);
+  BOOST_CHECK(to_vector(E.edges(0)) == V({2, 4}));
+  BOOST_CHECK(to_vector(E.edges(1)).empty());
+  BOOST_CHECK(to_vector(E.edges(3)) == V({1}));
+  BOOST_CHECK(to_vector(E.edges(7)).empty());
+
+  // inserting an edge in a frozen list thaws it
+  E.insert(1, 0);
+  BOOST_CHECK(!E.is_frozen());
+  BOOST_CHECK(to_vector(E.edges(0)) == V({2, 4}));
+  BOOST_CHECK(to_vector(E.edges(1)) == V({0}));
+
+  // remove vertex 2, and renumber 3 -> 2 and 4 -> 3
+  E.renumber({0, 1, undefined_vertex(), 2, 3});
+  BOOST_CHECK(to_vector(E.edges(0)) == V({3}));
+  BOOST_CHECK(to_vector(E.edges(1)) == V({0}));
+  BOOST_CHECK(to_vector(E.edges(2)) == V({1}));
+}
+
+BOOST_AUTO_TEST_CASE(test_manual_structure_graph_builder)
+{
+  structure_graph G;
+  detail::manual_structure_graph_builder builder(G);
+  auto u = builder.insert_vertex(false, 0);
+  auto v = builder.insert_vertex(true, 1);
+  builder.insert_edge(u, v);
+  builder.insert_edge(u, v);
+  builder.insert_edge(v, u);
+  builder.insert_edge(v, v);
+  builder.remove_edge(v, v);
+  builder.set_initial_state(u);
+  builder.finalize();
+
+  BOOST_CHECK(G.is_frozen());
+  BOOST_CHECK(G.is_defined());
+  BOOST_CHECK_EQUAL(structure_graph_successors(G, u).size(), 1u);
+  BOOST_CHECK_EQUAL(structure_graph_predecessors(G, u).size(), 1u);
+  BOOST_CHECK_EQUAL(structure_graph_successors(G, v).size(), 1u);
+  BOOST_CHECK_EQUAL(structure_graph_predecessors(G, v).size(), 1u);
+
+  G.exclude()[v] = true;
+  BOOST_CHECK(structure_graph_successors(G, u).empty());
+}
@@ -11,8 +11,13 @@
 #define MCRL2_PG_RECURSIVE_SOLVER_H
 
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/pg/DenseSet.h"
 #include "mcrl2/pg/ParityGameSolver.h"
 
+#include <memory>
+
+class ParallelAttractorWorkspace;
+
 /*! Provides a view of a strategy corresponding to a subset of the vertex set.
     Note that elements of the substrategy can be written to, and the underlying
     global strategy is then updated accordingly, transparently mapping local
@@ -103,11 +108,12 @@ private:
 priority_t first_inversion(const ParityGame &game);
 
 
-/*! Parity game solver implementing Zielonka's recursive algorithm. */
+/*! Parity game solver implementing Zielonka's recursive algorithm. With more
+    than one thread, the attractor sets are computed in parallel. */
 class RecursiveSolver : public ParityGameSolver
 {
 public:
-    RecursiveSolver(const ParityGame &game);
+    RecursiveSolver(const ParityGame &game, std::size_t number_of_threads = 1);
     ~RecursiveSolver() override;
 
     ParityGame::Strategy solve() override;
@@ -115,13 +121,30 @@ public:
   private:
     /*! Solves a subgame recursively, or returns false if solving is aborted. */
     bool solve(ParityGame &game, Substrategy &strat);
+
+    /*! Computes an attractor set, using multiple threads if requested. */
+    void make_attractor(const ParityGame &game, ParityGame::Player player,
+                        DenseSet<verti> &vertices, Substrategy &strat);
+
+    //! The number of threads used to compute attractor sets.
+    std::size_t number_of_threads_;
+
+    //! The threads and counters of the parallel attractor set computations of a solve.
+    std::unique_ptr<ParallelAttractorWorkspace> attractor_workspace_;
 };
 
 //! Factory object for RecursiveSolver instances.
 class RecursiveSolverFactory : public ParityGameSolverFactory
 {
+public:
+    RecursiveSolverFactory(std::size_t number_of_threads = 1)
+        : number_of_threads_(number_of_threads) { }
+
     //! Returns a new ResuriveSolver instance.
     ParityGameSolver* create(const ParityGame& game, const verti* vertex_map, verti vertex_map_size) override;
+
+private:
+    std::size_t number_of_threads_;
 };
 
 #endif /* ndef MCRL2_PG_RECURSIVE_SOLVER_H */
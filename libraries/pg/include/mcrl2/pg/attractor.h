@@ -11,6 +11,11 @@
 #define MCRL2_PG_ATTRACTOR_H
 
 #include "mcrl2/pg/ParityGame.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
 
 /*! Helper function: returns whether all elements in range [begin:end) are
     elements of `set`.  Note that both the range and the set elements must be
@@ -32,6 +37,71 @@ template<class SetT, class DequeT, class StrategyT>
 void make_attractor_set( const ParityGame &game, ParityGame::Player player,
     SetT &vertices, DequeT &todo, StrategyT &strategy );
 
+/*! The threads and the vertex counters used by make_attractor_set_parallel.
+    A solver keeps one workspace for all its attractor set computations, such
+    that the counters are allocated once and the threads are started once.
+
+    The upper half of a counter is a stamp. If it is equal to the stamp of the
+    current computation, the lower half is the number of successors of the
+    vertex outside the attractor set, which is zero for vertices in the
+    attractor set. Otherwise the counter has not been initialised yet. */
+class ParallelAttractorWorkspace
+{
+public:
+    explicit ParallelAttractorWorkspace(std::size_t number_of_threads)
+        : pool_(number_of_threads) { }
+
+    /*! Starts a new attractor set computation in a graph with V vertices. */
+    void start(verti V)
+    {
+        if (size_ < V)
+        {
+            counters_.reset(new std::atomic<std::uint64_t>[V]);
+            size_ = V;
+            reset_counters();
+        }
+        if (++stamp_ == 0)
+        {
+            reset_counters();
+            stamp_ = 1;
+        }
+    }
+
+    //! Returns the counter of vertex v.
+    std::atomic<std::uint64_t> &counter(verti v) { return counters_[v]; }
+
+    //! Returns the stamp of the current computation, shifted to the upper half.
+    std::uint64_t stamp() const { return static_cast<std::uint64_t>(stamp_) << 32; }
+
+    //! Returns the threads that process the layers of the breadth first search.
+    mcrl2::utilities::detail::parallel_for_pool &pool() { return pool_; }
+
+private:
+    void reset_counters()
+    {
+        for (verti v = 0; v < size_; ++v)
+        {
+            counters_[v].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    mcrl2::utilities::detail::parallel_for_pool pool_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counters_;
+    verti size_ = 0;
+    std::uint32_t stamp_ = 0;
+};
+
+/*! Computes the attractor set of the given vertex set, like
+    make_attractor_set_2, but processes large layers of the breadth first search
+    with the threads of `workspace`. The number of successors outside the
+    attractor set is kept in an atomic counter for every vertex. If the graph
+    stores successors, the counters are initialised when a vertex is first
+    encountered; otherwise they are counted from the predecessors first. */
+template<class SetT, class StrategyT>
+void make_attractor_set_parallel( const ParityGame &game,
+    ParityGame::Player player, SetT &vertices, StrategyT &strategy,
+    ParallelAttractorWorkspace &workspace );
+
 #include "attractor_impl.h"
 
 #endif /* MCRL2_PG_ATTRACTOR_H */
@@ -12,6 +12,7 @@
 
 #include "mcrl2/pg/attractor.h"
 #include "mcrl2/pg/ParityGame_impl.h"
+#include "mcrl2/utilities/parallel_breadth_first_search.h"
 
 #include <queue>
 
@@ -158,4 +159,93 @@ void make_attractor_set_2( const ParityGame &game, ParityGame::Player player,
     }
 }
 
+template<class SetT, class StrategyT>
+void make_attractor_set_parallel( const ParityGame &game,
+    ParityGame::Player player, SetT &vertices, StrategyT &strategy,
+    ParallelAttractorWorkspace &workspace )
+{
+    const StaticGraph &graph = game.graph();
+    const verti V = graph.V();
+    workspace.start(V);
+    const std::uint64_t stamp = workspace.stamp();
+    const std::uint64_t liberties_mask = 0xffffffffULL;
+
+    // Without successors, the outdegrees of all vertices are counted from the
+    // predecessors beforehand.
+    const bool has_successors = (graph.edge_dir() & StaticGraph::EDGE_SUCCESSOR) != 0;
+    if (!has_successors)
+    {
+        for (verti v = 0; v < V; ++v)
+        {
+            workspace.counter(v).store(stamp, std::memory_order_relaxed);
+        }
+        for (verti v = 0; v < V; ++v)
+        {
+            for (StaticGraph::const_iterator it = graph.pred_begin(v); it != graph.pred_end(v); ++it)
+            {
+                workspace.counter(*it).fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns the number of successors of v outside the attractor set, given its counter c.
+    auto liberties = [&](verti v, std::uint64_t c) -> std::uint64_t
+    {
+        if ((c & ~liberties_mask) == stamp)
+        {
+            return c & liberties_mask;
+        }
+        assert(has_successors && graph.outdegree(v) <= liberties_mask);
+        return graph.outdegree(v);
+    };
+
+    std::vector<verti> todo;
+    for (typename SetT::const_iterator it = vertices.begin();
+         it != vertices.end(); ++it)
+    {
+        workspace.counter(*it).store(stamp, std::memory_order_relaxed);
+        todo.push_back(*it);
+    }
+    const std::size_t initial_size = todo.size();
+
+    // A vertex is added by the thread that sets its liberties to zero.
+    mcrl2::utilities::parallel_breadth_first_search(todo, workspace.pool(),
+        [&](verti w, std::vector<verti> &next)
+        {
+            for (StaticGraph::const_iterator it = graph.pred_begin(w);
+                 it != graph.pred_end(w); ++it)
+            {
+                const verti v = *it;
+                std::atomic<std::uint64_t> &counter = workspace.counter(v);
+                std::uint64_t c = counter.load(std::memory_order_relaxed);
+                bool added = false;
+                while (true)
+                {
+                    const std::uint64_t remaining = liberties(v, c);
+                    if (remaining == 0)
+                    {
+                        break;  // already in the attractor set
+                    }
+                    const std::uint64_t decreased = game.player(v) == player ? 0 : remaining - 1;
+                    if (counter.compare_exchange_weak(c, stamp | decreased, std::memory_order_relaxed))
+                    {
+                        added = decreased == 0;
+                        break;
+                    }
+                }
+                if (!added)
+                {
+                    continue;  // not in the attractor set yet, or added by another thread
+                }
+                strategy[v] = game.player(v) == player ? w : NO_VERTEX;
+                next.push_back(v);
+            }
+        });
+
+    for (std::size_t i = initial_size; i < todo.size(); ++i)
+    {
+        vertices.insert(todo[i]);
+    }
+}
+
 #endif // MCRL2_PG_ATTRACTOR_IMPL_H
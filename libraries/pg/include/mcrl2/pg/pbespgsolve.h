@@ -136,6 +136,7 @@ struct pbespgsolve_options
   bool use_deloop_solver = true;
   bool verify_solution = true;
   bool only_generate = false;
+  std::size_t number_of_threads = 1; // used for the attractor sets of the recursive solver
   data::rewriter::strategy rewrite_strategy = data::jitty;
 };
 
@@ -165,7 +166,7 @@ class pbespgsolve_algorithm
       else if (options.solver_type == recursive_solver)
       {
         // Create a recursive solver factory:
-        solver_factory = std::make_unique<RecursiveSolverFactory>();
+        solver_factory = std::make_unique<RecursiveSolverFactory>(options.number_of_threads);
       }
       else if (options.solver_type == priority_promotion)
       {
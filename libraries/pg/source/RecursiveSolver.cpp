@@ -64,8 +64,8 @@ priority_t first_inversion(const ParityGame &game)
     return p < d ? p : d;
 }
 
-RecursiveSolver::RecursiveSolver(const ParityGame &game)
-    : ParityGameSolver(game)
+RecursiveSolver::RecursiveSolver(const ParityGame &game, std::size_t number_of_threads)
+    : ParityGameSolver(game), number_of_threads_(number_of_threads)
 {
 }
 
@@ -77,10 +77,15 @@ ParityGame::Strategy RecursiveSolver::solve()
     game.assign(game_);
     ParityGame::Strategy strategy(game.graph().V(), NO_VERTEX);
     Substrategy substrat(strategy);
+    if (number_of_threads_ > 1)
+    {
+        attractor_workspace_ = std::make_unique<ParallelAttractorWorkspace>(number_of_threads_);
+    }
     if (!solve(game, substrat))
     {
       strategy.clear();
     }
+    attractor_workspace_.reset();
     return strategy;
 }
 
@@ -96,6 +101,19 @@ ParityGame::Strategy RecursiveSolver::solve()
    iterators to produce the set contents in-order.
 */
 
+void RecursiveSolver::make_attractor(const ParityGame &game,
+    ParityGame::Player player, DenseSet<verti> &vertices, Substrategy &strat)
+{
+    if (attractor_workspace_)
+    {
+        make_attractor_set_parallel(game, player, vertices, strat, *attractor_workspace_);
+    }
+    else
+    {
+        make_attractor_set_2(game, player, vertices, strat);
+    }
+}
+
 bool RecursiveSolver::solve(ParityGame &game, Substrategy &strat)
 {
   if (aborted())
@@ -125,7 +143,7 @@ bool RecursiveSolver::solve(ParityGame &game, Substrategy &strat)
             }
             mCRL2log(mcrl2::log::debug) <<"|min_prio|=" << min_prio_attr.size() << std::endl;
             assert(!min_prio_attr.empty());
-            make_attractor_set_2(game, player, min_prio_attr, strat);
+            make_attractor(game, player, min_prio_attr, strat);
             mCRL2log(mcrl2::log::debug) << "|min_prio_attr|=" << min_prio_attr.size() << std::endl;
             if (min_prio_attr.size() == V)
             {
@@ -160,7 +178,7 @@ bool RecursiveSolver::solve(ParityGame &game, Substrategy &strat)
             {
               break;
             }
-            make_attractor_set_2(game, opponent, lost_attr, strat);
+            make_attractor(game, opponent, lost_attr, strat);
             mCRL2log(mcrl2::log::debug) << "|lost_attr|=" << lost_attr.size() << std::endl;
             get_complement(V, lost_attr).swap(unsolved);
         }
@@ -234,5 +252,5 @@ ParityGameSolver *RecursiveSolverFactory::create( const ParityGame &game,
     (void)vertex_map;       // unused
     (void)vertex_map_size;  // unused
 
-    return new RecursiveSolver(game);
+    return new RecursiveSolver(game, number_of_threads_);
 }
@@ -14,6 +14,7 @@
 
 #include "limits"
 #include <cmath>
+#include <cstdint>
 #include <unordered_map>
 #include "mcrl2/data/real_utilities.h"
 #include "mcrl2/pres/builder.h" 
@@ -26,91 +27,211 @@ namespace mcrl2::pres_system {
 
 namespace detail {
 
-inline double evaluate(const pres_expression& p, const std::unordered_map<core::identifier_string, double>& solution)
+/// \brief A res compiled to a flat array of instructions for a stack machine, in which the variables are
+///        replaced by their index in the sequence of equations, and the real constants by doubles.
+/// \details The values of true and false are represented by infinity and -infinity. The right hand side of
+///          each equation is a contiguous range of instructions in postfix order, such that evaluating it
+///          does not require hashing or traversing terms.
+class res_program
 {
-using value_cache_type = std::unordered_map<data::data_expression, double>;
-static value_cache_type value_cache;
-if (is_propositional_variable_instantiation(p))
-{
-  const propositional_variable_instantiation& pv = atermpp::down_cast<propositional_variable_instantiation>(p);
-  return solution.at(pv.name());
-  }
-  else if (is_plus(p))
-  {
-    // Take care that inf + -inf and -inf + inf yield inf. 
-    // Floating points arithmetic gives nan, which is incorrect. 
-    const plus& pp = atermpp::down_cast<plus>(p);
+  public:
+    enum class opcode: std::uint32_t
+    {
+      variable,        // push the value of variable operand
+      constant,        // push m_constants[operand]
+      plus,            // pop two values and push their sum, where an infinite left or right argument wins
+      and_,            // pop two values and push the minimum
+      or_,             // pop two values and push the maximum
+      const_multiply   // pop a value and multiply it with m_constants[operand], unless the latter is 0
+    };
+
+    struct instruction
+    {
+      opcode op;
+      std::uint32_t operand;
+    };
+
+  protected:
+    std::vector<instruction> m_instructions;
+    std::vector<std::size_t> m_offsets;   // the instructions of expression i are in [m_offsets[i], m_offsets[i+1])
+    std::vector<double> m_constants;
+    std::unordered_map<data::data_expression, std::uint32_t> m_constant_index;
+    std::unordered_map<core::identifier_string, std::size_t> m_variable_index;
+    mutable std::vector<double> m_stack;
+    std::size_t m_depth = 0;
+
+    void emit(opcode op, std::size_t operand, std::ptrdiff_t stack_effect)
+    {
+      if (operand > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw mcrl2::runtime_error("The res is too large to be solved numerically.");
+      }
+      m_instructions.push_back(instruction{op, static_cast<std::uint32_t>(operand)});
+      m_depth = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_depth) + stack_effect);
+      m_stack.resize(std::max(m_stack.size(), m_depth));
+    }
+
+    std::size_t constant(const data::data_expression& x)
     {
-      double left=evaluate(pp.left(), solution);
-      if (std::isinf(left))
+      auto i = m_constant_index.find(x);
+      if (i != m_constant_index.end())
       {
-        return left;
+        return i->second;
       }
-      double right=evaluate(pp.right(), solution);
-      if (std::isinf(right))
+      if (data::sort_real::real_() != x.sort())
       {
-        return right;
+        throw mcrl2::runtime_error("Unexpected expression in evaluate: " + data::pp(x) + ".");
       }
-      return left+right;
+      std::size_t result = m_constants.size();
+      m_constants.push_back(data::sort_real::value<double>(x));
+      m_constant_index[x] = static_cast<std::uint32_t>(result);
+      return result;
     }
-  }
-  else if (is_true(p))
-  {
-    return std::numeric_limits<double>::infinity();
-  }
-  else if (is_false(p))
-  {
-    return -std::numeric_limits<double>::infinity();
-  }
-  else if (is_and(p))
-  {
-    const and_& pp = atermpp::down_cast<and_>(p);
-    return std::min(evaluate(pp.left(), solution), evaluate(pp.right(), solution));
-  }
-  else if (is_or(p))
-  {
-    const or_& pp = atermpp::down_cast<or_>(p);
-    return std::max(evaluate(pp.left(), solution), evaluate(pp.right(), solution));
-  }
-  else if (is_const_multiply(p))
-  {
-    const const_multiply& pp = atermpp::down_cast<const_multiply>(p);
-    const data::data_expression& pleft = pp.left();
-    const value_cache_type::const_iterator i=value_cache.find(pleft);
-    double r;
-    if (i==value_cache.end())
+
+    std::size_t constant(double value)
     {
-      r=data::sort_real::value<double>(pleft);
-      value_cache[pleft]=r;
+      m_constants.push_back(value);
+      return m_constants.size() - 1;
     }
-    else 
+
+    void compile(const pres_expression& p)
     {
-      r=i->second;
+      if (is_propositional_variable_instantiation(p))
+      {
+        const propositional_variable_instantiation& pv = atermpp::down_cast<propositional_variable_instantiation>(p);
+        auto i = m_variable_index.find(pv.name());
+        if (i == m_variable_index.end())
+        {
+          throw mcrl2::runtime_error("The variable " + core::pp(pv.name()) + " does not occur at the left hand side of an equation.");
+        }
+        emit(opcode::variable, i->second, 1);
+      }
+      else if (is_plus(p))
+      {
+        const pres_system::plus& pp = atermpp::down_cast<pres_system::plus>(p);
+        compile(pp.left());
+        compile(pp.right());
+        emit(opcode::plus, 0, -1);
+      }
+      else if (is_true(p))
+      {
+        emit(opcode::constant, constant(std::numeric_limits<double>::infinity()), 1);
+      }
+      else if (is_false(p))
+      {
+        emit(opcode::constant, constant(-std::numeric_limits<double>::infinity()), 1);
+      }
+      else if (is_and(p))
+      {
+        const pres_system::and_& pp = atermpp::down_cast<pres_system::and_>(p);
+        compile(pp.left());
+        compile(pp.right());
+        emit(opcode::and_, 0, -1);
+      }
+      else if (is_or(p))
+      {
+        const pres_system::or_& pp = atermpp::down_cast<pres_system::or_>(p);
+        compile(pp.left());
+        compile(pp.right());
+        emit(opcode::or_, 0, -1);
+      }
+      else if (is_const_multiply(p))
+      {
+        const pres_system::const_multiply& pp = atermpp::down_cast<pres_system::const_multiply>(p);
+        std::size_t c = constant(pp.left());
+        compile(pp.right());
+        emit(opcode::const_multiply, c, 0);
+      }
+      else if (data::is_data_expression(p))
+      {
+        emit(opcode::constant, constant(atermpp::down_cast<data::data_expression>(p)), 1);
+      }
+      else
+      {
+        throw runtime_error("Unknown term format in evaluate " + pres_system::pp(p) + ".");
+      }
+    }
+
+    void add(const pres_expression& p)
+    {
+      compile(p);
+      m_depth = 0;
+      m_offsets.push_back(m_instructions.size());
     }
-    if (r==0.0)
+
+  public:
+    res_program() = default;
+
+    /// \brief Compiles the right hand sides of the equations, which get the indices 0, ..., n-1 where n is the
+    ///        number of equations, and the initial state, which gets index n. The value of the variable of
+    ///        equation j is stored at index j of a solution.
+    res_program(const std::vector<pres_equation>& equations, const pres_expression& initial_state)
     {
-      return r;
+      for (std::size_t j = 0; j < equations.size(); ++j)
+      {
+        m_variable_index[equations[j].variable().name()] = j;
+      }
+      m_offsets.push_back(0);
+      for (const pres_equation& eq: equations)
+      {
+        add(eq.formula());
+      }
+      add(initial_state);
+      m_constant_index.clear();
+      m_variable_index.clear();
     }
-    return r * evaluate(pp.right(), solution);
-  }
-  else if (data::is_data_expression(p))
-  {
-    const data::data_expression& pp = atermpp::down_cast<data::data_expression>(p);
-    const value_cache_type::const_iterator i=value_cache.find(pp);
-    if (i==value_cache.end())
+
+    /// \brief Evaluates the expression with index i, where the value of variable j is given by solution[j].
+    double evaluate(std::size_t i, const std::vector<double>& solution) const
     {
-      if (data::sort_real::real_() == pp.sort())
+      const instruction* first = m_instructions.data() + m_offsets[i];
+      const instruction* last = m_instructions.data() + m_offsets[i + 1];
+      double* top = m_stack.data();  // points just after the top of the stack
+      for (; first != last; ++first)
       {
-        double r=data::sort_real::value<double>(pp);
-        value_cache[pp]=r;
-        return r;
+        switch (first->op)
+        {
+          case opcode::variable:
+            *top++ = solution[first->operand];
+            break;
+          case opcode::constant:
+            *top++ = m_constants[first->operand];
+            break;
+          case opcode::plus:
+          {
+            // Take care that inf + -inf and -inf + inf yield the left argument.
+            // Floating points arithmetic gives nan, which is incorrect.
+            const double right = *--top;
+            double& left = top[-1];
+            if (!std::isinf(left))
+            {
+              left = std::isinf(right) ? right : left + right;
+            }
+            break;
+          }
+          case opcode::and_:
+          {
+            const double right = *--top;
+            top[-1] = std::min(top[-1], right);
+            break;
+          }
+          case opcode::or_:
+          {
+            const double right = *--top;
+            top[-1] = std::max(top[-1], right);
+            break;
+          }
+          case opcode::const_multiply:
+          {
+            const double r = m_constants[first->operand];
+            top[-1] = r == 0.0 ? r : r * top[-1];
+            break;
+          }
+        }
       }
-      throw mcrl2::runtime_error("Unexpected expression in evaluate: " + data::pp(pp) + ".");
+      return top[-1];
     }
-    return i->second;
-  }
-  throw runtime_error("Unknown term format in evaluate " + pp(p) + ".");
-}
+};
 
 } // namespace detail
 
@@ -123,16 +244,17 @@ class ressolve_by_numerical_iteration
     enumerate_quantifiers_rewriter m_R;   // The rewriter.
     
     std::vector<pres_equation> m_equations;
-    std::unordered_map<core::identifier_string, double> m_new_solution, m_previous_solution;
+    detail::res_program m_program;
+    std::vector<double> m_new_solution, m_previous_solution;
 
     bool stable_solution_found(std::size_t from, std::size_t to)
     {
       double error=0;
       for(std::size_t i=from; i!=to; ++i)
       {
-        error = std::max(error,std::abs(m_new_solution[m_equations[i].variable().name()]-m_previous_solution[m_equations[i].variable().name()]));
+        error = std::max(error,std::abs(m_new_solution[i]-m_previous_solution[i]));
       }
-      mCRL2log(log::debug) << "Current solution: " << std::setprecision(static_cast<int>(m_options.precision)) << detail::evaluate(m_input_pres.initial_state(),m_new_solution) << "   " 
+      mCRL2log(log::debug) << "Current solution: " << std::setprecision(static_cast<int>(m_options.precision)) << m_program.evaluate(m_equations.size(),m_new_solution) << "   " 
                            << " Difference with previous iteration: " << error << "\n";     
       return error<=pow(0.1,static_cast<double>(m_options.precision));
     }
@@ -141,11 +263,11 @@ class ressolve_by_numerical_iteration
     {
       for(std::size_t j=base_equation_index ; j<to; ++j)
       {
-        m_previous_solution[m_equations[j].variable().name()]= m_new_solution[m_equations[j].variable().name()];
+        m_previous_solution[j]= m_new_solution[j];
       }
       for(std::size_t j=base_equation_index ; j<to; ++j)
       { 
-        m_new_solution[m_equations[j].variable().name()] = detail::evaluate(m_equations[j].formula(), m_new_solution);
+        m_new_solution[j] = m_program.evaluate(j, m_new_solution);
       }
     }
 
@@ -159,7 +281,7 @@ class ressolve_by_numerical_iteration
           const double sol = (m_equations[i].symbol().is_mu()?
                                              -1*std::numeric_limits<double>::infinity():
                                              std::numeric_limits<double>::infinity());
-          m_new_solution[m_equations[i].variable().name()] = sol;
+          m_new_solution[i] = sol;
                                                                   
         }
 
@@ -215,9 +337,14 @@ class ressolve_by_numerical_iteration
       {
         m_equations.emplace_back(eq.symbol(), eq.variable(), m_R(eq.formula()));
       }
+
+      m_program = detail::res_program(m_equations, m_input_pres.initial_state());
+      m_new_solution.resize(m_equations.size());
+      m_previous_solution.resize(m_equations.size());
+
       apply_numerical_recursive_algorithm(0);
 
-      double solution = detail::evaluate(m_input_pres.initial_state(),m_new_solution);
+      double solution = m_program.evaluate(m_equations.size(),m_new_solution);
       return solution;
     }
 };
@@ -14,6 +14,7 @@
 #include <chrono>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace mcrl2::smt
 {
@@ -24,6 +25,8 @@ protected:
   struct platform_impl;
 
   std::string m_name;
+  // The program and its arguments.
+  std::vector<std::string> m_command;
   // The declaration of the pipes requires expensive headers on Windows, so
   // we use the pimpl idiom to hide platform dependent implementation details.
   std::shared_ptr<platform_impl> m_pimpl;
@@ -37,7 +40,16 @@ protected:
 
 public:
   child_process(const std::string& name)
-  : m_name(name)
+  : child_process(name, { "z3", "-smt2", "-in" })
+  {}
+
+  /**
+   * \brief Starts the program command[0] with arguments command[1], command[2], ...
+   * The program is looked up in the PATH.
+   */
+  child_process(const std::string& name, const std::vector<std::string>& command)
+  : m_name(name),
+    m_command(command)
   {
     initialize();
   }
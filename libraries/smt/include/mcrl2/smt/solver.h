@@ -24,15 +24,44 @@ protected:
   native_translations m_native;
   std::unordered_map<data::data_expression, std::string> m_cache;
   child_process z3;
+  std::string m_output; // output of the solver that has been read, but not yet processed
+
+  // The maximal number of queries that is sent to the solver before the answers are read. This bounds the amount of
+  // output that the solver can produce while we are writing, such that neither process blocks on a full pipe.
+  static constexpr std::size_t max_batch_size = 256;
 
 protected:
 
-  answer execute_and_check(const std::string& command, const std::chrono::microseconds& timeout) const;
+  /// \brief Reads one line of output of the solver. If timeout is not zero and no output is available before the
+  /// timeout, the solver is interrupted.
+  std::string read_line(const std::chrono::microseconds& timeout);
+
+  /// \brief Converts the answer of the solver to the query command.
+  static answer parse_answer(const std::string& result, const std::string& command);
+
+  /// \brief Discards all output of the solver up to and including the answer to the last command that was sent.
+  /// This is used after an unexpected response, such that later queries are matched with their own answers.
+  void synchronise();
+
+  answer execute_and_check(const std::string& command, const std::chrono::microseconds& timeout);
+
+  /// \brief Writes the commands for checking the satisfiability of expr with free variables vars in a fresh scope.
+  void translate_query(const data::variable_list& vars, const data::data_expression& expr, std::ostream& out);
 
 public:
+  /// \brief Starts Z3 and declares the sorts and functions of dataspec.
   smt_solver(const data::data_specification& dataspec);
 
+  /// \brief Starts the solver command[0] with arguments command[1], command[2], ... and declares the sorts and
+  /// functions of dataspec. The solver must read SMT-LIB 2 from its standard input.
+  smt_solver(const data::data_specification& dataspec, const std::vector<std::string>& command);
+
   answer solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout = std::chrono::microseconds::zero());
+
+  /// \brief Checks the satisfiability of a number of independent queries, each consisting of free variables and
+  /// an expression. The queries are sent to the solver in batches, without waiting for the answer of each query.
+  /// \return The answers, in the order of the queries.
+  std::vector<answer> solve(const std::vector<std::pair<data::variable_list, data::data_expression>>& queries);
 };
 
 } // namespace mcrl2::smt
@@ -24,6 +24,7 @@
 #endif // MCRL2_PLATFORM_WINDOWS
 
 #include <array>
+#include <vector>
 #include <cstring>
 #include <csignal>
 #include <cerrno>
@@ -116,9 +117,15 @@ void child_process::initialize()
     throw mcrl2::runtime_error("Could not modify SMT solver handle: SetHandleInformation Stdin");
   }
   // Create the child process.
-  TCHAR szCmdline[] = TEXT("z3.exe -smt2 -in");
+  std::string command_line;
+  for (const std::string& argument: m_command)
+  {
+    command_line += (command_line.empty() ? "" : " ") + argument;
+  }
+  std::vector<char> szCmdline(command_line.begin(), command_line.end());
+  szCmdline.push_back('\0');
   PROCESS_INFORMATION piProcInfo;
-  STARTUPINFO siStartInfo;
+  STARTUPINFOA siStartInfo;
   BOOL bSuccess = FALSE;
 
   // Set up members of the PROCESS_INFORMATION structure.
@@ -126,16 +133,16 @@ void child_process::initialize()
 
   // Set up members of the STARTUPINFO structure.
   // This structure specifies the STDIN and STDOUT handles for redirection.
-  ZeroMemory(&siStartInfo, sizeof(STARTUPINFO));
-  siStartInfo.cb = sizeof(STARTUPINFO);
+  ZeroMemory(&siStartInfo, sizeof(STARTUPINFOA));
+  siStartInfo.cb = sizeof(STARTUPINFOA);
   siStartInfo.hStdError = m_pimpl->g_hChildStd_OUT_Wr;
   siStartInfo.hStdOutput = m_pimpl->g_hChildStd_OUT_Wr;
   siStartInfo.hStdInput = m_pimpl->g_hChildStd_IN_Rd;
   siStartInfo.dwFlags |= STARTF_USESTDHANDLES;
 
   // Create the child process.
-  bSuccess = CreateProcess(NULL,
-    szCmdline,     // command line
+  bSuccess = CreateProcessA(NULL,
+    szCmdline.data(), // command line
     NULL,          // process security attributes
     NULL,          // primary thread security attributes
     TRUE,          // handles are inherited
@@ -269,8 +276,13 @@ void child_process::initialize()
     ::close(m_pimpl->pipe_stdout[0]);
     ::close(m_pimpl->pipe_stderr[0]);
 
-    std::array<char*, 4> argv = { const_cast<char*>("z3"), const_cast<char*>("-smt2"), const_cast<char*>("-in"), nullptr };
-    ::execvp("z3", argv.data());
+    std::vector<char*> argv;
+    for (const std::string& argument: m_command)
+    {
+      argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+    ::execvp(argv[0], argv.data());
 
     ::_exit(errno);
   }
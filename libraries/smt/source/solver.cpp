@@ -8,6 +8,7 @@
 //
 /// \file solver.cpp
 
+#include <algorithm>
 #include "mcrl2/data/list.h"
 #include "mcrl2/smt/translate_specification.h"
 #include "mcrl2/smt/solver.h"
@@ -17,11 +18,29 @@
 namespace mcrl2::smt
 {
 
-answer smt_solver::execute_and_check(const std::string& s, const std::chrono::microseconds& timeout) const
+std::string smt_solver::read_line(const std::chrono::microseconds& timeout)
 {
-  z3.write(s);
+  std::size_t end = m_output.find('\n');
+  bool interrupted = false;
+  while (end == std::string::npos)
+  {
+    // Only the first read is subject to the timeout. After an interrupt the solver answers without delay.
+    bool use_timeout = timeout != std::chrono::microseconds::zero() && !interrupted;
+    m_output += use_timeout ? z3.read(timeout) : z3.read();
+    interrupted = use_timeout;
+    end = m_output.find('\n');
+  }
+  std::string result = m_output.substr(0, end);
+  m_output.erase(0, end + 1);
+  if (!result.empty() && result.back() == '\r')
+  {
+    result.pop_back();
+  }
+  return result;
+}
 
-  std::string result = timeout == std::chrono::microseconds::zero() ? z3.read() : z3.read(timeout);
+answer smt_solver::parse_answer(const std::string& result, const std::string& command)
+{
   if (result.starts_with("sat"))
   {
     return answer::SAT;
@@ -36,14 +55,51 @@ answer smt_solver::execute_and_check(const std::string& s, const std::chrono::mi
   }
   else
   {
-    mCRL2log(log::error) << "Error when checking satisfiability of \n" << s.substr(0, 500) << "...." << std::endl;
+    mCRL2log(log::error) << "Error when checking satisfiability of \n" << command.substr(0, 500) << "...." << std::endl;
     throw mcrl2::runtime_error("Got unexpected response from SMT-solver:\n" + result);
   }
 }
 
+void smt_solver::synchronise()
+{
+  // The solver prints the marker after all output of the earlier commands, so everything before it is discarded.
+  static const std::string marker = "@mcrl2_synchronise";
+  z3.write("(echo \"" + marker + "\")\n");
+  while (read_line(std::chrono::microseconds::zero()).find(marker) == std::string::npos)
+  {
+  }
+}
+
+answer smt_solver::execute_and_check(const std::string& s, const std::chrono::microseconds& timeout)
+{
+  z3.write(s);
+  try
+  {
+    return parse_answer(read_line(timeout), s);
+  }
+  catch (const mcrl2::runtime_error&)
+  {
+    synchronise();
+    throw;
+  }
+}
+
+void smt_solver::translate_query(const data::variable_list& vars, const data::data_expression& expr, std::ostream& out)
+{
+  out << "(push)\n";
+  translate_variable_declaration(vars, out, m_cache, m_native);
+  translate_assertion(expr, out, m_cache, m_native);
+  out << "(check-sat)\n";
+  out << "(pop)\n";
+}
+
 smt_solver::smt_solver(const data::data_specification& dataspec)
+: smt_solver(dataspec, { "z3", "-smt2", "-in" })
+{}
+
+smt_solver::smt_solver(const data::data_specification& dataspec, const std::vector<std::string>& command)
 : m_native(initialise_native_translation(dataspec))
-, z3("Z3")
+, z3("Z3", command)
 {
   std::ostringstream out;
   translate_data_specification(dataspec, out, m_cache, m_native);
@@ -52,13 +108,39 @@ smt_solver::smt_solver(const data::data_specification& dataspec)
 
 answer smt_solver::solve(const data::variable_list& vars, const data::data_expression& expr, const std::chrono::microseconds& timeout)
 {
-  z3.write("(push)\n");
   std::ostringstream out;
-  translate_variable_declaration(vars, out, m_cache, m_native);
-  translate_assertion(expr, out, m_cache, m_native);
-  out << "(check-sat)\n";
-  answer result = execute_and_check(out.str(), timeout);
-  z3.write("(pop)\n");
+  translate_query(vars, expr, out);
+  return execute_and_check(out.str(), timeout);
+}
+
+std::vector<answer> smt_solver::solve(const std::vector<std::pair<data::variable_list, data::data_expression>>& queries)
+{
+  std::vector<answer> result;
+  result.reserve(queries.size());
+  for (std::size_t first = 0; first < queries.size(); first += max_batch_size)
+  {
+    std::size_t last = std::min(queries.size(), first + max_batch_size);
+    std::ostringstream out;
+    for (std::size_t i = first; i < last; i++)
+    {
+      translate_query(queries[i].first, queries[i].second, out);
+    }
+    const std::string commands = out.str();
+    z3.write(commands);
+    try
+    {
+      for (std::size_t i = first; i < last; i++)
+      {
+        result.push_back(parse_answer(read_line(std::chrono::microseconds::zero()), commands));
+      }
+    }
+    catch (const mcrl2::runtime_error&)
+    {
+      // The answers to the remaining queries of the batch are still on their way.
+      synchronise();
+      throw;
+    }
+  }
   return result;
 }
 
@@ -0,0 +1,106 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file solver_test.cpp
+/// \brief Tests the communication with the SMT solver, using a shell script that mimics a solver.
+
+#define BOOST_TEST_MODULE solver_test
+
+#include <boost/test/included/unit_test.hpp>
+#include "mcrl2/data/parse.h"
+#include "mcrl2/smt/solver.h"
+#include "mcrl2/utilities/platform.h"
+
+using namespace mcrl2;
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+
+// Returns the command for a fake solver that answers each (check-sat) with the next element of answers, and starts
+// again with the first element after the last one. It prints the string of an (echo "...") command.
+static std::vector<std::string> fake_solver(const std::string& answers)
+{
+  return { "/bin/sh", "-c",
+           "set -- " + answers + "\n"
+           "while IFS= read -r line; do\n"
+           "  case \"$line\" in\n"
+           "    *\"(check-sat)\"*) echo \"$1\"; a=\"$1\"; shift; set -- \"$@\" \"$a\";;\n"
+           "    *\"(echo \\\"\"*) s=\"${line#*\\\"}\"; echo \"${s%%\\\"*}\";;\n"
+           "  esac\n"
+           "done\n" };
+}
+
+static std::pair<data::variable_list, data::data_expression> make_query(const std::string& text,
+                                                                        const data::variable_list& variables,
+                                                                        const data::data_specification& dataspec)
+{
+  return { variables, data::parse_data_expression(text, variables, dataspec) };
+}
+
+BOOST_AUTO_TEST_CASE(test_solve)
+{
+  data::data_specification dataspec = data::parse_data_specification("sort D = struct d1 | d2;");
+  data::variable_list variables({ data::parse_variable("n: Nat", dataspec), data::parse_variable("d: D", dataspec) });
+
+  smt::smt_solver solver(dataspec, fake_solver("unsat sat unknown"));
+  BOOST_CHECK_EQUAL(solver.solve(variables, data::parse_data_expression("n > 2", variables, dataspec)), smt::answer::UNSAT);
+  BOOST_CHECK_EQUAL(solver.solve(variables, data::parse_data_expression("d == d1", variables, dataspec)), smt::answer::SAT);
+  BOOST_CHECK_EQUAL(solver.solve(variables, data::parse_data_expression("n < 2 && d != d2", variables, dataspec)), smt::answer::UNKNOWN);
+  BOOST_CHECK_EQUAL(solver.solve(variables, data::parse_data_expression("true", variables, dataspec)), smt::answer::UNSAT);
+}
+
+BOOST_AUTO_TEST_CASE(test_solve_batch)
+{
+  data::data_specification dataspec = data::parse_data_specification("sort D = struct d1 | d2;");
+  data::variable_list variables({ data::parse_variable("n: Nat", dataspec) });
+
+  smt::smt_solver solver(dataspec, fake_solver("sat unsat unsat"));
+
+  // A single query is answered before the batch.
+  BOOST_CHECK_EQUAL(solver.solve(variables, data::parse_data_expression("n > 2", variables, dataspec)), smt::answer::SAT);
+
+  // The number of queries exceeds the size of a batch that is sent to the solver at once.
+  std::vector<std::pair<data::variable_list, data::data_expression>> queries;
+  for (std::size_t i = 0; i < 1000; i++)
+  {
+    queries.push_back(make_query("n > " + std::to_string(i), variables, dataspec));
+  }
+  std::vector<smt::answer> answers = solver.solve(queries);
+  BOOST_CHECK_EQUAL(answers.size(), queries.size());
+  for (std::size_t i = 0; i < answers.size(); i++)
+  {
+    BOOST_CHECK_EQUAL(answers[i], (i + 1) % 3 == 0 ? smt::answer::SAT : smt::answer::UNSAT);
+  }
+
+  BOOST_CHECK(solver.solve(std::vector<std::pair<data::variable_list, data::data_expression>>()).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_unexpected_answer)
+{
+  data::data_specification dataspec;
+  smt::smt_solver solver(dataspec, fake_solver("error"));
+  BOOST_CHECK_THROW(solver.solve(data::variable_list(), data::sort_bool::true_()), mcrl2::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_unexpected_answer_in_batch)
+{
+  data::data_specification dataspec;
+  smt::smt_solver solver(dataspec, fake_solver("sat error unsat"));
+  std::vector<std::pair<data::variable_list, data::data_expression>> queries(3, { data::variable_list(), data::sort_bool::true_() });
+  BOOST_CHECK_THROW(solver.solve(queries), mcrl2::runtime_error);
+
+  // The answer to the last query of the failed batch is not mistaken for the answer to the next query.
+  BOOST_CHECK_EQUAL(solver.solve(data::variable_list(), data::sort_bool::true_()), smt::answer::SAT);
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(test_skipped)
+{
+}
+
+#endif // MCRL2_PLATFORM_WINDOWS
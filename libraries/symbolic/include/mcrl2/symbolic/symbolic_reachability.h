@@ -12,6 +12,7 @@
 
 #ifdef MCRL2_ENABLE_SYLVAN
 
+#include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/data/consistency.h"
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/enumerator.h"
@@ -21,16 +22,20 @@
 #include "mcrl2/data/undefined.h"
 #include "mcrl2/symbolic/alternative_relprod.h"
 #include "mcrl2/symbolic/summand_group.h"
+#include "mcrl2/utilities/detail/parallel_for.h"
 #include "mcrl2/utilities/stopwatch.h"
 
 #include <sylvan_ldd.hpp>
 
+#include <memory>
+#include <type_traits>
+
 namespace mcrl2::symbolic {
 
 struct symbolic_reachability_options
 {
   data::rewrite_strategy rewrite_strategy = data::jitty;
-  std::size_t max_workers = 0;
+  std::size_t max_workers = 0; // the number of threads that is used to learn transitions; values below 2 mean sequential
   std::size_t max_iterations = 0;
   bool cached = false;
   bool chaining = false;
@@ -72,6 +77,7 @@ std::ostream& operator<<(std::ostream& out, const symbolic_reachability_options&
   out << "groups = " << options.summand_groups << std::endl;
   out << "reorder = " << options.variable_order << std::endl;
   out << "dot = " << options.dot_file << std::endl;
+  out << "max-workers = " << options.max_workers << std::endl;
   return out;
 }
 
@@ -183,10 +189,9 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
                            },
                            data::is_false
       );
-
-      ++i;
     }
     data::remove_assignments(sigma, smd.variables);
+    ++i;
   }
   data::remove_assignments(sigma, group.read_parameters);
   group.learn_calls += 1;
@@ -198,6 +203,236 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
   }
 }
 
+namespace detail {
+
+// The type of the action labels that are learned, or std::nullptr_t if there are none.
+template <typename Algorithm, bool ActionLabel>
+struct learned_action
+{
+  using type = atermpp::aterm;
+};
+
+template <typename Algorithm>
+struct learned_action<Algorithm, true>
+{
+  using type = typename std::decay_t<decltype(std::declval<Algorithm&>().action_index())>::key_type;
+};
+
+// The transitions that are learned by one thread. For the k-th transition, sources[k] contains the
+// positions of its source vector and its summand, and values[k * y_size, (k + 1) * y_size) contains
+// the values of the write parameters. The terms are stored in term containers, such that they are
+// protected by the thread that creates the containers and not by the thread that fills them.
+template <typename Action>
+struct learned_transitions
+{
+  std::vector<std::pair<std::size_t, std::size_t>> sources;
+  atermpp::vector<data::data_expression> values;
+  atermpp::vector<Action> actions;
+};
+
+} // namespace detail
+
+/// \brief The threads that learn transitions in parallel, each with its own clone of the rewriter, enumerator and
+///        substitution. These are created once for an exploration and used by all calls of learn_successors_parallel.
+/// \details The i-th worker is created, used and destroyed by the i-th thread of the thread pool only, as the terms
+///          of a clone are protected by the thread that creates them.
+class learn_successors_workers
+{
+  public:
+    struct worker
+    {
+      data::rewriter rewr;
+      data::mutable_indexed_substitution<> sigma;
+      data::enumerator_identifier_generator id_generator;
+      data::enumerator_algorithm<> enumerator;
+
+      worker(data::rewriter& rewr_, const data::mutable_indexed_substitution<>& sigma_, const data::data_specification& dataspec)
+        : rewr(rewr_.clone()),
+          sigma(sigma_),
+          id_generator("t_"),
+          enumerator(rewr, dataspec, rewr, id_generator, false)
+      {
+        // It is essential that the rewriter is cloned, as one rewriter cannot be used in parallel.
+        rewr.thread_initialise();
+      }
+    };
+
+    learn_successors_workers(const std::size_t number_of_threads,
+                             data::rewriter& rewr,
+                             const data::mutable_indexed_substitution<>& sigma,
+                             const data::data_specification& dataspec)
+      : m_thread_pool(number_of_threads),
+        m_workers(m_thread_pool.number_of_threads())
+    {
+      for_each_worker([&](std::unique_ptr<worker>& w) { w = std::make_unique<worker>(rewr, sigma, dataspec); });
+    }
+
+    ~learn_successors_workers()
+    {
+      for_each_worker([](std::unique_ptr<worker>& w) { w.reset(); });
+    }
+
+    learn_successors_workers(const learn_successors_workers&) = delete;
+    learn_successors_workers& operator=(const learn_successors_workers&) = delete;
+
+    std::size_t size() const
+    {
+      return m_workers.size();
+    }
+
+    /// \brief Calls f(t, worker t) on the t-th thread for all t < number_of_workers.
+    template <typename Function>
+    void parallel_for(const std::size_t number_of_workers, const Function& f)
+    {
+      m_thread_pool.parallel_for(number_of_workers, number_of_workers, [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t t = begin; t < end; t++)
+          {
+            f(t, *m_workers[t]);
+          }
+        });
+    }
+
+  private:
+    template <typename Function>
+    void for_each_worker(const Function& f)
+    {
+      m_thread_pool.parallel_for(m_workers.size(), m_workers.size(), [&](std::size_t begin, std::size_t end)
+        {
+          for (std::size_t t = begin; t < end; t++)
+          {
+            f(m_workers[t]);
+          }
+        });
+    }
+
+    utilities::detail::parallel_for_pool m_thread_pool;
+    std::vector<std::unique_ptr<worker>> m_workers;
+};
+
+/// \brief Computes the same transitions as learn_successors_callback for all vectors in X, but uses
+///        the threads of workers to do so.
+/// \details The vectors in X are split into consecutive ranges, and each thread enumerates the
+///          transitions of one range using its own worker. The data indices and the LDDs are only updated by the
+///          calling thread afterwards, in the order of the vectors in X. Therefore the resulting indices and L are
+///          the same as those computed by learn_successors_callback.
+template <typename Context, bool ActionLabel>
+void learn_successors_parallel(Context& context, const sylvan::ldds::ldd& X, learn_successors_workers& workers)
+{
+  using namespace sylvan::ldds;
+  using enumerator_element = data::enumerator_list_element_with_substitution<>;
+  using algorithm_type = std::remove_reference_t<decltype(context.first)>;
+  using action_type = typename detail::learned_action<algorithm_type, ActionLabel>::type;
+
+  auto& algorithm = context.first;
+  auto& group = context.second;
+  auto& data_index = algorithm.data_index();
+  const auto& options = algorithm.m_options;
+  std::size_t x_size = group.read.size();
+  std::size_t y_size = group.write.size();
+
+  stopwatch learn_start;
+  std::vector<std::vector<std::uint32_t>> xs = ldd_solutions(X);
+  std::size_t number_of_threads = std::max<std::size_t>(1, std::min(workers.size(), xs.size()));
+
+  std::vector<detail::learned_transitions<action_type>> results(number_of_threads);
+  workers.parallel_for(number_of_threads, [&](std::size_t t, learn_successors_workers::worker& worker)
+    {
+      const data::rewriter& rewr = worker.rewr;
+      data::mutable_indexed_substitution<>& sigma = worker.sigma;
+      data::enumerator_algorithm<>& enumerator = worker.enumerator;
+      auto& result = results[t];
+
+      for (std::size_t k = t * xs.size() / number_of_threads; k < (t + 1) * xs.size() / number_of_threads; k++)
+      {
+        for (std::size_t j = 0; j < x_size; j++)
+        {
+          sigma[group.read_parameters[j]] = data_index[group.read[j]][xs[k][j]];
+        }
+
+        std::size_t i = 0;
+        for (const auto& smd: group.summands)
+        {
+          data::data_expression condition = rewr(smd.condition, sigma);
+          if (!data::is_false(condition))
+          {
+            enumerator.enumerate(enumerator_element(smd.variables, condition),
+                                 sigma,
+                                 [&](const enumerator_element& p) {
+                                   check_enumerator_solution(p, group);
+                                   p.add_assignments(smd.variables, sigma, rewr);
+                                   result.sources.emplace_back(k, i);
+                                   for (std::size_t j = 0; j < y_size; j++)
+                                   {
+                                     result.values.push_back(rewr(smd.next_state[j], sigma));
+                                     assert(result.values.back() != data::undefined_data_expression());
+                                   }
+
+                                   if constexpr (ActionLabel)
+                                   {
+                                     result.actions.push_back(algorithm.rewrite_action(group.actions[i], rewr, sigma));
+                                   }
+                                   return false;
+                                 },
+                                 data::is_false
+            );
+          }
+          data::remove_assignments(sigma, smd.variables);
+          ++i;
+        }
+      }
+      data::remove_assignments(sigma, group.read_parameters);
+    }
+  );
+
+  std::size_t xy_size = x_size + y_size;
+  if constexpr (ActionLabel)
+  {
+    // One additional space for the action label.
+    xy_size += 1;
+  }
+
+  MCRL2_DECLARE_STACK_ARRAY(xy, std::uint32_t, xy_size);
+  for (const auto& result: results)
+  {
+    for (std::size_t k = 0; k < result.sources.size(); k++)
+    {
+      const auto& [x_index, i] = result.sources[k];
+      const std::vector<std::uint32_t>& x = xs[x_index];
+      const auto& smd = group.summands[i];
+      for (std::size_t j = 0; j < x_size; j++)
+      {
+        xy[group.read_pos[j]] = x[j];
+      }
+      for (std::size_t j = 0; j < y_size; j++)
+      {
+        // Determine whether this is a copy parameter, insert special value if that is the case.
+        xy[group.write_pos[j]] = smd.copy[group.write_pos[j]] ? relprod_ignore : data_index[group.write[j]].insert(result.values[k * y_size + j]).first;
+      }
+
+      if constexpr (ActionLabel)
+      {
+        // Action is always located on the last index of the cube.
+        xy[xy_size - 1] = algorithm.action_index().insert(result.actions[k]).first;
+      }
+
+      mCRL2log(log::trace) << "  " << print_transition(data_index, xy.data(), group.read, group.write) << std::endl;
+      group.L = options.no_relprod ? union_cube(group.L, xy.data(), xy_size) : union_cube_copy(group.L, xy.data(), smd.copy.data(), xy_size);
+    }
+  }
+
+  group.learn_calls += xs.size();
+  group.learn_time += learn_start.seconds();
+
+  if (options.cached)
+  {
+    for (const std::vector<std::uint32_t>& x: xs)
+    {
+      group.Ldomain = union_cube(group.Ldomain, x.data(), x_size);
+    }
+  }
+}
+
 } // namespace mcrl2::symbolic
 
 #endif // MCRL2_ENABLE_SYLVAN
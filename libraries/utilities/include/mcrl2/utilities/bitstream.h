@@ -10,8 +10,10 @@
 #ifndef MCRL2_UTILITIES_BITSTREAM_H
 #define MCRL2_UTILITIES_BITSTREAM_H
 
-#include <bitset>
 #include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
 #include <vector>
 
 namespace mcrl2::utilities
@@ -25,7 +27,9 @@ constexpr std::size_t integer_encoding_size()
 }
 
 /// \brief A bitstream provides per bit writing of data to any stream (including stdout).
-/// \details Internally uses bitpacking and buffering for compact and efficient IO.
+/// \details Internally uses bitpacking in 64-bit words and buffering for compact and efficient IO. Optionally, the
+///          bytes can be stored in blocks that are compressed by a lightweight LZ77 compressor, see
+///          enable_block_compression().
 class obitstream
 {
 public:
@@ -46,6 +50,11 @@ public:
   /// \details Uses most significant bit encoding.
   void write_integer(std::size_t value);
 
+  /// \brief All bits that are written after this call are stored in compressed blocks.
+  /// \details Must be called when the number of bits written so far is a multiple of eight. The corresponding
+  ///          ibitstream must call enable_block_compression() after reading the same bits.
+  void enable_block_compression();
+
 private:
   /// \brief Flush the remaining bits in the buffer to the output stream.
   /// \details Note that this aligns it to the next byte, e.g. when bits_in_buffer is 6 then two zero bits are added redundantly.
@@ -54,13 +63,27 @@ private:
   /// \brief Writes size bytes from the given buffer.
   void write(const std::uint8_t* buffer, std::size_t size);
 
+  /// \brief Writes the most significant bytes of the write buffer.
+  void write_buffer_bytes(unsigned int number_of_bytes);
+
+  /// \brief Writes size bytes to the output stream, or to the current block when compression is enabled.
+  void put_bytes(const std::uint8_t* buffer, std::size_t size);
+
+  /// \brief Writes the current block (which may be empty) as a frame to the output stream.
+  void write_block();
+
   std::ostream& stream;
 
-  /// \brief Buffer that is filled starting from bit 127 when writing
-  std::bitset<128> write_buffer = 0;
+  /// \brief Buffer that is filled starting from bit 63 when writing
+  std::uint64_t write_buffer = 0;
 
   unsigned int bits_in_buffer = 0; ///< how many bits in are used in the buffer.
 
+  bool m_compress = false;                  ///< whether the bytes are written in compressed blocks.
+  std::vector<std::uint8_t> m_block;        ///< the uncompressed contents of the current block.
+  std::vector<std::uint8_t> m_compressed;   ///< the compressed contents of the current block.
+  std::vector<std::uint32_t> m_hash_table;  ///< the positions of recently seen sequences of four bytes.
+
   std::uint8_t integer_buffer[integer_encoding_size<std::size_t>()]{}; ///< Reserved space to store an n byte integer. // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 };
 
@@ -83,17 +106,45 @@ public:
   /// \returns A natural number that was read from the binary stream encoded in most significant bit encoding.
   std::size_t read_integer();
 
+  /// \brief All bits that are read after this call are stored in compressed blocks, see obitstream::enable_block_compression().
+  void enable_block_compression();
+
 private:
   /// \brief Read size bytes into the provided buffer.
   void read(std::size_t size, std::uint8_t* buffer);
 
+  /// \returns The next byte of the input, which is taken from the current block when compression is enabled.
+  std::uint8_t get_byte()
+  {
+    if (m_compress)
+    {
+      if (m_block_position == m_block.size())
+      {
+        read_block();
+      }
+      return m_block[m_block_position++];
+    }
+    return get_stream_byte();
+  }
+
+  /// \returns The next byte of the input stream.
+  std::uint8_t get_stream_byte();
+
+  /// \brief Reads the next frame from the input stream and decompresses it into the current block.
+  void read_block();
+
   std::istream& stream;
 
-  /// \brief Buffer that is filled starting from bit 127 when reading.
-  std::bitset<128> read_buffer = 0;
+  /// \brief Buffer that is filled starting from bit 63 when reading.
+  std::uint64_t read_buffer = 0;
 
   unsigned int bits_in_buffer = 0; ///< how many bits in the buffer are used.
 
+  bool m_compress = false;                ///< whether the bytes are read from compressed blocks.
+  std::vector<std::uint8_t> m_block;      ///< the decompressed contents of the current block.
+  std::size_t m_block_position = 0;       ///< the position of the next byte in m_block.
+  std::vector<std::uint8_t> m_compressed; ///< the compressed contents of the current block.
+
   std::vector<char> m_text_buffer; ///< A temporary buffer to store char array strings.
 };
 
@@ -11,8 +11,12 @@
 #define MCRL2_UTILITIES_CACHE_POLICY_H
 
 #include <forward_list>
+#include <list>
+#include <unordered_map>
+#include <vector>
 
 #include <cassert>
+#include <cstdint>
 
 namespace mcrl2::utilities
 {
@@ -121,6 +125,143 @@ private:
   typename std::forward_list<key_type>::iterator m_last_element_it;
 };
 
+/// \brief A policy that replaces the least recently used element, i.e., the element that was
+///        inserted or found the longest time ago.
+/// \details The policy refers to the keys that are stored in the nodes of the map, which requires
+///          that the nodes of the map are not moved. As such the keys are not copied, which matters
+///          when the keys are terms that must only be protected by the map. A policy cannot be
+///          copied, as the keys would still refer to the original map.
+template<typename Map>
+class lru_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  lru_policy() = default;
+
+  lru_policy(const lru_policy& other) = delete;
+  lru_policy& operator=(const lru_policy& other) = delete;
+
+  // Moving a list keeps the iterators to its elements valid.
+  lru_policy(lru_policy&& other) noexcept = default;
+  lru_policy& operator=(lru_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_queue.clear();
+    m_positions.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_queue.empty());
+    // The least recently used key is at the front of the queue.
+    auto it = map.find(*m_queue.front());
+    m_positions.erase(m_queue.front());
+    m_queue.pop_front();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    m_positions[&key] = m_queue.insert(m_queue.end(), &key);
+  }
+
+  void touch(const key_type& key) override
+  {
+    // Move the key to the back of the queue, as it is the most recently used one.
+    auto it = m_positions.find(&key);
+    if (it != m_positions.end())
+    {
+      m_queue.splice(m_queue.end(), m_queue, it->second);
+    }
+  }
+
+private:
+  std::list<const key_type*> m_queue;
+  std::unordered_map<const key_type*, typename std::list<const key_type*>::iterator> m_positions;
+};
+
+/// \brief A policy that approximates lru_policy using the CLOCK algorithm. Every key has a counter that
+///        is set to one when it is found. The clock hand visits the keys in a circular fashion, and replaces
+///        the first key with a counter of zero, while decreasing the counters of the keys that it passes.
+/// \details With a MaximumCount larger than one the counter is incremented up to MaximumCount when a key
+///          is found, instead of being set to one. This is the generalised CLOCK algorithm, which favours
+///          keys that are found frequently and as such approximates a least frequently used policy.
+///          Like lru_policy, it refers to the keys in the nodes of the map and cannot be copied.
+template<typename Map, std::uint8_t MaximumCount = 1>
+class clock_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  clock_policy() = default;
+
+  clock_policy(const clock_policy& other) = delete;
+  clock_policy& operator=(const clock_policy& other) = delete;
+
+  clock_policy(clock_policy&& other) noexcept = default;
+  clock_policy& operator=(clock_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_keys.clear();
+    m_positions.clear();
+    m_hand = 0;
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_keys.empty());
+    while (m_keys[m_hand].second > 0)
+    {
+      --m_keys[m_hand].second;
+      m_hand = (m_hand + 1) % m_keys.size();
+    }
+
+    // Replace the key under the hand by the last key, such that the keys remain consecutive.
+    auto it = map.find(*m_keys[m_hand].first);
+    assert(it != map.end());
+    m_positions.erase(m_keys[m_hand].first);
+    if (m_hand + 1 != m_keys.size())
+    {
+      m_keys[m_hand] = m_keys.back();
+      m_positions[m_keys[m_hand].first] = m_hand;
+    }
+    m_keys.pop_back();
+    if (m_hand == m_keys.size())
+    {
+      m_hand = 0;
+    }
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    m_positions[&key] = m_keys.size();
+    m_keys.emplace_back(&key, 0);
+  }
+
+  void touch(const key_type& key) override
+  {
+    auto it = m_positions.find(&key);
+    if (it != m_positions.end() && m_keys[it->second].second < MaximumCount)
+    {
+      ++m_keys[it->second].second;
+    }
+  }
+
+private:
+  std::vector<std::pair<const key_type*, std::uint8_t>> m_keys;
+  std::unordered_map<const key_type*, std::size_t> m_positions;
+  std::size_t m_hand = 0;
+};
+
+/// \brief A frequency based policy, see clock_policy.
+template<typename Map>
+using frequency_policy = clock_policy<Map, 15>;
+
 } // namespace mcrl2::utilities
 
 #endif // MCRL2_UTILITIES_CACHE_POLICY_H
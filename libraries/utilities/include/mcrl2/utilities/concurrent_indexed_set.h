@@ -0,0 +1,512 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/concurrent_indexed_set.h
+/// \brief An indexed set in which elements can be looked up and inserted by multiple threads without locking.
+
+#ifndef MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+#define MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "mcrl2/utilities/indexed_set.h"
+
+namespace mcrl2::utilities
+{
+
+namespace detail
+{
+
+/// \brief In the hashtable of a concurrent_indexed_set this bit marks an index that has been copied to the next table.
+static constexpr std::size_t MOVED_BIT = static_cast<std::size_t>(1) << (std::numeric_limits<std::size_t>::digits - 1);
+
+/// \brief Marks an empty position in the hashtable of a concurrent_indexed_set that can no longer be used.
+static constexpr std::size_t MOVED_EMPTY = std::numeric_limits<std::size_t>::max() - 2;
+
+/// \brief The number of positions of a hashtable that a thread copies in one go when the hashtable grows.
+static constexpr std::size_t migration_chunk_size = 1024;
+
+/// \brief The number of keys in the first segment of the keys of a concurrent_indexed_set.
+static constexpr std::size_t first_segment_size = minimal_hashtable_size;
+
+} // namespace detail
+
+/// \brief A set that assigns each element a unique index, and that can be used by multiple threads.
+/// \details The interface is the same as that of indexed_set. Lookups and insertions do not use locks.
+///          Only when another thread has claimed a position in the hashtable, but did not yet store the index
+///          of its key, a thread waits for a (very) short time.
+///
+///          The keys are stored in segments that double in size, such that a stored key is never moved. When the
+///          hashtable becomes too full, a table of twice the size is created, and all threads that want to insert
+///          an element help to copy the indices to the new table in chunks. An index that has been copied remains
+///          readable in the old table, so lookups never wait for this. The old tables are kept until the set is
+///          cleared or destroyed; their total size is less than the size of the current table.
+///
+///          Indices are handed out consecutively, also when multiple threads are used.
+/// \tparam Element The type in which keys are stored. It must be constructible from a key and convertible to a
+///         const reference to a key.
+template<typename Key,
+         typename Hash = std::hash<Key>,
+         typename Equals = std::equal_to<Key>,
+         typename Element = Key>
+class concurrent_indexed_set
+{
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+  using key_equal = Equals;
+  using hasher = Hash;
+  using difference_type = std::ptrdiff_t;
+
+  /// \brief Value returned when an element does not exist in the set.
+  static constexpr size_type npos = std::numeric_limits<std::size_t>::max();
+
+  /// \brief An iterator over the keys, in the order of their indices.
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    const_iterator() = default;
+
+    const_iterator(const concurrent_indexed_set* set, std::size_t index)
+      : m_set(set), m_index(index)
+    {}
+
+    reference operator*() const { return (*m_set)[m_index]; }
+    pointer operator->() const { return &(*m_set)[m_index]; }
+    reference operator[](difference_type n) const { return (*m_set)[m_index + n]; }
+
+    const_iterator& operator++() { ++m_index; return *this; }
+    const_iterator operator++(int) { const_iterator result = *this; ++m_index; return result; }
+    const_iterator& operator--() { --m_index; return *this; }
+    const_iterator operator--(int) { const_iterator result = *this; --m_index; return result; }
+
+    const_iterator& operator+=(difference_type n) { m_index += n; return *this; }
+    const_iterator& operator-=(difference_type n) { m_index -= n; return *this; }
+    const_iterator operator+(difference_type n) const { return const_iterator(m_set, m_index + n); }
+    const_iterator operator-(difference_type n) const { return const_iterator(m_set, m_index - n); }
+    difference_type operator-(const const_iterator& other) const { return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index); }
+
+    bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+    bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+    bool operator<(const const_iterator& other) const { return m_index < other.m_index; }
+    bool operator<=(const const_iterator& other) const { return m_index <= other.m_index; }
+    bool operator>(const const_iterator& other) const { return m_index > other.m_index; }
+    bool operator>=(const const_iterator& other) const { return m_index >= other.m_index; }
+
+  private:
+    const concurrent_indexed_set* m_set = nullptr;
+    std::size_t m_index = 0;
+  };
+
+  // The keys cannot be changed, so the iterators are always constant.
+  using iterator = const_iterator;
+  using reverse_iterator = std::reverse_iterator<const_iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+  /// \brief A hashtable that contains the indices of the keys. The size is a power of two.
+  struct hashtable
+  {
+    std::size_t size;
+    std::unique_ptr<std::atomic<std::size_t>[]> positions;
+
+    // The fields below are used when the table is copied to a larger one.
+    std::atomic<hashtable*> next = nullptr;
+    std::unique_ptr<hashtable> next_owner;
+    std::atomic<std::size_t> next_chunk = 0;
+    std::atomic<std::size_t> finished_chunks = 0;
+
+    explicit hashtable(std::size_t size_)
+      : size(size_),
+        positions(new std::atomic<std::size_t>[size_])
+    {
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        positions[i].store(detail::EMPTY, std::memory_order_relaxed);
+      }
+    }
+
+    std::size_t number_of_chunks() const
+    {
+      return (size + detail::migration_chunk_size - 1) / detail::migration_chunk_size;
+    }
+  };
+
+  // Segment i contains first_segment_size * 2^i keys.
+  static constexpr std::size_t number_of_segments = std::numeric_limits<std::size_t>::digits - std::bit_width(detail::first_segment_size);
+
+  std::array<std::atomic<Element*>, number_of_segments> m_segments;
+  std::unique_ptr<hashtable> m_first_table;
+  std::atomic<hashtable*> m_table;
+  std::atomic<std::size_t> m_next_index = 0;
+  std::size_t m_initial_size;
+
+  Hash m_hasher;
+  Equals m_equals;
+
+  static std::size_t segment_of(std::size_t index)
+  {
+    return std::bit_width(index / detail::first_segment_size + 1) - 1;
+  }
+
+  static std::size_t segment_begin(std::size_t segment)
+  {
+    return detail::first_segment_size * ((static_cast<std::size_t>(1) << segment) - 1);
+  }
+
+  /// \brief Returns the place where the key with the given index is stored, and allocates it if necessary.
+  Element& element(std::size_t index)
+  {
+    const std::size_t segment = segment_of(index);
+    Element* keys = m_segments[segment].load(std::memory_order_acquire);
+    if (keys == nullptr)
+    {
+      Element* new_keys = new Element[detail::first_segment_size << segment]();
+      if (m_segments[segment].compare_exchange_strong(keys, new_keys, std::memory_order_acq_rel))
+      {
+        keys = new_keys;
+      }
+      else
+      {
+        delete[] new_keys; // Another thread allocated this segment first.
+      }
+    }
+    return keys[index - segment_begin(segment)];
+  }
+
+  const Element& element(std::size_t index) const
+  {
+    const std::size_t segment = segment_of(index);
+    const Element* keys = m_segments[segment].load(std::memory_order_acquire);
+    assert(keys != nullptr);
+    return keys[index - segment_begin(segment)];
+  }
+
+  std::size_t start_position(std::size_t hash, const hashtable& table) const
+  {
+    return ((hash * detail::PRIME_NUMBER) >> 2) & (table.size - 1);
+  }
+
+  /// \brief Waits until another thread has stored an index at a reserved position, and returns it.
+  static std::size_t wait_while_reserved(const std::atomic<std::size_t>& position)
+  {
+    std::size_t value = position.load(std::memory_order_acquire);
+    while (value == detail::RESERVED)
+    {
+      std::this_thread::yield();
+      value = position.load(std::memory_order_acquire);
+    }
+    return value;
+  }
+
+  /// \brief Copies the given positions of table to the next table.
+  void migrate(hashtable& table, std::size_t first, std::size_t last)
+  {
+    hashtable& next = *table.next.load(std::memory_order_acquire);
+    for (std::size_t i = first; i < last; ++i)
+    {
+      std::size_t value = detail::EMPTY;
+      // An empty position is closed, such that no key can be inserted at it anymore.
+      if (!table.positions[i].compare_exchange_strong(value, detail::MOVED_EMPTY, std::memory_order_acq_rel))
+      {
+        value = wait_while_reserved(table.positions[i]);
+        assert(value != detail::EMPTY && value != detail::MOVED_EMPTY && (value & detail::MOVED_BIT) == 0);
+
+        // The indices in table are unique, so they can be put in the first free position of the next table.
+        std::size_t position = start_position(m_hasher(static_cast<const Key&>(element(value))), next);
+        std::size_t expected = detail::EMPTY;
+        while (!next.positions[position].compare_exchange_strong(expected, value, std::memory_order_acq_rel))
+        {
+          position = (position + detail::STEP) & (next.size - 1);
+          expected = detail::EMPTY;
+        }
+        table.positions[i].store(value | detail::MOVED_BIT, std::memory_order_release);
+      }
+    }
+  }
+
+  /// \brief Creates a table that is twice as large as the given table, and helps to copy the indices to it.
+  /// \details Returns when all indices have been copied, and the new table is the current table.
+  void grow(hashtable& table)
+  {
+    hashtable* next = table.next.load(std::memory_order_acquire);
+    if (next == nullptr)
+    {
+      std::unique_ptr<hashtable> new_table = std::make_unique<hashtable>(2 * table.size);
+      if (table.next.compare_exchange_strong(next, new_table.get(), std::memory_order_acq_rel))
+      {
+        next = new_table.get();
+        table.next_owner = std::move(new_table);
+      }
+    }
+
+    const std::size_t number_of_chunks = table.number_of_chunks();
+    for (std::size_t chunk = table.next_chunk.fetch_add(1); chunk < number_of_chunks; chunk = table.next_chunk.fetch_add(1))
+    {
+      migrate(table, chunk * detail::migration_chunk_size, std::min((chunk + 1) * detail::migration_chunk_size, table.size));
+      table.finished_chunks.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    // Wait for the other threads that are copying a chunk.
+    while (table.finished_chunks.load(std::memory_order_acquire) < number_of_chunks)
+    {
+      std::this_thread::yield();
+    }
+
+    hashtable* expected = &table;
+    m_table.compare_exchange_strong(expected, next, std::memory_order_acq_rel);
+  }
+
+  void initialise()
+  {
+    for (std::atomic<Element*>& segment: m_segments)
+    {
+      segment.store(nullptr, std::memory_order_relaxed);
+    }
+    m_first_table = std::make_unique<hashtable>(m_initial_size);
+    m_table.store(m_first_table.get());
+    m_next_index.store(0);
+  }
+
+  void release_segments()
+  {
+    for (std::atomic<Element*>& segment: m_segments)
+    {
+      delete[] segment.load(std::memory_order_relaxed);
+      segment.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+public:
+  /// \brief Constructor of an empty indexed set.
+  concurrent_indexed_set()
+    : concurrent_indexed_set(1, detail::minimal_hashtable_size)
+  {}
+
+  /// \brief Constructor of an empty indexed set.
+  /// \param number_of_threads The number of threads that use this set. It is only present for compatibility
+  ///        with indexed_set, as any number of threads can use this set.
+  explicit concurrent_indexed_set(std::size_t number_of_threads)
+    : concurrent_indexed_set(number_of_threads, detail::minimal_hashtable_size)
+  {}
+
+  /// \brief Constructor of an empty indexed set with a hashtable of at least the indicated size.
+  concurrent_indexed_set(std::size_t /* number_of_threads */,
+                         std::size_t initial_hashtable_size,
+                         const hasher& hash = hasher(),
+                         const key_equal& equals = key_equal())
+    : m_initial_size(std::bit_ceil(std::max(initial_hashtable_size, detail::minimal_hashtable_size))),
+      m_hasher(hash),
+      m_equals(equals)
+  {
+    initialise();
+  }
+
+  /// \brief Copy constructor. The elements get the same indices as in other.
+  /// \details Not threadsafe.
+  concurrent_indexed_set(const concurrent_indexed_set& other)
+    : m_initial_size(other.m_initial_size),
+      m_hasher(other.m_hasher),
+      m_equals(other.m_equals)
+  {
+    initialise();
+    for (const Key& key: other)
+    {
+      insert(key);
+    }
+  }
+
+  /// \brief Copy assignment. The elements get the same indices as in other.
+  /// \details Not threadsafe.
+  concurrent_indexed_set& operator=(const concurrent_indexed_set& other)
+  {
+    if (this != &other)
+    {
+      clear();
+      for (const Key& key: other)
+      {
+        insert(key);
+      }
+    }
+    return *this;
+  }
+
+  ~concurrent_indexed_set()
+  {
+    release_segments();
+  }
+
+  /// \brief Returns the index of the key, or npos if the key does not occur in the set.
+  /// \details threadsafe
+  size_type index(const key_type& key, std::size_t /* thread_index */ = 0) const
+  {
+    const std::size_t hash = m_hasher(key);
+    const hashtable* table = m_table.load(std::memory_order_acquire);
+    std::size_t start = start_position(hash, *table);
+    std::size_t position = start;
+    while (true)
+    {
+      const std::size_t value = wait_while_reserved(table->positions[position]);
+      if (value == detail::EMPTY)
+      {
+        return npos;
+      }
+      if (value == detail::MOVED_EMPTY)
+      {
+        // The key, if present, has been inserted after the indices were copied to the next table.
+        table = table->next.load(std::memory_order_acquire);
+        start = start_position(hash, *table);
+        position = start;
+        continue;
+      }
+
+      const std::size_t index = value & ~detail::MOVED_BIT;
+      if (m_equals(static_cast<const Key&>(element(index)), key))
+      {
+        return index;
+      }
+
+      position = (position + detail::STEP) & (table->size - 1);
+      if (position == start)
+      {
+        return npos; // Every position is occupied by another key.
+      }
+    }
+  }
+
+  /// \brief Returns the key at the given index.
+  /// \details Throws an out_of_range exception if there is no element with the given index.
+  const key_type& at(size_type index) const
+  {
+    if (index >= size())
+    {
+      throw std::out_of_range("concurrent_indexed_set: index too large: " + std::to_string(index) + " >= " + std::to_string(size()) + ".");
+    }
+    return element(index);
+  }
+
+  /// \brief Returns the key at the given index.
+  /// \details threadsafe
+  const key_type& operator[](size_type index) const
+  {
+    assert(index < size());
+    return element(index);
+  }
+
+  const_iterator begin(std::size_t /* thread_index */ = 0) const { return const_iterator(this, 0); }
+  const_iterator end(std::size_t /* thread_index */ = 0) const { return const_iterator(this, size()); }
+  const_iterator cbegin(std::size_t /* thread_index */ = 0) const { return begin(); }
+  const_iterator cend(std::size_t /* thread_index */ = 0) const { return end(); }
+  const_reverse_iterator rbegin(std::size_t /* thread_index */ = 0) const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend(std::size_t /* thread_index */ = 0) const { return const_reverse_iterator(begin()); }
+  const_reverse_iterator crbegin(std::size_t /* thread_index */ = 0) const { return rbegin(); }
+  const_reverse_iterator crend(std::size_t /* thread_index */ = 0) const { return rend(); }
+
+  /// \brief Removes all elements from the set.
+  /// \details Not threadsafe.
+  void clear(std::size_t /* thread_index */ = 0)
+  {
+    release_segments();
+    initialise();
+  }
+
+  /// \brief Inserts a key in the indexed set and returns its index.
+  /// \details If the element was already in the set, the resulting bool is false, and the existing index is returned.
+  ///          Otherwise, the key is inserted, gets the next available index, and the resulting bool is true.
+  ///          threadsafe
+  std::pair<size_type, bool> insert(const key_type& key, std::size_t /* thread_index */ = 0)
+  {
+    const std::size_t hash = m_hasher(key);
+    while (true)
+    {
+      hashtable* table = m_table.load(std::memory_order_acquire);
+      if (m_next_index.load(std::memory_order_relaxed) >= detail::max_load_factor * table->size)
+      {
+        grow(*table);
+        continue;
+      }
+
+      const std::size_t start = start_position(hash, *table);
+      std::size_t position = start;
+      while (true)
+      {
+        std::size_t value = detail::EMPTY;
+        if (table->positions[position].compare_exchange_strong(value, detail::RESERVED, std::memory_order_acq_rel))
+        {
+          // The key is new. Its index is only published after the key has been stored.
+          const std::size_t index = m_next_index.fetch_add(1);
+          element(index) = key;
+          table->positions[position].store(index, std::memory_order_release);
+          return std::make_pair(index, true);
+        }
+
+        if (value == detail::RESERVED)
+        {
+          value = wait_while_reserved(table->positions[position]);
+        }
+
+        if (value == detail::MOVED_EMPTY)
+        {
+          // The table is being copied. Help to finish this before inserting the key in the new table.
+          grow(*table);
+          break;
+        }
+
+        const std::size_t index = value & ~detail::MOVED_BIT;
+        if (m_equals(static_cast<const Key&>(element(index)), key))
+        {
+          return std::make_pair(index, false);
+        }
+
+        position = (position + detail::STEP) & (table->size - 1);
+        if (position == start)
+        {
+          // This can only happen with a small table and many threads inserting at the same time.
+          grow(*table);
+          break;
+        }
+      }
+    }
+  }
+
+  /// \brief Provides an iterator to the stored key in the indexed set, or end() if the key does not occur.
+  const_iterator find(const key_type& key, std::size_t thread_index = 0) const
+  {
+    const std::size_t idx = index(key, thread_index);
+    if (idx == npos)
+    {
+      return end();
+    }
+    return begin() + idx;
+  }
+
+  /// \brief The number of elements in the indexed set.
+  /// \details threadsafe. While other threads insert elements, the keys with the highest indices may not be stored yet.
+  size_type size(std::size_t /* thread_index */ = 0) const
+  {
+    return m_next_index.load(std::memory_order_acquire);
+  }
+};
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_CONCURRENT_INDEXED_SET_H
@@ -0,0 +1,225 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/parallel_for.h
+/// \brief A simple parallel loop over a range of indices, and a pool of threads that executes such loops repeatedly.
+
+#ifndef MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
+#define MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
+
+#include "mcrl2/utilities/noncopyable.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcrl2::utilities::detail
+{
+
+/// \brief Splits [0, n) into at most number_of_threads consecutive ranges and calls f(begin, end) for
+///        each of them on a separate thread.
+/// \details The first range is handled by the calling thread. If a call to f throws, the first exception
+///          is rethrown after all threads have finished. With a single thread f(0, n) is called directly.
+template <typename Function>
+void parallel_for(const std::size_t n, std::size_t number_of_threads, const Function& f)
+{
+  number_of_threads = std::max<std::size_t>(1, std::min(number_of_threads, n));
+  if (number_of_threads == 1)
+  {
+    f(0, n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> exceptions(number_of_threads);
+  auto run = [&](std::size_t i)
+  {
+    try
+    {
+      f(i * n / number_of_threads, (i + 1) * n / number_of_threads);
+    }
+    catch (...)
+    {
+      exceptions[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads - 1);
+  for (std::size_t i = 1; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(run, i);
+  }
+  run(0);
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const std::exception_ptr& exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+/// \brief A fixed set of threads that executes parallel loops like parallel_for, for algorithms that execute
+///        many loops after each other, such that the threads are not started for every loop.
+/// \details The helper threads are created by the constructor and wait for a loop in between. The first range of
+///          every loop is handled by the calling thread. Loops must not be executed by multiple threads at the
+///          same time.
+class parallel_for_pool : private mcrl2::utilities::noncopyable
+{
+public:
+  /// \brief Creates number_of_threads - 1 helper threads.
+  explicit parallel_for_pool(const std::size_t number_of_threads)
+    : m_exceptions(std::max<std::size_t>(1, number_of_threads))
+  {
+    for (std::size_t i = 1; i < number_of_threads; ++i)
+    {
+      m_threads.emplace_back([this, i]() { run(i); });
+    }
+  }
+
+  ~parallel_for_pool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_work_available.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  /// \returns The number of threads that execute a loop, including the calling thread.
+  std::size_t number_of_threads() const
+  {
+    return m_threads.size() + 1;
+  }
+
+  /// \brief Splits [0, n) into at most number_of_ranges consecutive ranges and calls f(begin, end) for each of
+  ///        them, as parallel_for(n, number_of_ranges, f), where number_of_ranges is bounded by the number of
+  ///        threads of the pool.
+  template <typename Function>
+  void parallel_for(const std::size_t n, std::size_t number_of_ranges, const Function& f)
+  {
+    number_of_ranges = std::max<std::size_t>(1, std::min({number_of_ranges, n, number_of_threads()}));
+    if (number_of_ranges == 1)
+    {
+      f(0, n);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_task = [&, n, number_of_ranges](const std::size_t i)
+      {
+        f(i * n / number_of_ranges, (i + 1) * n / number_of_ranges);
+      };
+      m_number_of_ranges = number_of_ranges;
+      m_unfinished_ranges = number_of_ranges - 1;
+      ++m_loop;
+    }
+    m_work_available.notify_all();
+
+    execute(0);
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_work_done.wait(lock, [this]() { return m_unfinished_ranges == 0; });
+      m_task = nullptr;
+    }
+
+    for (std::exception_ptr& exception : m_exceptions)
+    {
+      if (exception)
+      {
+        std::exception_ptr first = exception;
+        std::fill(m_exceptions.begin(), m_exceptions.end(), nullptr);
+        std::rethrow_exception(first);
+      }
+    }
+  }
+
+  /// \brief Splits [0, n) into ranges for all threads of the pool, see parallel_for(n, number_of_ranges, f).
+  template <typename Function>
+  void parallel_for(const std::size_t n, const Function& f)
+  {
+    parallel_for(n, number_of_threads(), f);
+  }
+
+private:
+  /// \brief Executes the i-th range of the current loop and stores the exception that it throws.
+  void execute(const std::size_t i)
+  {
+    try
+    {
+      m_task(i);
+    }
+    catch (...)
+    {
+      m_exceptions[i] = std::current_exception();
+    }
+  }
+
+  /// \brief Waits for loops with more than i ranges and executes their i-th range.
+  void run(const std::size_t i)
+  {
+    std::size_t loop = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+      m_work_available.wait(lock, [&]() { return m_stop || m_loop != loop; });
+      if (m_stop)
+      {
+        return;
+      }
+      loop = m_loop;
+
+      if (i < m_number_of_ranges)
+      {
+        lock.unlock();
+        execute(i);
+        lock.lock();
+
+        if (--m_unfinished_ranges == 0)
+        {
+          m_work_done.notify_one();
+        }
+      }
+    }
+  }
+
+  std::vector<std::thread> m_threads;
+  std::vector<std::exception_ptr> m_exceptions; ///< The exception thrown by each range of the current loop.
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+
+  std::function<void(std::size_t)> m_task;   ///< Executes a range of the current loop.
+  std::size_t m_number_of_ranges = 0;        ///< The number of ranges of the current loop.
+  std::size_t m_unfinished_ranges = 0;       ///< The ranges of the current loop that helper threads have not finished.
+  std::size_t m_loop = 0;                    ///< The number of loops that have been started.
+  bool m_stop = false;
+};
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_PARALLEL_FOR_H
@@ -0,0 +1,172 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/parallel_ordered_for.h
+/// \brief A parallel loop over a range of indices of which the results are consumed in order.
+
+#ifndef MCRL2_UTILITIES_DETAIL_PARALLEL_ORDERED_FOR_H
+#define MCRL2_UTILITIES_DETAIL_PARALLEL_ORDERED_FOR_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "mcrl2/utilities/configuration.h"
+
+namespace mcrl2::utilities::detail
+{
+
+/// \brief Calls process(state, i, result) for every i in [0, n) using number_of_threads threads, and
+///        consume(i, result) by the calling thread for every i in increasing order.
+/// \details Every thread creates its own state using make_state. A result is consumed as soon as the results
+///          of all smaller indices have been consumed, and at most window results are processed ahead of the
+///          results that have been consumed, which bounds the memory in use. Every result is destroyed by the
+///          thread that created it, after it has been consumed, as terms must be destroyed by the thread that
+///          created them. With a single thread, process and consume are called alternately by the calling thread.
+///          If one of the calls throws, no further results are consumed and the first exception is rethrown
+///          after all threads have finished.
+template <typename Result, typename MakeState, typename Process, typename Consume>
+void parallel_ordered_for(std::size_t n,
+                          std::size_t number_of_threads,
+                          std::size_t window,
+                          MakeState make_state,
+                          Process process,
+                          Consume consume)
+{
+  if constexpr (!GlobalThreadSafe)
+  {
+    number_of_threads = 1;
+  }
+  if (number_of_threads <= 1 || n <= 1)
+  {
+    auto state = make_state();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      Result result;
+      process(state, i, result);
+      consume(i, result);
+    }
+    return;
+  }
+
+  number_of_threads = std::min(number_of_threads, n);
+  window = std::max(window, number_of_threads);
+
+  std::mutex mutex;
+  std::condition_variable produced;
+  std::condition_variable consumed;
+  std::vector<Result*> results(n, nullptr);
+  std::size_t next = 0;             // The next index that is processed.
+  std::size_t number_consumed = 0;  // The results [0, number_consumed) have been consumed.
+  bool stop = false;                // Set when one of the calls has thrown.
+  std::exception_ptr exception;
+
+  auto fail = [&]()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (exception == nullptr)
+    {
+      exception = std::current_exception();
+    }
+    stop = true;
+    produced.notify_all();
+    consumed.notify_all();
+  };
+
+  auto worker = [&]()
+  {
+    // The results of this thread in increasing order of their index, which are destroyed after being consumed.
+    std::deque<std::pair<std::size_t, Result>> local_results;
+    try
+    {
+      auto state = make_state();
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true)
+      {
+        consumed.wait(lock, [&]() { return stop || next >= n || next < number_consumed + window; });
+        if (stop || next >= n)
+        {
+          break;
+        }
+        const std::size_t i = next++;
+        const std::size_t first_unconsumed = number_consumed;
+        lock.unlock();
+
+        while (!local_results.empty() && local_results.front().first < first_unconsumed)
+        {
+          local_results.pop_front();
+        }
+        Result& result = local_results.emplace_back(i, Result()).second;
+        process(state, i, result);
+
+        lock.lock();
+        results[i] = &result;
+        produced.notify_all();
+      }
+
+      // The remaining results of this thread must be consumed before they can be destroyed.
+      consumed.wait(lock, [&]() { return stop || number_consumed == n; });
+    }
+    catch (...)
+    {
+      fail();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t i = 0; i < number_of_threads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+
+  try
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      Result* result;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        produced.wait(lock, [&]() { return stop || results[i] != nullptr; });
+        if (stop)
+        {
+          break;
+        }
+        result = results[i];
+      }
+
+      consume(i, *result);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      number_consumed = i + 1;
+      consumed.notify_all();
+    }
+  }
+  catch (...)
+  {
+    fail();
+  }
+
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_PARALLEL_ORDERED_FOR_H
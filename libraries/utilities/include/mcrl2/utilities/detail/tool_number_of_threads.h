@@ -0,0 +1,28 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/tool_number_of_threads.h
+/// \brief The number of threads of the running tool, for libraries that do work on behalf of the whole tool.
+
+#ifndef MCRL2_UTILITIES_DETAIL_TOOL_NUMBER_OF_THREADS_H
+#define MCRL2_UTILITIES_DETAIL_TOOL_NUMBER_OF_THREADS_H
+
+#include <cstddef>
+
+namespace mcrl2::utilities::detail
+{
+
+/// \brief Sets the number of threads of the running tool. A parallel tool sets it to the value of its --threads option.
+void set_tool_number_of_threads(std::size_t number_of_threads);
+
+/// \brief Returns the number of threads of the running tool, which is one unless it has been set.
+std::size_t tool_number_of_threads();
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_TOOL_NUMBER_OF_THREADS_H
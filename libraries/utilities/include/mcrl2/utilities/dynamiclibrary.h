@@ -142,6 +142,11 @@ class dynamic_library
       }
     }
   
+    const std::string& filename() const
+    {
+      return m_filename;
+    }
+
     library_proc proc_address(const std::string& name) 
     {
       if (m_library == nullptr)
@@ -43,6 +43,39 @@ public:
     }
   }
 
+  /// \brief The policy of a copy is informed of the copied elements, as a policy may refer to the
+  ///        elements of its own map.
+  fixed_size_cache(const fixed_size_cache& other)
+    : m_map(other.m_map),
+      m_maximum_size(other.m_maximum_size),
+      m_hits(other.m_hits),
+      m_misses(other.m_misses),
+      m_evictions(other.m_evictions)
+  {
+    inform_policy();
+  }
+
+  fixed_size_cache& operator=(const fixed_size_cache& other)
+  {
+    if (this != &other)
+    {
+      m_map = other.m_map;
+      m_maximum_size = other.m_maximum_size;
+      m_hits = other.m_hits;
+      m_misses = other.m_misses;
+      m_evictions = other.m_evictions;
+      inform_policy();
+    }
+    return *this;
+  }
+
+  // Moving the map does not move its elements.
+  fixed_size_cache(fixed_size_cache&& other) noexcept = default;
+  fixed_size_cache& operator=(fixed_size_cache&& other) noexcept = default;
+
+  iterator begin() { return m_map.begin(); }
+  iterator end() { return m_map.end(); }
+
   const_iterator begin() const { return m_map.begin(); }
   const_iterator end() const { return m_map.end(); }
 
@@ -50,9 +83,35 @@ public:
 
   std::size_t count(const key_type& key) const { return m_map.count(key); }
 
-  iterator find(const key_type& key)
+  /// \returns The number of elements in the cache.
+  std::size_t size() const { return m_map.size(); }
+
+  /// \returns The number of times that find located an element.
+  std::size_t hits() const { return m_hits; }
+
+  /// \returns The number of times that find did not locate an element.
+  std::size_t misses() const { return m_misses; }
+
+  /// \returns The number of elements that were removed to make room for a new element.
+  std::size_t evictions() const { return m_evictions; }
+
+  /// \brief Finds the element with the given key, and informs the policy when it is found.
+  /// \details The arguments are passed to the find of the underlying map, which allows
+  ///          to search with a key of another type than key_type.
+  template<typename ...Args>
+  iterator find(const Args&... args)
   {
-    return m_map.find(key);
+    auto result = m_map.find(args...);
+    if (result == m_map.end())
+    {
+      ++m_misses;
+    }
+    else
+    {
+      ++m_hits;
+      m_policy.touch((*result).first);
+    }
+    return result;
   }
 
   /// \brief Stores the given key-value pair in the cache. Depending on the cache policy and capacity an existing element
@@ -63,7 +122,7 @@ public:
     // The reason to split the find and emplace is that when we insert an element the replacement_candidate should not be
     // the key that we just inserted. The other way around, when an element that we are looking for was first removed and
     // then searched for also leads to unnecessary inserts.
-    auto result = find(args...);
+    auto result = m_map.find(args...);
     if (result == m_map.end())
     {
       // If the cache would be full after an inserted.
@@ -71,6 +130,7 @@ public:
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
+        ++m_evictions;
       }
 
       // Insert an element and inform the policy that an element was inserted.
@@ -84,10 +144,24 @@ public:
   }
 
 protected:
+  /// \brief Informs a cleared policy of all elements in the map, in an arbitrary order.
+  void inform_policy()
+  {
+    m_policy.clear();
+    for (auto& element : m_map)
+    {
+      m_policy.inserted(element.first);
+    }
+  }
+
   typename Policy::map_type m_map;    ///< The underlying mapping from keys to their cached results.
   Policy                    m_policy; ///< The replacement policy for keys in the cache.
 
   std::size_t m_maximum_size; ///< The maximum number of elements to cache.
+
+  std::size_t m_hits = 0;      ///< The number of successful calls to find.
+  std::size_t m_misses = 0;    ///< The number of unsuccessful calls to find.
+  std::size_t m_evictions = 0; ///< The number of elements removed by the policy.
 };
 
 /// \brief A cache keeps track of key-value pairs similar to a map. The difference is that a cache
@@ -102,6 +176,7 @@ private:
   using super::m_map;
   using super::m_maximum_size;
   using super::m_policy;
+  using super::m_evictions;
   using super::find;
 
 public:
@@ -125,6 +200,7 @@ public:
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
+        ++m_evictions;
       }
 
       // Insert an element and inform the policy that an element was inserted.
@@ -146,6 +222,15 @@ private:
 template<typename Key, typename T>
 using fifo_cache = fixed_size_cache<fifo_policy<mcrl2::utilities::unordered_map<Key, T>>>;
 
+template<typename Key, typename T>
+using lru_cache = fixed_size_cache<lru_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using clock_cache = fixed_size_cache<clock_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using frequency_cache = fixed_size_cache<frequency_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
 template<typename F, typename Args>
 using fifo_function_cache = function_cache<
   fifo_policy<mcrl2::utilities::unordered_map<Args, decltype(std::declval<F>()(std::declval<Args>()))>>,
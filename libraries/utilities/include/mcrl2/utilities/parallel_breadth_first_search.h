@@ -0,0 +1,76 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/parallel_breadth_first_search.h
+/// \brief A breadth first search that processes large layers with multiple threads.
+
+#ifndef MCRL2_UTILITIES_PARALLEL_BREADTH_FIRST_SEARCH_H
+#define MCRL2_UTILITIES_PARALLEL_BREADTH_FIRST_SEARCH_H
+
+#include "mcrl2/utilities/detail/parallel_for.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace mcrl2::utilities {
+
+/// \brief Processes the elements of todo in breadth first order.
+/// \details Every element u of todo is passed to expand(u, next), which appends the elements discovered from u to
+///          next. The search is done layer by layer. A layer with at least parallel_threshold elements is divided
+///          over the threads of pool. Each thread appends to its own vector, and these are appended to todo
+///          in the order of the threads. Smaller layers are processed by the calling thread, with next equal to
+///          todo. If the pool has more than one thread, expand must be safe to call concurrently.
+/// \param todo On entry the initial layer, and on exit all elements that were discovered in breadth first order.
+/// \param pool The threads that process the large layers, which are reused for every layer.
+template <typename T, typename Expand>
+void parallel_breadth_first_search(std::vector<T>& todo,
+                                   detail::parallel_for_pool& pool,
+                                   Expand expand,
+                                   std::size_t parallel_threshold = 4096)
+{
+  const std::size_t number_of_threads = pool.number_of_threads();
+  std::vector<std::vector<T>> next(number_of_threads);
+  std::size_t begin = 0;
+  while (begin < todo.size())
+  {
+    std::size_t end = todo.size();
+    if (number_of_threads <= 1 || end - begin < parallel_threshold)
+    {
+      for (; begin < end; ++begin)
+      {
+        // The element is copied, because expand may reallocate todo.
+        T u = todo[begin];
+        expand(u, todo);
+      }
+      continue;
+    }
+
+    // The i-th range of the loop over the threads handles the i-th chunk of the layer.
+    std::size_t chunk = (end - begin + number_of_threads - 1) / number_of_threads;
+    pool.parallel_for(number_of_threads, [&](std::size_t thread_index, std::size_t)
+    {
+      std::size_t first = std::min(end, begin + thread_index * chunk);
+      std::size_t last = std::min(end, first + chunk);
+      for (std::size_t i = first; i < last; ++i)
+      {
+        expand(todo[i], next[thread_index]);
+      }
+    });
+
+    for (std::vector<T>& v: next)
+    {
+      todo.insert(todo.end(), v.begin(), v.end());
+      v.clear();
+    }
+    begin = end;
+  }
+}
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_PARALLEL_BREADTH_FIRST_SEARCH_H
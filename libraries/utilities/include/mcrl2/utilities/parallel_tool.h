@@ -14,6 +14,7 @@
 
 #include "mcrl2/utilities/configuration.h"
 #include "mcrl2/utilities/command_line_interface.h"
+#include "mcrl2/utilities/detail/tool_number_of_threads.h"
 
 namespace mcrl2::utilities::tools
 {
@@ -62,6 +63,7 @@ class parallel_tool: public Tool
                                      ") can only be 1.");
         }
       }
+      utilities::detail::set_tool_number_of_threads(m_number_of_threads);
     }
 
   public:
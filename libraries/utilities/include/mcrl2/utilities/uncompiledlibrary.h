@@ -40,6 +40,7 @@
 
 #include <array>
 #include <cerrno>
+#include <filesystem>
 #include <list>
 #include "mcrl2/utilities/dynamiclibrary.h"
 #include "mcrl2/utilities/file_utility.h"
@@ -119,6 +120,23 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Use a library that has been compiled before instead of compiling a source file.
+    /// \details The library is copied to the temporary file copy, which is loaded, such that every user of the
+    ///          library has its own instance of it, with its own static variables.
+    /// \returns True iff the library could be copied.
+    bool use_compiled(const std::string& filename, const std::string& copy)
+    {
+      std::error_code error;
+      std::filesystem::copy_file(filename, copy, std::filesystem::copy_options::overwrite_existing, error);
+      if (error)
+      {
+        return false;
+      }
+      m_tempfiles.push_back(copy);
+      m_filename = copy;
+      return true;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
@@ -14,6 +14,9 @@
 #include "mcrl2/utilities/power_of_two.h"
 #include "mcrl2/utilities/platform.h"
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef MCRL2_PLATFORM_WINDOWS
 #include <io.h>
 #include <fcntl.h>
@@ -79,6 +82,170 @@ int_t decode_variablesize_int(ibitstream& stream)
   return value;
 }
 
+/// \brief The maximum number of uncompressed bytes in a block of a compressed bitstream.
+static constexpr std::size_t block_size = std::size_t(1) << 16;
+
+/// \brief The number of bits of the hash of a sequence of four bytes during compression.
+static constexpr unsigned int hash_bits = 14;
+
+/// \brief The minimal length of a match, and the maximal distance between a match and its earlier occurrence.
+static constexpr std::size_t minimum_match = 4;
+static constexpr std::size_t maximum_offset = 65535;
+
+static std::uint32_t read_uint32(const std::uint8_t* input)
+{
+  std::uint32_t value;
+  std::memcpy(&value, input, sizeof(value));
+  return value;
+}
+
+/// \brief Appends a length of which the first 15 have been stored in a token as a sequence of bytes, of which all
+///        but the last are 255.
+static void write_length(std::size_t length, std::vector<std::uint8_t>& output)
+{
+  for (; length >= 255; length -= 255)
+  {
+    output.push_back(255);
+  }
+  output.push_back(static_cast<std::uint8_t>(length));
+}
+
+/// \brief Compresses the input using a simple LZ77 scheme in the style of LZ4.
+/// \details The output is a sequence of tokens. Each token consists of a byte with the number of literals in the
+///          upper four bits and the length of the match minus minimum_match in the lower four bits, each followed by
+///          extra bytes when they are 15. After that come the literals and a match, stored as a 16-bit little
+///          endian offset. The last token has no match, and only contains the remaining literals.
+/// \param table Storage for the hash table, reused between calls to avoid allocations.
+static void lz_compress(const std::uint8_t* input, std::size_t size, std::vector<std::uint8_t>& output, std::vector<std::uint32_t>& table)
+{
+  constexpr std::uint32_t empty = std::numeric_limits<std::uint32_t>::max();
+  table.assign(std::size_t(1) << hash_bits, empty);
+  output.clear();
+
+  auto write_sequence = [&](std::size_t anchor, std::size_t literals, std::size_t offset, std::size_t length)
+  {
+    std::size_t match = length == 0 ? 0 : length - minimum_match;
+    output.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(literals, 15) << 4) | std::min<std::size_t>(match, 15)));
+    if (literals >= 15)
+    {
+      write_length(literals - 15, output);
+    }
+    output.insert(output.end(), input + anchor, input + anchor + literals);
+    if (length != 0)
+    {
+      output.push_back(static_cast<std::uint8_t>(offset & 255));
+      output.push_back(static_cast<std::uint8_t>(offset >> 8));
+      if (match >= 15)
+      {
+        write_length(match - 15, output);
+      }
+    }
+  };
+
+  std::size_t anchor = 0;
+  std::size_t i = 0;
+  while (i + minimum_match <= size)
+  {
+    std::uint32_t value = read_uint32(input + i);
+    std::uint32_t& entry = table[(value * 2654435761U) >> (32 - hash_bits)];
+    std::size_t candidate = entry;
+    entry = static_cast<std::uint32_t>(i);
+
+    if (candidate != empty && i - candidate <= maximum_offset && read_uint32(input + candidate) == value)
+    {
+      std::size_t length = minimum_match;
+      while (i + length < size && input[candidate + length] == input[i + length])
+      {
+        ++length;
+      }
+      write_sequence(anchor, i - anchor, i - candidate, length);
+      i += length;
+      anchor = i;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+  write_sequence(anchor, size - anchor, 0, 0);
+}
+
+/// \brief Decompresses the output of lz_compress, which must yield exactly output_size bytes.
+static void lz_decompress(const std::uint8_t* input, std::size_t input_size, std::uint8_t* output, std::size_t output_size)
+{
+  auto corrupt = []()
+  {
+    throw mcrl2::runtime_error("The compressed input file/stream is corrupt.");
+  };
+
+  std::size_t in = 0;
+  std::size_t out = 0;
+  auto read_length = [&](std::size_t length)
+  {
+    if (length == 15)
+    {
+      std::uint8_t byte;
+      do
+      {
+        if (in >= input_size)
+        {
+          corrupt();
+        }
+        byte = input[in++];
+        length += byte;
+      }
+      while (byte == 255);
+    }
+    return length;
+  };
+
+  while (true)
+  {
+    if (in >= input_size)
+    {
+      corrupt();
+    }
+    std::uint8_t token = input[in++];
+
+    std::size_t literals = read_length(token >> 4);
+    if (literals > input_size - in || literals > output_size - out)
+    {
+      corrupt();
+    }
+    std::memcpy(output + out, input + in, literals);
+    in += literals;
+    out += literals;
+
+    if (in == input_size)
+    {
+      break;
+    }
+
+    if (input_size - in < 2)
+    {
+      corrupt();
+    }
+    std::size_t offset = input[in] | (static_cast<std::size_t>(input[in + 1]) << 8);
+    in += 2;
+    std::size_t length = read_length(token & 15) + minimum_match;
+    if (offset == 0 || offset > out || length > output_size - out)
+    {
+      corrupt();
+    }
+
+    // The match may overlap with the bytes that it produces, so it is copied byte by byte.
+    for (std::size_t j = 0; j < length; ++j, ++out)
+    {
+      output[out] = output[out - offset];
+    }
+  }
+
+  if (out != output_size)
+  {
+    corrupt();
+  }
+}
+
 /// \brief Change the current stream to binary mode (no handle of newline characters),
 static void set_stream_binary([[maybe_unused]] const std::string& name, [[maybe_unused]] FILE* handle)
 {
@@ -119,27 +286,26 @@ void obitstream::write_bits(std::size_t value, unsigned int number_of_bits)
     value &= (static_cast<std::size_t>(1) << number_of_bits) - 1;
   }
 
-  write_buffer |= std::bitset<128>(value) << ((128 - bits_in_buffer) - number_of_bits);
-  bits_in_buffer += number_of_bits;
-
-  // Write 8 bytes if available
-  if (bits_in_buffer >= 64)
+  if (number_of_bits == 0)
   {
-    unsigned long long write_value = (write_buffer >> 64).to_ullong();
-    write_buffer <<= 64;
-    bits_in_buffer -= 64;
-
-    for (int32_t i = 7; i >= 0; --i)
-    {
-      // Write the 8 * i most significant bits and mask out the other values.
-      stream.put(static_cast<char>((write_value >> (8 * i)) & 255));
+    return;
+  }
 
-      if (stream.fail())
-      {
-        throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
-      }
-    }
+  // There is always at least one free bit in the buffer.
+  const unsigned int free_bits = 64 - bits_in_buffer;
+  if (number_of_bits < free_bits)
+  {
+    write_buffer |= static_cast<std::uint64_t>(value) << (free_bits - number_of_bits);
+    bits_in_buffer += number_of_bits;
+    return;
   }
+
+  // Fill the buffer with the most significant bits of value, write it and keep the remaining bits.
+  const unsigned int remaining_bits = number_of_bits - free_bits;
+  write_buffer |= static_cast<std::uint64_t>(value) >> remaining_bits;
+  write_buffer_bytes(8);
+  write_buffer = remaining_bits == 0 ? 0 : static_cast<std::uint64_t>(value) << (64 - remaining_bits);
+  bits_in_buffer = remaining_bits;
 }
 
 void obitstream::write_string(const std::string& string)
@@ -193,27 +359,27 @@ std::size_t ibitstream::read_bits(unsigned int number_of_bits)
   // Read at most the number of bits of a std::size_t.
   assert(number_of_bits <= std::numeric_limits<std::size_t>::digits);
 
-  while (bits_in_buffer < number_of_bits)
+  if (number_of_bits > 56)
   {
-    // Read bytes until the buffer is sufficiently full.
-    int byte = stream.get();
-
-    if (stream.eof())
-    {
-      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
-    }
-    else if (stream.fail())
-    {
-      throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
-    }
+    // The buffer cannot always hold this number of bits after reading whole bytes, so split the value.
+    std::size_t value = read_bits(number_of_bits - 32);
+    return (value << 32) | read_bits(32);
+  }
 
-    // Shift the 8 bits to the first free (120 - bits_in_buffer) position in the buffer.
-    read_buffer |= std::bitset<128>(static_cast<std::size_t>(byte)) << (56 + 64 - bits_in_buffer);
+  while (bits_in_buffer < number_of_bits)
+  {
+    // Shift the 8 bits of the next byte to the first free position in the buffer.
+    read_buffer |= static_cast<std::uint64_t>(get_byte()) << (56 - bits_in_buffer);
     bits_in_buffer += 8;
   }
 
-  // Read nr_bits from the buffer by shifting them to the least significant bits and masking out the remaining bits.
-  std::size_t value = (read_buffer >> (128 - number_of_bits)).to_ullong();
+  if (number_of_bits == 0)
+  {
+    return 0;
+  }
+
+  // Read nr_bits from the buffer by shifting them to the least significant bits.
+  std::size_t value = read_buffer >> (64 - number_of_bits);
 
   // Shift the first bit to the first position in the buffer.
   read_buffer <<= number_of_bits;
@@ -229,11 +395,47 @@ std::size_t ibitstream::read_integer()
 
 // Private functions
 
-void obitstream::flush()
+void obitstream::enable_block_compression()
 {
-  // Writing the buffer full to 64 bits should flush it internally, this also guarantees that the unnecessary bits are zeroed out.
-  write_bits(0, 64 - bits_in_buffer);
+  assert(bits_in_buffer % 8 == 0);
+  write_buffer_bytes(bits_in_buffer / 8);
+  write_buffer = 0;
+  bits_in_buffer = 0;
+
+  m_compress = true;
+  m_block.reserve(block_size);
+}
+
+void ibitstream::enable_block_compression()
+{
+  // Bytes are only read when they are needed, so after reading a multiple of eight bits the buffer is empty.
   assert(bits_in_buffer == 0);
+  m_compress = true;
+  m_block.clear();
+  m_block_position = 0;
+}
+
+// Private functions
+
+void obitstream::flush()
+{
+  // Write the remaining bits, where the last byte is padded with zeroes.
+  write_buffer_bytes((bits_in_buffer + 7) / 8);
+  write_buffer = 0;
+  bits_in_buffer = 0;
+
+  if (m_compress)
+  {
+    if (!m_block.empty())
+    {
+      write_block();
+    }
+
+    // A frame with zero bytes marks the end of the compressed blocks.
+    m_compress = false;
+    const std::uint8_t end_of_blocks = 0;
+    put_bytes(&end_of_blocks, 1);
+  }
 
   stream.flush();
   if (stream.fail())
@@ -244,6 +446,16 @@ void obitstream::flush()
 
 void obitstream::write(const uint8_t* buffer, std::size_t size)
 {
+  if (bits_in_buffer % 8 == 0)
+  {
+    // The buffer is byte aligned, so the pending bytes and the given bytes can be written directly.
+    write_buffer_bytes(bits_in_buffer / 8);
+    write_buffer = 0;
+    bits_in_buffer = 0;
+    put_bytes(buffer, size);
+    return;
+  }
+
   for (std::size_t index = 0; index < size; ++index)
   {
     // Write a single byte for every entry in the buffer that was filled (size).
@@ -251,12 +463,156 @@ void obitstream::write(const uint8_t* buffer, std::size_t size)
   }
 }
 
+void obitstream::write_buffer_bytes(unsigned int number_of_bytes)
+{
+  std::uint8_t bytes[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  for (unsigned int i = 0; i < number_of_bytes; ++i)
+  {
+    bytes[i] = static_cast<std::uint8_t>(write_buffer >> (56 - 8 * i));
+  }
+  put_bytes(static_cast<const std::uint8_t*>(bytes), number_of_bytes);
+}
+
+void obitstream::put_bytes(const std::uint8_t* buffer, std::size_t size)
+{
+  if (!m_compress)
+  {
+    if (static_cast<std::size_t>(stream.rdbuf()->sputn(reinterpret_cast<const char*>(buffer), static_cast<std::streamsize>(size))) != size)
+    {
+      stream.setstate(std::ios::badbit);
+      throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+    }
+    return;
+  }
+
+  while (size > 0)
+  {
+    std::size_t n = std::min(size, block_size - m_block.size());
+    m_block.insert(m_block.end(), buffer, buffer + n);
+    buffer += n;
+    size -= n;
+    if (m_block.size() == block_size)
+    {
+      write_block();
+    }
+  }
+}
+
+void obitstream::write_block()
+{
+  // A frame consists of the number of bytes in the block, followed by the number of stored bytes and the stored bytes.
+  // If both numbers are equal the block is stored uncompressed.
+  lz_compress(m_block.data(), m_block.size(), m_compressed, m_hash_table);
+  const bool compressed = m_compressed.size() < m_block.size();
+  const std::vector<std::uint8_t>& stored = compressed ? m_compressed : m_block;
+
+  std::uint8_t header[2 * integer_encoding_size<std::size_t>()]; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+  std::size_t header_size = encode_variablesize_int(m_block.size(), static_cast<std::uint8_t*>(header));
+  header_size += encode_variablesize_int(stored.size(), static_cast<std::uint8_t*>(header) + header_size);
+
+  m_compress = false;
+  put_bytes(static_cast<const std::uint8_t*>(header), header_size);
+  put_bytes(stored.data(), stored.size());
+  m_compress = true;
+  m_block.clear();
+}
+
 void ibitstream::read(std::size_t size, std::uint8_t* buffer)
 {
-  for (std::size_t index = 0; index < size; ++index)
+  std::size_t index = 0;
+  if (bits_in_buffer % 8 == 0)
+  {
+    // The buffer is byte aligned, so after the bytes in the buffer the remaining bytes can be read directly.
+    for (; index < size && bits_in_buffer > 0; ++index)
+    {
+      buffer[index] = static_cast<std::uint8_t>(read_bits(8));
+    }
+
+    if (!m_compress && index < size)
+    {
+      std::size_t count = static_cast<std::size_t>(stream.rdbuf()->sgetn(reinterpret_cast<char*>(buffer + index), static_cast<std::streamsize>(size - index)));
+      if (count != size - index)
+      {
+        stream.setstate(std::ios::eofbit | std::ios::failbit);
+        throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+      }
+      return;
+    }
+
+    for (; index < size; ++index)
+    {
+      buffer[index] = get_byte();
+    }
+    return;
+  }
+
+  for (; index < size; ++index)
   {
     // Read a single byte for every entry into the buffer that was filled (size).
     std::size_t value = read_bits(8);
     buffer[index] = static_cast<std::uint8_t>(value);
   }
 }
+
+std::uint8_t ibitstream::get_stream_byte()
+{
+  int byte = stream.rdbuf()->sbumpc();
+  if (byte == std::char_traits<char>::eof())
+  {
+    stream.setstate(std::ios::eofbit | std::ios::failbit);
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+  return static_cast<std::uint8_t>(byte);
+}
+
+void ibitstream::read_block()
+{
+  auto read_size = [this]()
+  {
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < integer_encoding_size<std::size_t>(); ++i)
+    {
+      std::size_t byte = get_stream_byte();
+      value |= (byte & 127) << (7 * i);
+      if (!(byte & 128))
+      {
+        return value;
+      }
+    }
+    throw mcrl2::runtime_error("The compressed input file/stream is corrupt.");
+  };
+
+  std::size_t size = read_size();
+  if (size == 0)
+  {
+    // The frame that marks the end of the compressed blocks.
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+  std::size_t stored_size = read_size();
+  if (size > block_size || stored_size > size)
+  {
+    throw mcrl2::runtime_error("The compressed input file/stream is corrupt.");
+  }
+
+  auto read_stream = [this](std::uint8_t* buffer, std::size_t size)
+  {
+    if (static_cast<std::size_t>(stream.rdbuf()->sgetn(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size))) != size)
+    {
+      stream.setstate(std::ios::eofbit | std::ios::failbit);
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+    }
+  };
+
+  m_block.resize(size);
+  if (stored_size == size)
+  {
+    read_stream(m_block.data(), size);
+  }
+  else
+  {
+    m_compressed.resize(stored_size);
+    read_stream(m_compressed.data(), stored_size);
+    lz_decompress(m_compressed.data(), stored_size, m_block.data(), size);
+  }
+  m_block_position = 0;
+}
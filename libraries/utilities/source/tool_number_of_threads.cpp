@@ -0,0 +1,30 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/detail/tool_number_of_threads.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace mcrl2::utilities::detail
+{
+
+static std::atomic<std::size_t> g_tool_number_of_threads{1};
+
+void set_tool_number_of_threads(std::size_t number_of_threads)
+{
+  g_tool_number_of_threads = std::max<std::size_t>(1, number_of_threads);
+}
+
+std::size_t tool_number_of_threads()
+{
+  return g_tool_number_of_threads;
+}
+
+} // namespace mcrl2::utilities::detail
@@ -8,6 +8,7 @@
 //
 
 #include "mcrl2/utilities/bitstream.h"
+#include "mcrl2/utilities/exception.h"
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
@@ -47,3 +48,37 @@ BOOST_AUTO_TEST_CASE(fixed_sequence_test)
   
   BOOST_CHECK_EQUAL(output.read_integer(), std::size_t(1) << 63);
 }
+
+BOOST_AUTO_TEST_CASE(compressed_sequence_test)
+{
+  std::stringstream stream;
+
+  // Enough data to fill multiple blocks, in which the values are repetitive.
+  constexpr std::size_t N = 100000;
+  {
+    obitstream input(stream);
+    input.write_bits(5, 8);
+    input.enable_block_compression();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      input.write_bits(i % 5, 3);
+      input.write_integer(i % 1000);
+      input.write_string("label");
+      input.write_bits(i, 64);
+    }
+  }
+
+  ibitstream output(stream);
+  BOOST_CHECK_EQUAL(output.read_bits(8), 5);
+  output.enable_block_compression();
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(output.read_bits(3), i % 5);
+    BOOST_REQUIRE_EQUAL(output.read_integer(), i % 1000);
+    BOOST_REQUIRE_EQUAL(strcmp(output.read_string(), "label"), 0);
+    BOOST_REQUIRE_EQUAL(output.read_bits(64), i);
+  }
+
+  // Reading beyond the written data fails.
+  BOOST_CHECK_THROW(output.read_bits(64), mcrl2::runtime_error);
+}
@@ -0,0 +1,105 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/concurrent_indexed_set.h"
+
+#include <atomic>
+#include <thread>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+using namespace mcrl2::utilities;
+
+BOOST_AUTO_TEST_CASE(basic_test_concurrent_indexed_set)
+{
+  concurrent_indexed_set<std::string> t(1, 100);
+
+  BOOST_CHECK(t.insert("a") == std::make_pair(std::size_t(0), true));
+  BOOST_CHECK(t.insert("b") == std::make_pair(std::size_t(1), true));
+  BOOST_CHECK(t.insert("a") == std::make_pair(std::size_t(0), false));
+  BOOST_CHECK_EQUAL(t.size(), 2u);
+
+  BOOST_CHECK_EQUAL(t.index("b"), 1u);
+  BOOST_CHECK_EQUAL(t.index("c"), concurrent_indexed_set<std::string>::npos);
+  BOOST_CHECK(t.find("c") == t.end());
+  BOOST_CHECK_EQUAL(*t.find("a"), "a");
+  BOOST_CHECK_EQUAL(t.at(1), "b");
+  BOOST_CHECK_THROW(t.at(2), std::out_of_range);
+
+  concurrent_indexed_set<std::string> t2 = t;
+  BOOST_CHECK_EQUAL(t2.index("b"), 1u);
+
+  t.clear();
+  BOOST_CHECK_EQUAL(t.size(), 0u);
+  BOOST_CHECK_EQUAL(t2.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_indexed_set_grow)
+{
+  // Insert enough elements to resize the hashtable and allocate several segments of keys.
+  concurrent_indexed_set<std::size_t> set;
+  const std::size_t n = 100000;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.insert(3 * i).first, i);
+  }
+
+  BOOST_CHECK_EQUAL(set.size(), n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    BOOST_CHECK_EQUAL(set.index(3 * i), i);
+    BOOST_CHECK_EQUAL(set[i], 3 * i);
+  }
+  BOOST_CHECK_EQUAL(set.index(1), concurrent_indexed_set<std::size_t>::npos);
+}
+
+BOOST_AUTO_TEST_CASE(test_concurrent_indexed_set_parallel)
+{
+  // Every thread inserts the same overlapping range of elements, while the hashtable grows.
+  const std::size_t number_of_threads = 8;
+  const std::size_t n = 50000;
+  concurrent_indexed_set<std::size_t> set(number_of_threads);
+
+  // The checks of Boost.Test cannot be used by multiple threads, so errors are counted instead.
+  std::atomic<std::size_t> errors = 0;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < number_of_threads; ++t)
+  {
+    threads.emplace_back([&set, &errors, t]()
+    {
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        std::size_t key = (i + t * n / number_of_threads) % n;
+        std::pair<std::size_t, bool> p = set.insert(key, t);
+        if (p.first >= n || set.index(key, t) != p.first)
+        {
+          ++errors;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(errors.load(), 0u);
+
+  // Every element got exactly one index.
+  BOOST_CHECK_EQUAL(set.size(), n);
+  std::vector<bool> found(n, false);
+  for (std::size_t key: set)
+  {
+    BOOST_CHECK(!found[key]);
+    found[key] = true;
+    BOOST_CHECK_EQUAL(set[set.index(key)], key);
+  }
+}
@@ -38,3 +38,80 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_lru_cache)
+{
+  // With 16 buckets the cache contains at most 15 elements.
+  lru_cache<int, int> cache(16);
+  for (int i = 0; i < 15; ++i)
+  {
+    cache.emplace(i, i);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 15u);
+  BOOST_CHECK_EQUAL(cache.evictions(), 0u);
+
+  // Using 0 makes 1 the least recently used element, which is removed first.
+  BOOST_CHECK(cache.find(0) != cache.end());
+  cache.emplace(15, 15);
+  BOOST_CHECK_EQUAL(cache.evictions(), 1u);
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(1) == cache.end());
+  BOOST_CHECK_EQUAL(cache.hits(), 2u);
+  BOOST_CHECK_EQUAL(cache.misses(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_clock_cache)
+{
+  clock_cache<int, int> cache(16);
+  for (int i = 0; i < 15; ++i)
+  {
+    cache.emplace(i, i);
+  }
+
+  // Element 0 gets a second chance, so element 1 is removed instead.
+  BOOST_CHECK(cache.find(0) != cache.end());
+  cache.emplace(15, 15);
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(1) == cache.end());
+  BOOST_CHECK_EQUAL(cache.size(), 15u);
+}
+
+BOOST_AUTO_TEST_CASE(test_frequency_cache)
+{
+  frequency_cache<int, int> cache(16);
+  for (int i = 0; i < 15; ++i)
+  {
+    cache.emplace(i, i);
+  }
+
+  // Element 0 is used frequently, and therefore survives many insertions.
+  for (int i = 15; i < 30; ++i)
+  {
+    BOOST_CHECK(cache.find(0) != cache.end());
+    cache.emplace(i, i);
+  }
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK_EQUAL(cache.size(), 15u);
+  BOOST_CHECK_EQUAL(cache.evictions(), 15u);
+}
+
+BOOST_AUTO_TEST_CASE(test_copied_lru_cache)
+{
+  lru_cache<int, int> cache(16);
+  for (int i = 0; i < 15; ++i)
+  {
+    cache.emplace(i, i);
+  }
+
+  // The policy of the copy refers to the elements of the copy, which are all replaced in turn.
+  lru_cache<int, int> copy(cache);
+  cache.clear();
+  for (int i = 15; i < 45; ++i)
+  {
+    copy.emplace(i, i);
+  }
+  BOOST_CHECK_EQUAL(copy.size(), 15u);
+  BOOST_CHECK_EQUAL(copy.evictions(), 30u);
+  BOOST_CHECK(copy.find(44) != copy.end());
+  BOOST_CHECK(copy.find(0) == copy.end());
+}
@@ -0,0 +1,58 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mcrl2/utilities/parallel_breadth_first_search.h"
+
+#include <atomic>
+#include <memory>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+using namespace mcrl2::utilities;
+
+// Computes the distances from 0 in the graph with edges i -> 2i+1, i -> 2i+2 and i -> i+1 below n.
+static std::vector<std::size_t> distances(std::size_t n, std::size_t number_of_threads)
+{
+  std::unique_ptr<std::atomic<bool>[]> visited(new std::atomic<bool>[n]);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    visited[i] = false;
+  }
+  std::vector<std::size_t> result(n, 0);
+
+  std::vector<std::size_t> todo = { 0 };
+  visited[0] = true;
+  detail::parallel_for_pool pool(number_of_threads);
+  parallel_breadth_first_search(todo, pool, [&](std::size_t u, std::vector<std::size_t>& next)
+  {
+    for (std::size_t v: { 2 * u + 1, 2 * u + 2, u + 1 })
+    {
+      if (v < n && !visited[v].exchange(true))
+      {
+        result[v] = result[u] + 1;
+        next.push_back(v);
+      }
+    }
+  }, 16);
+
+  BOOST_CHECK_EQUAL(todo.size(), n);
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_breadth_first_search)
+{
+  const std::size_t n = 100000;
+  std::vector<std::size_t> expected = distances(n, 1);
+  BOOST_CHECK_EQUAL(expected[n - 1], 16u);
+  for (std::size_t number_of_threads: { 2, 3, 8 })
+  {
+    BOOST_CHECK(distances(n, number_of_threads) == expected);
+  }
+}
@@ -0,0 +1,77 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/utilities/detail/parallel_for.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using mcrl2::utilities::detail::parallel_for_pool;
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_pool_covers_range)
+{
+  parallel_for_pool pool(4);
+  BOOST_CHECK_EQUAL(pool.number_of_threads(), 4u);
+
+  // Every loop must visit each index exactly once, also when the pool is reused.
+  for (std::size_t n: {0, 1, 3, 4, 1000})
+  {
+    std::vector<std::size_t> visited(n, 0);
+    pool.parallel_for(n, [&](std::size_t begin, std::size_t end)
+      {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+          ++visited[i];
+        }
+      });
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      BOOST_CHECK_EQUAL(visited[i], 1u);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_pool_same_thread_per_range)
+{
+  parallel_for_pool pool(3);
+
+  // The i-th range is always executed by the same thread, and the first one by the caller.
+  std::vector<std::thread::id> first(3);
+  pool.parallel_for(3, [&](std::size_t begin, std::size_t) { first[begin] = std::this_thread::get_id(); });
+  BOOST_CHECK(first[0] == std::this_thread::get_id());
+
+  for (std::size_t loop = 0; loop < 10; ++loop)
+  {
+    std::vector<std::thread::id> ids(3);
+    pool.parallel_for(3, [&](std::size_t begin, std::size_t) { ids[begin] = std::this_thread::get_id(); });
+    BOOST_CHECK(ids == first);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_for_pool_exception)
+{
+  parallel_for_pool pool(2);
+  BOOST_CHECK_THROW(pool.parallel_for(2, [&](std::size_t begin, std::size_t)
+    {
+      if (begin == 1)
+      {
+        throw std::runtime_error("failure in the second range");
+      }
+    }), std::runtime_error);
+
+  // The pool can still be used after an exception.
+  std::size_t count = 0;
+  pool.parallel_for(1, [&](std::size_t begin, std::size_t end) { count += end - begin; });
+  BOOST_CHECK_EQUAL(count, 1u);
+}
@@ -64,6 +64,13 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "store at most (approximately) NUM entries in each enumeration cache of --cached. By default the caches are unbounded. ");
+      desc.add_option("cache-policy", utilities::make_enum_argument<lps::cache_replacement_policy>("NAME")
+                   .add_value(lps::cache_replacement_policy::lru, true)
+                   .add_value(lps::cache_replacement_policy::clock)
+                   .add_value(lps::cache_replacement_policy::frequency)
+        , "remove entries from a full enumeration cache using policy NAME:");
       desc.add_option("project", "use read/write projections ");
 #ifdef MCRL2_USE_CONTROL_FLOW
       desc.add_option("control-flow", "use control flow based summand pruning");
@@ -249,6 +256,11 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.dfs_recursive                         = parser.has_option("dfs-recursive");
       options.discard_lts_state_labels              = parser.has_option("no-info");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
+      options.cache_policy = parser.option_argument_as<lps::cache_replacement_policy>("cache-policy");
+      if (parser.has_option("cache-size"))
+      {
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+      }
       options.number_of_threads = number_of_threads();
       bool to_stdout = output_filename().empty() || output_filename() == "-";
       // highway search
@@ -376,6 +388,11 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
         parser.error("Option --project cannot be combined with --cached or --global-cache.");
       }
 
+      if ((parser.has_option("cache-size") || parser.has_option("cache-policy")) && !parser.has_option("cached"))
+      {
+        parser.error("Options --cache-size and --cache-policy can only be used in combination with --cached.");
+      }
+
 #ifdef MCRL2_USE_CONTROL_FLOW
       stategraph_options.rewrite_strategy = rewrite_strategy();
       stategraph_options.simplify = !parser.has_option("no-simplify");
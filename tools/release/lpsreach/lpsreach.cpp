@@ -134,6 +134,7 @@ protected:
     options.variable_order = parser.option_argument("reorder");
     options.rewrite_strategy = rewrite_strategy();
     options.dot_file = parser.option_argument("dot");
+    options.max_workers = number_of_threads();
     if (parser.has_option("lace-dqsize"))
     {
       lace_dqsize = parser.option_argument_as<int>("lace-dqsize");
@@ -9,6 +9,7 @@
 /// \file ltscompare.cpp
 
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_io.h"
@@ -36,7 +37,7 @@ struct t_tool_options
   bool enable_preprocessing      = true;
 };
 
-using ltscompare_base = input_tool;
+using ltscompare_base = parallel_tool<input_tool>;
 class ltscompare_tool : public ltscompare_base
 {
   private:
@@ -114,7 +115,7 @@ class ltscompare_tool : public ltscompare_base
                      description(tool_options.preorder) << "..."
                      " using the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
 
-        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing);
+        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing, number_of_threads());
 
         if (!tool_options.structured_output)
         {
@@ -292,14 +293,6 @@ class ltscompare_tool : public ltscompare_base
         {
           parser.error("counter examples cannot be used with ready simulation pre-order");
         }
-        if (tool_options.preorder == lts_preorder::lts_pre_trace)
-        {
-          parser.error("counter examples cannot be used with the plain trace pre-order (use trace-ac instead)");
-        }
-        if (tool_options.preorder == lts_preorder::lts_pre_weak_trace)
-        {
-          parser.error("counter examples cannot be used with the plain weak trace pre-order (use weak-trace-ac instead");
-        }
       }
 
       if (parser.has_option("no-preprocessing"))
@@ -340,7 +333,9 @@ class ltscompare_tool : public ltscompare_base
           mCRL2log(mcrl2::log::warning) << "Generated counter example might not be the shortest with the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
         }
 
-        if (tool_options.preorder != lts_preorder::lts_pre_trace_anti_chain
+        if (tool_options.preorder != lts_preorder::lts_pre_trace
+            && tool_options.preorder != lts_preorder::lts_pre_weak_trace
+            && tool_options.preorder != lts_preorder::lts_pre_trace_anti_chain
             && tool_options.preorder != lts_preorder::lts_pre_weak_trace_anti_chain
             && tool_options.preorder != lts_preorder::lts_pre_failures_refinement
             && tool_options.preorder != lts_preorder::lts_pre_weak_failures_refinement
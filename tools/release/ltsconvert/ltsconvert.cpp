@@ -13,6 +13,7 @@ constexpr auto NAME = "ltsconvert";
 constexpr auto AUTHOR = "Muck van Weerdenburg, Jan Friso Groote";
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
 
@@ -35,8 +36,10 @@ public:
   std::vector<std::string> tau_actions; // Actions with these labels must be considered equal to tau.
   bool remove_state_information = false;
   bool determinise = false;
+  bool minimise_determinised = false; // Merge bisimilar states during determinisation.
   bool check_reach = true;
   bool add_state_as_state_label = false;
+  bool indexed = false; // Write an .lts output file in the indexed format.
 
   inline std::string source_string() const
   {
@@ -125,25 +128,27 @@ public:
 
 };
 
-class ltsconvert_tool : public input_output_tool
+class ltsconvert_tool : public parallel_tool<input_output_tool>
 {
+  using super = parallel_tool<input_output_tool>;
+
   private:
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
-                      "convert and optionally minimise an LTS",
-                      "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
-                      "requested format after applying the selected minimisation method (default is\n"
-                      "none). If OUTFILE is not supplied, stdout is used. If INFILE is not supplied,\n"
-                      "stdin is used.\n"
-                      "\n"
-                      "The output format is determined by the extension of OUTFILE, whereas the input\n"
-                      "format is determined by the content of INFILE. Options --in and --out can be\n"
-                      "used to force the input and output formats. The supported formats are:\n"
-                      + mcrl2::lts::detail::supported_lts_formats_text(lts_lts)
-                     )
+      super(NAME,AUTHOR,
+          "convert and optionally minimise an LTS",
+          "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
+          "requested format after applying the selected minimisation method (default is\n"
+          "none). If OUTFILE is not supplied, stdout is used. If INFILE is not supplied,\n"
+          "stdin is used.\n"
+          "\n"
+          "The output format is determined by the extension of OUTFILE, whereas the input\n"
+          "format is determined by the content of INFILE. Options --in and --out can be\n"
+          "used to force the input and output formats. The supported formats are:\n"
+          + mcrl2::lts::detail::supported_lts_formats_text(lts_lts)
+         )
     {
     }
 
@@ -156,7 +161,15 @@ class ltsconvert_tool : public input_output_tool
       using namespace mcrl2::lts::detail;
 
       LTS_TYPE l;
-      l.load(tool_options.infilename);
+      if constexpr (std::is_same_v<LTS_TYPE, probabilistic_lts_lts_t> || std::is_same_v<LTS_TYPE, lts_lts_t>
+                    || std::is_same_v<LTS_TYPE, lts_aut_t>)
+      {
+        l.load(tool_options.infilename, number_of_threads());
+      }
+      else
+      {
+        l.load(tool_options.infilename);
+      }
       l.apply_hidden_actions(tool_options.tau_actions);
 
       if (tool_options.check_reach)
@@ -201,7 +214,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "Reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
           mCRL2log(verbose) << "Before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
           timer().start("reduction");
-          reduce(l,tool_options.equivalence);
+          reduce(l,tool_options.equivalence,number_of_threads());
           timer().finish("reduction");
           mCRL2log(verbose) << "After reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
         }
@@ -218,7 +231,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "determinising LTS..." << std::endl;
           mCRL2log(verbose) << "before determinisation: " << l.num_states() << " states and " << l.num_transitions() << " transitions" << std::endl;
           timer().start("determinisation");
-          determinise(l);
+          determinise(l, number_of_threads(), tool_options.minimise_determinised);
           timer().finish("determinisation");
           mCRL2log(verbose) << "after determinisation: " << l.num_states() << " states and " << l.num_transitions() << " transitions" << std::endl;
         }
@@ -238,14 +251,28 @@ class ltsconvert_tool : public input_output_tool
         {
           lts_lts_t l_out;
           lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
-          l_out.save(tool_options.outfilename);
+          if (tool_options.indexed)
+          {
+            l_out.save_indexed(tool_options.outfilename, number_of_threads());
+          }
+          else
+          {
+            l_out.save(tool_options.outfilename);
+          }
           return true;
         }
         case lts_lts_probabilistic:
         {
           probabilistic_lts_lts_t l_out;
           lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
-          l_out.save(tool_options.outfilename);
+          if (tool_options.indexed)
+          {
+            l_out.save_indexed(tool_options.outfilename, number_of_threads());
+          }
+          else
+          {
+            l_out.save(tool_options.outfilename);
+          }
           return true;
         }
         case lts_none:
@@ -331,13 +358,17 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc) override
     {
-      input_output_tool::add_options(desc);
+      super::add_options(desc);
 
       desc.add_option("no-reach",
                       "do not perform a reachability check on the input LTS.");
       desc.add_option("no-state",
                       "remove the state information. This can be useful when state labels are huge.", 'n');
       desc.add_option("determinise", "determinise LTS", 'D');
+      desc.add_option("minimise-determinised",
+                      "merge bisimilar states while determinising with -D/--determinise. This keeps the intermediate "
+                      "LTS small, but the resulting LTS is only trace equivalent to the determinised LTS, and is not "
+                      "necessarily minimal.");
       desc.add_option("lps", make_file_argument("FILE"),
                       "use FILE as the LPS from which the input LTS was generated; this might "
                       "be needed to store the correct parameter names of states when saving "
@@ -385,6 +416,10 @@ class ltsconvert_tool : public input_output_tool
                       "consider actions with a name in the comma separated list ACTNAMES to "
                       "be internal (tau) actions in addition to those defined as such by "
                       "the input.");
+      desc.add_option("indexed",
+                      "write an .lts output file in the indexed format, of which the transitions and state labels "
+                      "are encoded and decoded in parallel using the number of threads given by --threads. "
+                      "Tools that only support the streaming .lts format cannot read such a file.");
       desc.add_hidden_option("add-state-as-state-label",
                              "add the state number as the label of the states in the input file, "
                              "and remove other state labels if they exist");
@@ -404,7 +439,7 @@ class ltsconvert_tool : public input_output_tool
 
     void parse_options(const command_line_parser& parser) override
     {
-      input_output_tool::parse_options(parser);
+      super::parse_options(parser);
 
       if (parser.options.count("lps"))
       {
@@ -463,14 +498,21 @@ class ltsconvert_tool : public input_output_tool
       }
 
       tool_options.determinise                       = 0 < parser.options.count("determinise");
+      tool_options.minimise_determinised             = 0 < parser.options.count("minimise-determinised");
       tool_options.check_reach                       = parser.options.count("no-reach") == 0;
       tool_options.remove_state_information          = parser.options.count("no-state") != 0;
+      tool_options.indexed                           = parser.options.count("indexed") != 0;
 
       if (tool_options.determinise && (tool_options.equivalence != lts_eq_none))
       {
         parser.error("cannot use option -D/--determinise together with LTS reduction options\n");
       }
 
+      if (tool_options.minimise_determinised && !tool_options.determinise)
+      {
+        parser.error("option --minimise-determinised can only be used together with option -D/--determinise\n");
+      }
+
       if (2 < parser.arguments.size())
       {
         parser.error("too many file arguments");
@@ -510,6 +552,11 @@ class ltsconvert_tool : public input_output_tool
           }
         }
       }
+
+      if (tool_options.indexed && tool_options.outtype != lts_lts && tool_options.outtype != lts_lts_probabilistic)
+      {
+        parser.error("option --indexed can only be used when the output is in the .lts format\n");
+      }
     }
 
 };
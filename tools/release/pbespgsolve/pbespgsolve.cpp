@@ -9,6 +9,7 @@
 /// \file pbespgsolve.cpp
 
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/pbes/pbes_input_tool.h"
 #include "mcrl2/pbes/pg_parse.h"
@@ -25,6 +26,7 @@ using namespace mcrl2::log;
 using pbes_system::tools::pbes_input_tool;
 using data::tools::rewriter_tool;
 using utilities::tools::input_tool;
+using utilities::tools::parallel_tool;
 
 // class pg_solver_tool: public pbes_rewriter_tool<rewriter_tool<input_tool> >
 // TODO: extend the tool with rewriter options
@@ -32,10 +34,10 @@ using utilities::tools::input_tool;
 // scc decomposition can be compiled in using directive
 // PBESPGSOLVE_ENABLE_SCC_DECOMPOSITION
 
-class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
+class pg_solver_tool : public parallel_tool<rewriter_tool<pbes_input_tool<input_tool>>>
 {
   protected:
-    using super = rewriter_tool<pbes_input_tool<input_tool>>;
+    using super = parallel_tool<rewriter_tool<pbes_input_tool<input_tool>>>;
 
     pbespgsolve_options m_options;
 
@@ -69,6 +71,7 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       m_options.use_decycle_solver = (parser.options.count("cycle") > 0);
       m_options.verify_solution = (parser.options.count("verify") > 0);
       m_options.only_generate = (parser.options.count("onlygenerate") > 0);
+      m_options.number_of_threads = number_of_threads();
       if (parser.options.count("equation_limit") > 0)
       {
         int limit = parser.option_argument_as<int>("equation_limit");
@@ -104,6 +107,7 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       mCRL2log(verbose) << "  scc decomposition: " << std::boolalpha << m_options.use_scc_decomposition << std::endl;
       mCRL2log(verbose) << "  verify solution:   " << std::boolalpha << m_options.verify_solution << std::endl;
       mCRL2log(verbose) << "  only generate:   " << std::boolalpha << m_options.only_generate << std::endl;
+      mCRL2log(verbose) << "  threads:           " << m_options.number_of_threads << std::endl;
 
       bool value;
       if(pbes_input_format() == pbes_system::pbes_format_pgsolver())